@@ -86,6 +86,19 @@ void ExtraAction::step(float dt)
 //
 // IntervalAction
 //
+ActionInterval::ActionInterval()
+: _elapsed(0)
+, _firstTick(true)
+, _batchedTween(TweenBatch::INVALID_TWEEN)
+{
+}
+
+ActionInterval::~ActionInterval()
+{
+    // the target may be being deleted
+    removeBatchedTween(false);
+}
+
 bool ActionInterval::initWithDuration(float d)
 {
     _duration = d;
@@ -163,6 +176,46 @@ void ActionInterval::startWithTarget(Node *target)
     FiniteTimeAction::startWithTarget(target);
     _elapsed = 0.0f;
     _firstTick = true;
+    // the start values depend on the target
+    removeBatchedTween(false);
+}
+
+void ActionInterval::stop()
+{
+    // the following actions of a Sequence start from the final value
+    removeBatchedTween(true);
+    FiniteTimeAction::stop();
+}
+
+bool ActionInterval::updateBatchedTween(TweenBatch::Property property, const Vec3& from, const Vec3& delta, float time)
+{
+    auto tweenBatch = TweenBatch::getInstance();
+    if (!tweenBatch->isEnabled() || _target == nullptr)
+    {
+        removeBatchedTween(false);
+        return false;
+    }
+
+    if (_batchedTween == TweenBatch::INVALID_TWEEN)
+    {
+        _batchedTween = tweenBatch->addDrivenTween(this, _target, property, from, delta);
+    }
+    tweenBatch->setProgress(_batchedTween, time);
+    return true;
+}
+
+void ActionInterval::removeBatchedTween(bool writeValue)
+{
+    if (_batchedTween != TweenBatch::INVALID_TWEEN)
+    {
+        // the batch may have been destroyed by Director::reset(), with the tween
+        auto tweenBatch = TweenBatch::getInstanceOrNull();
+        if (tweenBatch)
+        {
+            tweenBatch->removeDrivenTween(_batchedTween, this, writeValue);
+        }
+        _batchedTween = TweenBatch::INVALID_TWEEN;
+    }
 }
 
 //
@@ -975,6 +1028,11 @@ void RotateTo::startWithTarget(Node *target)
 
 void RotateTo::update(float time)
 {
+    if (updateBatchedTween(TweenBatch::Property::ROTATION, Vec3(_startAngle.x, _startAngle.y, 0), Vec3(_diffAngle.x, _diffAngle.y, 0), time))
+    {
+        return;
+    }
+
     if (_target)
     {
         _target->setRotationSkewX(_startAngle.x + _diffAngle.x * time);
@@ -1182,6 +1240,16 @@ void MoveTo::startWithTarget(Node *target)
     _positionDelta = _endPosition - target->getPosition();
 }
 
+void MoveTo::update(float time)
+{
+    if (updateBatchedTween(TweenBatch::Property::POSITION, Vec3(_startPosition.x, _startPosition.y, 0), Vec3(_positionDelta.x, _positionDelta.y, 0), time))
+    {
+        return;
+    }
+
+    MoveBy::update(time);
+}
+
 MoveTo* MoveTo::reverse() const
 {
     CCASSERT(false, "reverse() not supported in MoveTo");
@@ -1742,6 +1810,11 @@ void ScaleTo::startWithTarget(Node *target)
 
 void ScaleTo::update(float time)
 {
+    if (updateBatchedTween(TweenBatch::Property::SCALE, Vec3(_startScaleX, _startScaleY, _startScaleZ), Vec3(_deltaX, _deltaY, _deltaZ), time))
+    {
+        return;
+    }
+
     if (_target)
     {
         _target->setScaleX(_startScaleX + _deltaX * time);
@@ -2032,6 +2105,11 @@ void FadeTo::startWithTarget(Node *target)
 
 void FadeTo::update(float time)
 {
+    if (updateBatchedTween(TweenBatch::Property::OPACITY, Vec3(_fromOpacity, 0, 0), Vec3((float)(_toOpacity - _fromOpacity), 0, 0), time))
+    {
+        return;
+    }
+
     if (_target)
     {
         _target->setOpacity((GLubyte)(_fromOpacity + (_toOpacity - _fromOpacity) * time));
@@ -32,6 +32,7 @@ THE SOFTWARE.
 
 #include "2d/CCAction.h"
 #include "2d/CCAnimation.h"
+#include "2d/CCTweenBatch.h"
 #include "base/CCProtocols.h"
 #include "base/CCVector.h"
 
@@ -96,6 +97,7 @@ public:
      */
     virtual void step(float dt) override;
     virtual void startWithTarget(Node *target) override;
+    virtual void stop() override;
     virtual ActionInterval* reverse() const override
     {
         CC_ASSERT(0);
@@ -109,15 +111,29 @@ public:
     }
 
 CC_CONSTRUCTOR_ACCESS:
+    ActionInterval();
+    virtual ~ActionInterval();
+
     /** initializes the action */
     bool initWithDuration(float d);
 
 protected:
     float _elapsed;
     bool   _firstTick;
+    // the driven tween of TweenBatch updating the target
+    int _batchedTween;
 
 protected:
     bool sendUpdateEventToScript(float dt, Action *actionObject);
+
+    /**
+     * Sets the target property to `from + delta * time` through TweenBatch, when it is enabled.
+     * `from` and `delta` are only read by the first update after startWithTarget().
+     * @return false if the batch is disabled, and the action has to set the property itself.
+     */
+    bool updateBatchedTween(TweenBatch::Property property, const Vec3& from, const Vec3& delta, float time);
+    /** Removes the tween from the batch, writing its pending value to the target if `writeValue` is true. */
+    void removeBatchedTween(bool writeValue);
 };
 
 /** @class Sequence
@@ -656,6 +672,10 @@ public:
     virtual MoveTo* clone() const override;
     virtual MoveTo* reverse() const  override;
     virtual void startWithTarget(Node *target) override;
+    /**
+     * @param time In seconds.
+     */
+    virtual void update(float time) override;
 
 CC_CONSTRUCTOR_ACCESS:
     MoveTo() {}
@@ -29,30 +29,17 @@ THE SOFTWARE.
 #include "2d/CCActionManager.h"
 #include "2d/CCNode.h"
 #include "2d/CCAction.h"
+#include "2d/CCTweenBatch.h"
 #include "base/CCScheduler.h"
 #include "base/ccMacros.h"
-#include "base/ccCArray.h"
-#include "base/uthash.h"
+
+#include <algorithm>
 
 NS_CC_BEGIN
-//
-// singleton stuff
-//
-typedef struct _hashElement
-{
-    struct _ccArray     *actions;
-    Node                *target;
-    int                 actionIndex;
-    Action              *currentAction;
-    bool                currentActionSalvaged;
-    bool                paused;
-    UT_hash_handle      hh;
-} tHashElement;
 
 ActionManager::ActionManager()
-: _targets(nullptr),
-  _currentTarget(nullptr),
-  _currentTargetSalvaged(false)
+: _isUpdating(false)
+, _removedCount(0)
 {
 
 }
@@ -66,72 +53,114 @@ ActionManager::~ActionManager()
 
 // private
 
-void ActionManager::deleteHashElement(tHashElement *element)
+ActionManager::Target* ActionManager::findTarget(const Node* node) const
 {
-    ccArrayFree(element->actions);
-    HASH_DEL(_targets, element);
-    element->target->release();
-    free(element);
+    auto iter = _targets.find(node);
+    return iter != _targets.end() ? const_cast<Target*>(&iter->second) : nullptr;
 }
 
-void ActionManager::actionAllocWithHashElement(tHashElement *element)
+void ActionManager::releaseAction(Action* action)
 {
-    // 4 actions per Node by default
-    if (element->actions == nullptr)
-    {
-        element->actions = ccArrayNew(4);
-    }else
-    if (element->actions->num == element->actions->max)
+#if CC_ENABLE_GC_FOR_NATIVE_OBJECTS
+    auto sEngine = ScriptEngineManager::getInstance()->getScriptEngine();
+    if (sEngine)
     {
-        ccArrayDoubleCapacity(element->actions);
+        sEngine->releaseScriptObject(this, action);
     }
-
+#endif // CC_ENABLE_GC_FOR_NATIVE_OBJECTS
+    action->release();
 }
 
-void ActionManager::removeActionAtIndex(ssize_t index, tHashElement *element)
+void ActionManager::compactActions()
 {
-    Action *action = (Action*)element->actions->arr[index];
+    // the actions keep their order, the targets of the holes may already be deleted
+    std::vector<Action*> releasedActions;
+    size_t kept = 0;
+    for (size_t i = 0; i < _actions.size(); ++i)
+    {
+        const RunningAction& running = _actions[i];
+        if (running.removed)
+        {
+            if (running.action)
+            {
+                releasedActions.push_back(running.action);
+            }
+        }
+        else
+        {
+            _actions[kept++] = running;
+        }
+    }
+    _actions.resize(kept);
+    _removedCount = 0;
 
-    if (action == element->currentAction && (! element->currentActionSalvaged))
+    for (auto& iter : _targets)
     {
-        element->currentAction->retain();
-        element->currentActionSalvaged = true;
+        iter.second.actionIndices.clear();
     }
-    
-#if CC_ENABLE_GC_FOR_NATIVE_OBJECTS
-    auto sEngine = ScriptEngineManager::getInstance()->getScriptEngine();
-    if (sEngine)
+    for (size_t i = 0; i < _actions.size(); ++i)
     {
-        sEngine->releaseScriptObject(this, action);
+        _actions[i].target->actionIndices.push_back(i);
     }
-#endif // CC_ENABLE_GC_FOR_NATIVE_OBJECTS
-    ccArrayRemoveObjectAtIndex(element->actions, index, true);
 
-    // update actionIndex in case we are in tick. looping over the actions
-    if (element->actionIndex >= index)
+    // a node deleted by release() may remove its actions again, the table has to be consistent
+    for (auto action : releasedActions)
     {
-        element->actionIndex--;
+        releaseAction(action);
     }
+}
+
+void ActionManager::removeActionAt(Target* target, size_t position)
+{
+    size_t index = target->actionIndices[position];
+    target->actionIndices.erase(target->actionIndices.begin() + position);
 
-    if (element->actions->num == 0)
+    // a hole, so that the other actions keep their place in the table
+    _actions[index].removed = true;
+    ++_removedCount;
+
+    if (! _isUpdating)
     {
-        if (_currentTarget == element)
+        Action* action = _actions[index].action;
+        _actions[index].action = nullptr;
+        if (_removedCount > _actions.size() / 2)
         {
-            _currentTargetSalvaged = true;
+            compactActions();
         }
-        else
+        releaseAction(action);
+    }
+    // otherwise the action may be the one being stepped, it is released once update() is done
+}
+
+void ActionManager::removeTargetIfEmpty(Target* target)
+{
+    if (!target->actionIndices.empty())
+    {
+        return;
+    }
+
+    if (_isUpdating)
+    {
+        // actions may still point to it, it is removed once update() is done
+        if (!target->pendingRemoval)
         {
-            deleteHashElement(element);
+            target->pendingRemoval = true;
+            _targetsToRemove.push_back(target);
         }
+        return;
     }
+
+    // the node may be deleted by release(), and remove its actions again
+    Node* node = target->node;
+    _targets.erase(node);
+    node->release();
 }
 
 // pause / resume
 
 void ActionManager::pauseTarget(Node *target)
 {
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
+    Target* element = findTarget(target);
     if (element)
     {
         element->paused = true;
@@ -140,8 +169,7 @@ void ActionManager::pauseTarget(Node *target)
 
 void ActionManager::resumeTarget(Node *target)
 {
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
+    Target* element = findTarget(target);
     if (element)
     {
         element->paused = false;
@@ -152,12 +180,13 @@ Vector<Node*> ActionManager::pauseAllRunningActions()
 {
     Vector<Node*> idsWithActions;
 
-    for (tHashElement *element=_targets; element != nullptr; element = (tHashElement *)element->hh.next)
+    for (auto& iter : _targets)
     {
-        if (! element->paused)
+        Target& element = iter.second;
+        if (! element.paused)
         {
-            element->paused = true;
-            idsWithActions.pushBack(element->target);
+            element.paused = true;
+            idsWithActions.pushBack(element.node);
         }
     }
 
@@ -181,23 +210,32 @@ void ActionManager::addAction(Action *action, Node *target, bool paused)
     if(action == nullptr || target == nullptr)
         return;
 
-    tHashElement *element = nullptr;
-    // we should convert it to Ref*, because we save it as Ref*
-    Ref *tmp = target;
-    HASH_FIND_PTR(_targets, &tmp, element);
+    Target* element = findTarget(target);
     if (! element)
     {
-        element = (tHashElement*)calloc(sizeof(*element), 1);
+        element = &_targets[target];
+        element->node = target;
         element->paused = paused;
+        element->pendingRemoval = false;
         target->retain();
-        element->target = target;
-        HASH_ADD_PTR(_targets, target, element);
     }
 
-    actionAllocWithHashElement(element);
+#if COCOS2D_DEBUG > 0
+    for (auto index : element->actionIndices)
+    {
+        CCASSERT(_actions[index].action != action, "action already be added!");
+    }
+#endif
 
-    CCASSERT(! ccArrayContainsObject(element->actions, action), "action already be added!");
-    ccArrayAppendObject(element->actions, action);
+    // added during update(), it is stepped in the same pass
+    RunningAction running;
+    running.action = action;
+    running.target = element;
+    running.removed = false;
+    element->actionIndices.push_back(_actions.size());
+    _actions.push_back(running);
+
+    action->retain();
 #if CC_ENABLE_GC_FOR_NATIVE_OBJECTS
     auto sEngine = ScriptEngineManager::getInstance()->getScriptEngine();
     if (sEngine)
@@ -213,11 +251,16 @@ void ActionManager::addAction(Action *action, Node *target, bool paused)
 
 void ActionManager::removeAllActions()
 {
-    for (tHashElement *element = _targets; element != nullptr; )
+    std::vector<Node*> nodes;
+    nodes.reserve(_targets.size());
+    for (const auto& iter : _targets)
     {
-        auto target = element->target;
-        element = (tHashElement*)element->hh.next;
-        removeAllActionsFromTarget(target);
+        nodes.push_back(iter.second.node);
+    }
+
+    for (auto node : nodes)
+    {
+        removeAllActionsFromTarget(node);
     }
 }
 
@@ -229,42 +272,14 @@ void ActionManager::removeAllActionsFromTarget(Node *target)
         return;
     }
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
+    Target* element = findTarget(target);
     if (element)
     {
-        if (ccArrayContainsObject(element->actions, element->currentAction) && (! element->currentActionSalvaged))
-        {
-            element->currentAction->retain();
-            element->currentActionSalvaged = true;
-        }
-        
-        ccArrayRemoveAllObjects(element->actions);
-        
-#if CC_ENABLE_GC_FOR_NATIVE_OBJECTS
-        auto sEngine = ScriptEngineManager::getInstance()->getScriptEngine();
-        if (sEngine)
-        {
-            auto limit = element->actions->num;
-            for (int i = 0; i < limit; ++i)
-            {
-                Action *action = (Action*)element->actions->arr[i];
-                if (!element->currentActionSalvaged || element->currentAction != action)
-                {
-                    sEngine->releaseScriptObject(this, action);
-                }
-            }
-        }
-#endif // CC_ENABLE_GC_FOR_NATIVE_OBJECTS
-        
-        if (_currentTarget == element)
-        {
-            _currentTargetSalvaged = true;
-        }
-        else
+        while (!element->actionIndices.empty())
         {
-            deleteHashElement(element);
+            removeActionAt(element, element->actionIndices.size() - 1);
         }
+        removeTargetIfEmpty(element);
     }
 }
 
@@ -276,15 +291,18 @@ void ActionManager::removeAction(Action *action)
         return;
     }
 
-    tHashElement *element = nullptr;
-    Ref *target = action->getOriginalTarget();
-    HASH_FIND_PTR(_targets, &target, element);
+    Target* element = findTarget(action->getOriginalTarget());
     if (element)
     {
-        auto i = ccArrayGetIndexOfObject(element->actions, action);
-        if (i != CC_INVALID_INDEX)
+        auto& indices = element->actionIndices;
+        for (size_t i = 0; i < indices.size(); ++i)
         {
-            removeActionAtIndex(i, element);
+            if (_actions[indices[i]].action == action)
+            {
+                removeActionAt(element, i);
+                removeTargetIfEmpty(element);
+                break;
+            }
         }
     }
 }
@@ -298,19 +316,18 @@ void ActionManager::removeActionByTag(int tag, Node *target)
         return;
     }
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-
+    Target* element = findTarget(target);
     if (element)
     {
-        auto limit = element->actions->num;
-        for (int i = 0; i < limit; ++i)
+        auto& indices = element->actionIndices;
+        for (size_t i = 0; i < indices.size(); ++i)
         {
-            Action *action = (Action*)element->actions->arr[i];
+            Action *action = _actions[indices[i]].action;
 
             if (action->getTag() == (int)tag && action->getOriginalTarget() == target)
             {
-                removeActionAtIndex(i, element);
+                removeActionAt(element, i);
+                removeTargetIfEmpty(element);
                 break;
             }
         }
@@ -326,26 +343,24 @@ void ActionManager::removeAllActionsByTag(int tag, Node *target)
         return;
     }
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-
+    Target* element = findTarget(target);
     if (element)
     {
-        auto limit = element->actions->num;
-        for (int i = 0; i < limit;)
+        auto& indices = element->actionIndices;
+        for (size_t i = 0; i < indices.size();)
         {
-            Action *action = (Action*)element->actions->arr[i];
+            Action *action = _actions[indices[i]].action;
 
             if (action->getTag() == (int)tag && action->getOriginalTarget() == target)
             {
-                removeActionAtIndex(i, element);
-                --limit;
+                removeActionAt(element, i);
             }
             else
             {
                 ++i;
             }
         }
+        removeTargetIfEmpty(element);
     }
 }
 
@@ -361,53 +376,43 @@ void ActionManager::removeActionsByFlags(unsigned int flags, Node *target)
         return;
     }
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-
+    Target* element = findTarget(target);
     if (element)
     {
-        auto limit = element->actions->num;
-        for (int i = 0; i < limit;)
+        auto& indices = element->actionIndices;
+        for (size_t i = 0; i < indices.size();)
         {
-            Action *action = (Action*)element->actions->arr[i];
+            Action *action = _actions[indices[i]].action;
 
             if ((action->getFlags() & flags) != 0 && action->getOriginalTarget() == target)
             {
-                removeActionAtIndex(i, element);
-                --limit;
+                removeActionAt(element, i);
             }
             else
             {
                 ++i;
             }
         }
+        removeTargetIfEmpty(element);
     }
 }
 
 // get
 
-// FIXME: Passing "const O *" instead of "const O&" because HASH_FIND_IT requires the address of a pointer
-// and, it is not possible to get the address of a reference
 Action* ActionManager::getActionByTag(int tag, const Node *target) const
 {
     CCASSERT(tag != Action::INVALID_TAG, "Invalid tag value!");
 
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
-
+    Target* element = findTarget(target);
     if (element)
     {
-        if (element->actions != nullptr)
+        for (auto index : element->actionIndices)
         {
-            auto limit = element->actions->num;
-            for (int i = 0; i < limit; ++i)
-            {
-                Action *action = (Action*)element->actions->arr[i];
+            Action *action = _actions[index].action;
 
-                if (action->getTag() == (int)tag)
-                {
-                    return action;
-                }
+            if (action->getTag() == (int)tag)
+            {
+                return action;
             }
         }
     }
@@ -415,90 +420,89 @@ Action* ActionManager::getActionByTag(int tag, const Node *target) const
     return nullptr;
 }
 
-// FIXME: Passing "const O *" instead of "const O&" because HASH_FIND_IT requires the address of a pointer
-// and, it is not possible to get the address of a reference
 ssize_t ActionManager::getNumberOfRunningActionsInTarget(const Node *target) const
 {
-    tHashElement *element = nullptr;
-    HASH_FIND_PTR(_targets, &target, element);
+    Target* element = findTarget(target);
     if (element)
     {
-        return element->actions ? element->actions->num : 0;
+        return (ssize_t)element->actionIndices.size();
     }
 
     return 0;
 }
 
+ssize_t ActionManager::getNumberOfRunningActions() const
+{
+    return (ssize_t)(_actions.size() - _removedCount);
+}
+
 // main loop
 void ActionManager::update(float dt)
 {
-    for (tHashElement *elt = _targets; elt != nullptr; )
+    _isUpdating = true;
+
+    // the actions added while stepping are appended, and stepped in the same pass
+    for (size_t i = 0; i < _actions.size(); ++i)
     {
-        _currentTarget = elt;
-        _currentTargetSalvaged = false;
+        // a copy, _actions may be reallocated by the step
+        RunningAction running = _actions[i];
+        if (running.removed)
+        {
+            continue;
+        }
 
-        if (! _currentTarget->paused)
+        Target* target = running.target;
+        if (! target->paused)
         {
-            // The 'actions' MutableArray may change while inside this loop.
-            for (_currentTarget->actionIndex = 0; _currentTarget->actionIndex < _currentTarget->actions->num;
-                _currentTarget->actionIndex++)
+            running.action->step(dt);
+
+            // the step may have removed the action
+            if (! _actions[i].removed && running.action->isDone())
             {
-                _currentTarget->currentAction = (Action*)_currentTarget->actions->arr[_currentTarget->actionIndex];
-                if (_currentTarget->currentAction == nullptr)
-                {
-                    continue;
-                }
-
-                _currentTarget->currentActionSalvaged = false;
-
-                _currentTarget->currentAction->step(dt);
-
-                if (_currentTarget->currentActionSalvaged)
-                {
-                    // The currentAction told the node to remove it. To prevent the action from
-                    // accidentally deallocating itself before finishing its step, we retained
-                    // it. Now that step is done, it's safe to release it.
-                    _currentTarget->currentAction->release();
-#if CC_ENABLE_GC_FOR_NATIVE_OBJECTS
-                    auto sEngine = ScriptEngineManager::getInstance()->getScriptEngine();
-                    if (sEngine)
-                    {
-                        sEngine->releaseScriptObject(this, _currentTarget->currentAction);
-                    }
-#endif // CC_ENABLE_GC_FOR_NATIVE_OBJECTS
-                } else
-                if (_currentTarget->currentAction->isDone())
-                {
-                    _currentTarget->currentAction->stop();
-
-                    Action *action = _currentTarget->currentAction;
-                    // Make currentAction nil to prevent removeAction from salvaging it.
-                    _currentTarget->currentAction = nullptr;
-                    removeAction(action);
-                }
-
-                _currentTarget->currentAction = nullptr;
+                running.action->stop();
+
+                auto& indices = target->actionIndices;
+                auto iter = std::find(indices.begin(), indices.end(), i);
+                removeActionAt(target, iter - indices.begin());
+                removeTargetIfEmpty(target);
             }
         }
 
-        // elt, at this moment, is still valid
-        // so it is safe to ask this here (issue #490)
-        elt = (tHashElement*)(elt->hh.next);
-
-        // only delete currentTarget if no actions were scheduled during the cycle (issue #481)
-        if (_currentTargetSalvaged && _currentTarget->actions->num == 0)
-        {
-            deleteHashElement(_currentTarget);
-        }
         //if some node reference 'target', it's reference count >= 2 (issues #14050)
-        else if (_currentTarget->target->getReferenceCount() == 1)
+        if (! target->pendingRemoval && target->node->getReferenceCount() == 1)
         {
-            deleteHashElement(_currentTarget);
+            target->pendingRemoval = true;
+            _targetsToRemove.push_back(target);
         }
     }
 
-    // issue #635
-    _currentTarget = nullptr;
+    _isUpdating = false;
+
+    // the batched actions are written before their targets may be released
+    TweenBatch::getInstance()->flush();
+
+    if (_removedCount > 0)
+    {
+        compactActions();
+    }
+
+    if (! _targetsToRemove.empty())
+    {
+        std::vector<Target*> targets;
+        targets.swap(_targetsToRemove);
+        for (auto target : targets)
+        {
+            target->pendingRemoval = false;
+            if (target->node->getReferenceCount() == 1)
+            {
+                removeAllActionsFromTarget(target->node);
+            }
+            else
+            {
+                removeTargetIfEmpty(target);
+            }
+        }
+    }
 }
 
 NS_CC_END
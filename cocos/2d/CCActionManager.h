@@ -32,13 +32,13 @@ THE SOFTWARE.
 #include "2d/CCAction.h"
 #include "base/CCVector.h"
 #include "base/CCRef.h"
+#include <vector>
+#include <unordered_map>
 
 NS_CC_BEGIN
 
 class Action;
 
-struct _hashElement;
-
 /**
  * @addtogroup actions
  * @{
@@ -53,6 +53,10 @@ struct _hashElement;
     - When you want to run an action where the target is different from a Node.
     - When you want to pause / resume the actions.
 
+ The running actions are stored in a contiguous table, which update() walks in the order they were added.
+ Actions added during update() are appended to the table, and stepped in the same pass.
+ Removed actions only leave a hole, the table is compacted at the end of update(), or once half of it is holes.
+
  @since v0.8
  */
 class CC_DLL ActionManager : public Ref
@@ -170,17 +174,41 @@ public:
      */
     void update(float dt);
 
-protected:
-    // declared in ActionManager.m
-
-    void removeActionAtIndex(ssize_t index, struct _hashElement *element);
-    void deleteHashElement(struct _hashElement *element);
-    void actionAllocWithHashElement(struct _hashElement *element);
+    /** Returns the number of actions running on all the targets. */
+    ssize_t getNumberOfRunningActions() const;
 
 protected:
-    struct _hashElement    *_targets;
-    struct _hashElement    *_currentTarget;
-    bool            _currentTargetSalvaged;
+    struct Target
+    {
+        Node* node;
+        bool paused;
+        // queued in _targetsToRemove
+        bool pendingRemoval;
+        // where the actions of the target are in _actions
+        std::vector<size_t> actionIndices;
+    };
+
+    struct RunningAction
+    {
+        Action* action;
+        Target* target;
+        // a hole in the table, its action is released once update() is done
+        bool removed;
+    };
+
+    Target* findTarget(const Node* node) const;
+    void removeActionAt(Target* target, size_t position);
+    void releaseAction(Action* action);
+    void compactActions();
+    void removeTargetIfEmpty(Target* target);
+
+    std::vector<RunningAction> _actions;
+    std::unordered_map<const Node*, Target> _targets;
+
+    bool _isUpdating;
+    // the number of holes in _actions, and the targets which may have to be removed after update()
+    size_t _removedCount;
+    std::vector<Target*> _targetsToRemove;
 };
 
 // end of actions group
@@ -0,0 +1,155 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "2d/CCAnimationLOD.h"
+#include "base/CCDirector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <float.h>
+
+NS_CC_BEGIN
+
+AnimationLOD::State::State()
+: drawn(false)
+, onScreen(true)
+, screenSize(FLT_MAX)
+, skippedUpdates(-1)
+{
+}
+
+AnimationLOD* AnimationLOD::s_animationLOD = nullptr;
+
+AnimationLOD* AnimationLOD::getInstance()
+{
+    if (s_animationLOD == nullptr)
+    {
+        s_animationLOD = new (std::nothrow) AnimationLOD();
+    }
+    return s_animationLOD;
+}
+
+void AnimationLOD::destroyInstance()
+{
+    delete s_animationLOD;
+    s_animationLOD = nullptr;
+}
+
+AnimationLOD::AnimationLOD()
+: _enabled(false)
+, _smallSize(64)
+, _smallUpdateInterval(3)
+, _countedFrame(0)
+, _evaluatedCount(0)
+, _skippedCount(0)
+{
+}
+
+bool AnimationLOD::checkDraw(State& state, const Mat4& transform)
+{
+    state.drawn = true;
+
+    if (!_enabled || state.bounds.size.width <= 0 || state.bounds.size.height <= 0)
+    {
+        state.onScreen = true;
+        state.screenSize = FLT_MAX;
+        return true;
+    }
+
+    // the same test as Renderer::checkVisibility(), which doesn't cull anything without cameras
+    auto director = Director::getInstance();
+    Rect visibleRect(director->getVisibleOrigin(), director->getVisibleSize());
+
+    // transform center point to screen space
+    float hSizeX = state.bounds.size.width / 2;
+    float hSizeY = state.bounds.size.height / 2;
+    Vec3 v3p(state.bounds.origin.x + hSizeX, state.bounds.origin.y + hSizeY, 0);
+    transform.transformPoint(&v3p);
+
+    // convert content size to world coordinates
+    float wshw = std::max(fabsf(hSizeX * transform.m[0] + hSizeY * transform.m[4]), fabsf(hSizeX * transform.m[0] - hSizeY * transform.m[4]));
+    float wshh = std::max(fabsf(hSizeX * transform.m[1] + hSizeY * transform.m[5]), fabsf(hSizeX * transform.m[1] - hSizeY * transform.m[5]));
+
+    // enlarge visible rect half size in screen coord
+    visibleRect.origin.x -= wshw;
+    visibleRect.origin.y -= wshh;
+    visibleRect.size.width += wshw * 2;
+    visibleRect.size.height += wshh * 2;
+
+    state.onScreen = visibleRect.containsPoint(Vec2(v3p.x, v3p.y));
+    state.screenSize = std::max(wshw, wshh) * 2;
+
+    // the bounds are only up to date if the pose was kept since they were measured
+    return state.onScreen || state.skippedUpdates <= 0;
+}
+
+bool AnimationLOD::checkUpdate(State& state)
+{
+    bool evaluate = true;
+    if (_enabled && state.skippedUpdates >= 0)
+    {
+        if (!state.drawn || !state.onScreen)
+        {
+            evaluate = false;
+        }
+        else if (state.screenSize < _smallSize)
+        {
+            evaluate = state.skippedUpdates + 1 >= _smallUpdateInterval;
+        }
+    }
+
+    state.drawn = false;
+    state.skippedUpdates = evaluate ? 0 : state.skippedUpdates + 1;
+
+    const unsigned int frame = Director::getInstance()->getTotalFrames();
+    if (frame != _countedFrame)
+    {
+        _countedFrame = frame;
+        _evaluatedCount = 0;
+        _skippedCount = 0;
+    }
+
+    if (evaluate)
+    {
+        ++_evaluatedCount;
+    }
+    else
+    {
+        ++_skippedCount;
+    }
+
+    return evaluate;
+}
+
+int AnimationLOD::getEvaluatedCount() const
+{
+    return _countedFrame == Director::getInstance()->getTotalFrames() ? _evaluatedCount : 0;
+}
+
+int AnimationLOD::getSkippedCount() const
+{
+    return _countedFrame == Director::getInstance()->getTotalFrames() ? _skippedCount : 0;
+}
+
+NS_CC_END
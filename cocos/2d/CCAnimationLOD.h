@@ -0,0 +1,133 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_ANIMATION_LOD_H__
+#define __CC_ANIMATION_LOD_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "math/CCGeometry.h"
+#include "math/Mat4.h"
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class AnimationLOD
+ * @brief The level of detail policy of the skeletal animations: spine::SkeletonAnimation,
+ * dragonBones::CCArmatureDisplay and cocostudio::Armature.
+ *
+ * The animations of a skeleton always advance and fire their events, but its pose (the bone transforms
+ * and the vertices) is only evaluated when it can be seen:
+ * - the pose of the skeletons which weren't drawn in the last frame, because they or one of their parents
+ *   are invisible, or because they are off screen, is kept as it is.
+ * - the pose of the skeletons smaller than getSmallSize() on screen is evaluated every getSmallUpdateInterval() updates.
+ *
+ * The bounds of a skeleton are measured when it's drawn, so a skeleton whose pose is kept is
+ * seen with its previous pose for one frame when it comes back on screen, and a skeleton moved
+ * on screen by its own animation while its node stays off screen keeps being off screen.
+ * Only the default projection is supported: skeletons drawn into render textures may be seen as off screen.
+ *
+ * The policy is disabled by default.
+ * @js NA
+ */
+class CC_DLL AnimationLOD
+{
+public:
+    /** The LOD state of a skeleton, owned by the skeleton. */
+    struct CC_DLL State
+    {
+        State();
+
+        /** The bounds of the pose last drawn, in the space of the node. Zero until they are measured. */
+        Rect bounds;
+        /** Whether the skeleton was drawn since its last update. */
+        bool drawn;
+        /** Whether the bounds were on screen when the skeleton was last drawn. */
+        bool onScreen;
+        /** The largest side of the bounds on screen, in points, when the skeleton was last drawn. */
+        float screenSize;
+        /** The number of updates since the pose was last evaluated, -1 until it is evaluated. */
+        int skippedUpdates;
+    };
+
+    /** Returns the shared LOD policy. */
+    static AnimationLOD* getInstance();
+
+    /** Destroys the shared LOD policy. */
+    static void destroyInstance();
+
+    /** Sets whether the poses of the skeletons which can't be seen are kept. Defaults to false. */
+    void setEnabled(bool enabled) { _enabled = enabled; }
+    bool isEnabled() const { return _enabled; }
+
+    /** Sets the size on screen, in points, under which the pose is evaluated at a reduced rate. Defaults to 64, 0 disables it. */
+    void setSmallSize(float size) { _smallSize = size; }
+    float getSmallSize() const { return _smallSize; }
+
+    /** Sets every how many updates the pose of the small skeletons is evaluated. Defaults to 3. */
+    void setSmallUpdateInterval(int interval) { _smallUpdateInterval = interval; }
+    int getSmallUpdateInterval() const { return _smallUpdateInterval; }
+
+    /**
+     * Called by a skeleton when it's drawn, with the bounds of its pose measured by a previous draw.
+     * @param transform The model view transform of the skeleton.
+     * @return false if the skeleton is off screen and its pose is the one it had when the bounds were measured,
+     * so it doesn't need to be drawn.
+     */
+    bool checkDraw(State& state, const Mat4& transform);
+
+    /**
+     * Called by a skeleton when it's updated.
+     * @return Whether the pose must be evaluated. Otherwise the skeleton only advances its animations
+     * and fires their events, keeping its current pose.
+     */
+    bool checkUpdate(State& state);
+
+    /** Returns the number of skeletons whose pose was evaluated in the current frame, so far. */
+    int getEvaluatedCount() const;
+    /** Returns the number of skeletons whose pose was kept in the current frame, so far. */
+    int getSkippedCount() const;
+
+protected:
+    AnimationLOD();
+
+    bool _enabled;
+    float _smallSize;
+    int _smallUpdateInterval;
+
+    // the counters of the frame _countedFrame
+    unsigned int _countedFrame;
+    int _evaluatedCount;
+    int _skippedCount;
+
+    static AnimationLOD* s_animationLOD;
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_ANIMATION_LOD_H__
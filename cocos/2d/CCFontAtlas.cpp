@@ -43,6 +43,9 @@ const int FontAtlas::CacheTextureHeight = 512;
 const char* FontAtlas::CMD_PURGE_FONTATLAS = "__cc_PURGE_FONTATLAS";
 const char* FontAtlas::CMD_RESET_FONTATLAS = "__cc_RESET_FONTATLAS";
 
+static const size_t KERNINGS_CACHE_MAX_LENGTH = 64;
+static const size_t KERNINGS_CACHE_MAX_ENTRIES = 256;
+
 FontAtlas::FontAtlas(Font &theFont)
 : _font(&theFont)
 , _fontFreeType(nullptr)
@@ -176,6 +179,40 @@ void FontAtlas::scaleFontLetterDefinition(float scaleFactor)
     }
 }
 
+bool FontAtlas::getHorizontalKernings(const std::u16string& utf16String, std::vector<int>& kernings)
+{
+    std::string key(reinterpret_cast<const char*>(utf16String.data()), utf16String.length() * sizeof(char16_t));
+    auto it = _kerningsCache.find(key);
+    if (it != _kerningsCache.end())
+    {
+        kernings = it->second;
+        return !kernings.empty();
+    }
+
+    int letterCount = 0;
+    int* sizes = _font->getHorizontalKerningForTextUTF16(utf16String, letterCount);
+    if (sizes)
+    {
+        kernings.assign(sizes, sizes + letterCount);
+        delete [] sizes;
+    }
+    else
+    {
+        kernings.clear();
+    }
+
+    // the long texts are rarely laid out twice
+    if (utf16String.length() <= KERNINGS_CACHE_MAX_LENGTH)
+    {
+        if (_kerningsCache.size() >= KERNINGS_CACHE_MAX_ENTRIES)
+        {
+            _kerningsCache.clear();
+        }
+        _kerningsCache[key] = kernings;
+    }
+    return !kernings.empty();
+}
+
 bool FontAtlas::getLetterDefinitionForChar(char16_t utf16Char, FontLetterDefinition &letterDefinition)
 {
     auto outIterator = _letterDefinitions.find(utf16Char);
@@ -30,6 +30,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "platform/CCPlatformMacros.h"
 #include "base/CCRef.h"
@@ -78,6 +79,12 @@ public:
 
     bool prepareLetterDefinitions(const std::u16string& utf16String);
 
+    /** Gets the kerning of each letter of the text with the previous one.
+     The kernings of the short texts are cached, a label showing a counter or a timer keeps showing the same texts.
+     @return false if the font has no kerning for the text.
+     */
+    bool getHorizontalKernings(const std::u16string& utf16String, std::vector<int>& kernings);
+
     inline const std::unordered_map<ssize_t, Texture2D*>& getTextures() const{ return _atlasTextures;}
     void  addTexture(Texture2D *texture, int slot);
     float getLineHeight() const { return _lineHeight; }
@@ -126,6 +133,8 @@ protected:
 
     std::unordered_map<ssize_t, Texture2D*> _atlasTextures;
     std::unordered_map<char16_t, FontLetterDefinition> _letterDefinitions;
+    // keyed by the bytes of the UTF-16 text
+    std::unordered_map<std::string, std::vector<int>> _kerningsCache;
     float _lineHeight;
     Font* _font;
     FontFreeType* _fontFreeType;
@@ -378,7 +378,6 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
 , _shadowNode(nullptr)
 , _fontAtlas(nullptr)
 , _reusedLetter(nullptr)
-, _horizontalKernings(nullptr)
 , _boldEnabled(false)
 , _italicsEnabled(false)
 , _underlineNode(nullptr)
@@ -428,8 +427,6 @@ Label::Label(TextHAlignment hAlignment /* = TextHAlignment::LEFT */,
 
 Label::~Label()
 {
-    delete [] _horizontalKernings;
-
     if (_fontAtlas)
     {
         Node::removeAllChildrenWithCleanup(true);
@@ -455,6 +452,7 @@ void Label::reset()
     _letters.clear();
     _batchNodes.clear();
     _lettersInfo.clear();
+    _letterQuads.clear();
     if (_fontAtlas)
     {
         FontAtlasCache::releaseFontAtlas(_fontAtlas);
@@ -477,11 +475,7 @@ void Label::reset()
     _systemFont = "Helvetica";
     _systemFontSize = 12;
 
-    if (_horizontalKernings)
-    {
-        delete[] _horizontalKernings;
-        _horizontalKernings = nullptr;
-    }
+    _horizontalKernings.clear();
     _additionalKerning = 0.f;
     _lineHeight = 0.f;
     _lineSpacing = 0.f;
@@ -583,6 +577,7 @@ void Label::setFontAtlas(FontAtlas* atlas,bool distanceFieldEnabled /* = false *
     {
         _systemFontDirty = false;
     }
+    _letterQuads.clear();
 
     if (atlas == _fontAtlas)
     {
@@ -676,7 +671,7 @@ void Label::setString(const std::string& text)
         std::u16string utf16String;
         if (StringUtils::UTF8ToUTF16(_utf8Text, utf16String))
         {
-            _utf16Text  = utf16String;
+            _utf16Text.swap(utf16String);
         }
     }
 }
@@ -873,19 +868,7 @@ bool Label::alignText()
 
 bool Label::computeHorizontalKernings(const std::u16string& stringToRender)
 {
-    if (_horizontalKernings)
-    {
-        delete [] _horizontalKernings;
-        _horizontalKernings = nullptr;
-    }
-
-    int letterCount = 0;
-    _horizontalKernings = _fontAtlas->getFont()->getHorizontalKerningForTextUTF16(stringToRender, letterCount);
-
-    if(!_horizontalKernings)
-        return false;
-    else
-        return true;
+    return _fontAtlas->getHorizontalKernings(stringToRender, _horizontalKernings);
 }
 
 bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
@@ -899,17 +882,124 @@ bool Label::isHorizontalClamped(float letterPositionX, int lineIndex)
     }
 }
 
+bool Label::LetterQuad::operator==(const LetterQuad& other) const
+{
+    return utf16Char == other.utf16Char && valid == other.valid
+        && U == other.U && V == other.V && width == other.width && height == other.height && textureID == other.textureID
+        && positionX == other.positionX && positionY == other.positionY && lineWidth == other.lineWidth;
+}
+
+bool Label::QuadsLayout::operator==(const QuadsLayout& other) const
+{
+    return labelType == other.labelType && fntSpriteFrame == other.fntSpriteFrame
+        && bmFontSize == other.bmFontSize && bmfontScale == other.bmfontScale && letterOffsetY == other.letterOffsetY
+        && tailoredTopY == other.tailoredTopY && tailoredBottomY == other.tailoredBottomY
+        && labelWidth == other.labelWidth && labelHeight == other.labelHeight && contentWidth == other.contentWidth
+        && overflow == other.overflow && enableWrap == other.enableWrap;
+}
+
+void Label::getLetterQuad(int letterIndex, LetterQuad& letterQuad)
+{
+    const auto& letterInfo = _lettersInfo[letterIndex];
+    letterQuad.utf16Char = letterInfo.utf16Char;
+    letterQuad.valid = letterInfo.valid;
+    letterQuad.hasQuad = false;
+    if (!letterInfo.valid)
+    {
+        letterQuad.U = letterQuad.V = letterQuad.width = letterQuad.height = 0.f;
+        letterQuad.textureID = 0;
+        letterQuad.positionX = letterQuad.positionY = letterQuad.lineWidth = 0.f;
+        return;
+    }
+
+    const auto& letterDef = _fontAtlas->_letterDefinitions[letterInfo.utf16Char];
+    letterQuad.U = letterDef.U;
+    letterQuad.V = letterDef.V;
+    letterQuad.width = letterDef.width;
+    letterQuad.height = letterDef.height;
+    letterQuad.textureID = letterDef.textureID;
+    letterQuad.positionX = letterInfo.positionX + _linesOffsetX[letterInfo.lineIndex];
+    letterQuad.positionY = letterInfo.positionY;
+    letterQuad.lineWidth = _linesWidth[letterInfo.lineIndex];
+}
+
+int Label::getNumberOfUnchangedQuads()
+{
+    QuadsLayout layout;
+    layout.labelType = _currentLabelType;
+    layout.fntSpriteFrame = _fntSpriteFrame;
+    layout.bmFontSize = _bmFontSize;
+    layout.bmfontScale = _bmfontScale;
+    layout.letterOffsetY = _letterOffsetY;
+    layout.tailoredTopY = _tailoredTopY;
+    layout.tailoredBottomY = _tailoredBottomY;
+    layout.labelWidth = _labelWidth;
+    layout.labelHeight = _labelHeight;
+    layout.contentWidth = _contentSize.width;
+    layout.overflow = _overflow;
+    layout.enableWrap = _enableWrap;
+
+    bool sameAtlases = !_letterQuads.empty() && layout == _quadsLayout && _quadsAtlases.size() <= static_cast<size_t>(_batchNodes.size());
+    for (size_t i = 0; sameAtlases && i < _quadsAtlases.size(); ++i)
+    {
+        auto textureAtlas = _batchNodes.at(i)->getTextureAtlas();
+        sameAtlases = textureAtlas == _quadsAtlases[i] && textureAtlas->getTotalQuads() == _quadsAtlasesCount[i];
+    }
+    _quadsLayout = layout;
+
+    if (!sameAtlases)
+    {
+        _letterQuads.clear();
+        return 0;
+    }
+
+    int count = std::min(_lengthOfString, static_cast<int>(_letterQuads.size()));
+    LetterQuad letterQuad;
+    for (int ctr = 0; ctr < count; ++ctr)
+    {
+        getLetterQuad(ctr, letterQuad);
+        if (!(letterQuad == _letterQuads[ctr]))
+        {
+            return ctr;
+        }
+    }
+    return count;
+}
+
 bool Label::updateQuads()
 {
     bool ret = true;
-    for (auto&& batchNode : _batchNodes)
+
+    // a label showing a counter usually only changes its last letters, the quads of the letters
+    // before the first changed one are kept
+    int unchangedQuads = getNumberOfUnchangedQuads();
+    std::vector<ssize_t> keptQuads(_batchNodes.size(), 0);
+    for (int ctr = 0; ctr < unchangedQuads; ++ctr)
     {
-        batchNode->getTextureAtlas()->removeAllQuads();
+        if (_letterQuads[ctr].hasQuad)
+        {
+            ++keptQuads[_letterQuads[ctr].textureID];
+        }
+    }
+    for (ssize_t i = 0; i < _batchNodes.size(); ++i)
+    {
+        auto textureAtlas = _batchNodes.at(i)->getTextureAtlas();
+        auto totalQuads = textureAtlas->getTotalQuads();
+        if (keptQuads[i] == 0)
+        {
+            textureAtlas->removeAllQuads();
+        }
+        else if (totalQuads > keptQuads[i])
+        {
+            textureAtlas->removeQuadsAtIndex(keptQuads[i], totalQuads - keptQuads[i]);
+        }
     }
+    _letterQuads.resize(_lengthOfString);
 
     bool letterClamp = false;
-    for (int ctr = 0; ctr < _lengthOfString; ++ctr)
+    for (int ctr = unchangedQuads; ctr < _lengthOfString; ++ctr)
     {
+        getLetterQuad(ctr, _letterQuads[ctr]);
         if (_lettersInfo[ctr].valid)
         {
             auto& letterDef = _fontAtlas->_letterDefinitions[_lettersInfo[ctr].utf16Char];
@@ -995,10 +1085,26 @@ bool Label::updateQuads()
                 this->updateLetterSpriteScale(_reusedLetter);
 
                 _batchNodes.at(letterDef.textureID)->insertQuadFromSprite(_reusedLetter, index);
+                _letterQuads[ctr].hasQuad = true;
             }
         }
     }
 
+    if (ret)
+    {
+        _quadsAtlases.clear();
+        _quadsAtlasesCount.clear();
+        for (auto&& batchNode : _batchNodes)
+        {
+            _quadsAtlases.push_back(batchNode->getTextureAtlas());
+            _quadsAtlasesCount.push_back(batchNode->getTextureAtlas()->getTotalQuads());
+        }
+    }
+    else
+    {
+        // the letters after the clamped one have no quad
+        _letterQuads.clear();
+    }
 
     return ret;
 }
@@ -1416,12 +1522,7 @@ void Label::updateContent()
 
     if (_fontAtlas)
     {
-        std::u16string utf16String;
-        if (StringUtils::UTF8ToUTF16(_utf8Text, utf16String))
-        {
-            _utf16Text = utf16String;
-        }
-
+        // _utf16Text was converted by setString()
         computeHorizontalKernings(_utf16Text);
         updateFinished = alignText();
     }
@@ -93,6 +93,7 @@ class SpriteBatchNode;
 class DrawNode;
 class EventListenerCustom;
 class SpriteFrame;
+class TextureAtlas;
 
 /**
  * @brief Label is a subclass of Node that knows how to render text labels.
@@ -654,6 +655,44 @@ protected:
         STRING_TEXTURE
     };
 
+    // what the quad of a letter was generated from
+    struct LetterQuad
+    {
+        char16_t utf16Char;
+        bool valid;
+        float U;
+        float V;
+        float width;
+        float height;
+        int textureID;
+        // the position includes the line offset
+        float positionX;
+        float positionY;
+        float lineWidth;
+        bool hasQuad;
+
+        bool operator==(const LetterQuad& other) const;
+    };
+
+    // what the quads of all the letters were clipped and scaled with
+    struct QuadsLayout
+    {
+        LabelType labelType;
+        SpriteFrame* fntSpriteFrame;
+        float bmFontSize;
+        float bmfontScale;
+        float letterOffsetY;
+        float tailoredTopY;
+        float tailoredBottomY;
+        float labelWidth;
+        float labelHeight;
+        float contentWidth;
+        Overflow overflow;
+        bool enableWrap;
+
+        bool operator==(const QuadsLayout& other) const;
+    };
+
     virtual void setFontAtlas(FontAtlas* atlas, bool distanceFieldEnabled = false, bool useA8Shader = false);
 
     void computeStringNumLines();
@@ -680,6 +719,8 @@ protected:
     void recordPlaceholderInfo(int letterIndex, char16_t utf16Char);
 
     bool updateQuads();
+    void getLetterQuad(int letterIndex, LetterQuad& letterQuad);
+    int getNumberOfUnchangedQuads();
 
     void createSpriteForSystemFont(const FontDefinition& fontDef);
     void createShadowSpriteForSystemFont(const FontDefinition& fontDef);
@@ -721,6 +762,12 @@ protected:
     Vector<SpriteBatchNode*> _batchNodes;
     std::vector<LetterInfo> _lettersInfo;
 
+    // the state of the last updateQuads(), the quads of the unchanged first letters are kept
+    std::vector<LetterQuad> _letterQuads;
+    QuadsLayout _quadsLayout;
+    std::vector<TextureAtlas*> _quadsAtlases;
+    std::vector<ssize_t> _quadsAtlasesCount;
+
     //! used for optimization
     Sprite *_reusedLetter;
     Rect _reusedRect;
@@ -730,7 +777,7 @@ protected:
     float _lineHeight;
     float _lineSpacing;
     float _additionalKerning;
-    int* _horizontalKernings;
+    std::vector<int> _horizontalKernings;
     bool _lineBreakWithoutSpaces;
     float _maxLineWidth;
     Size _labelDimensions;
@@ -213,7 +213,7 @@ bool Label::multilineTextWrap(const std::function<int(const std::u16string&, int
 
             if (nextChangeSize)
             {
-                if (_horizontalKernings && letterIndex < textLen - 1)
+                if (!_horizontalKernings.empty() && letterIndex < textLen - 1)
                     nextLetterX += _horizontalKernings[letterIndex + 1];
                 nextLetterX += letterDef.xAdvance * _bmfontScale + _additionalKerning;
 
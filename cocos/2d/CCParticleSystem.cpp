@@ -55,6 +55,8 @@ THE SOFTWARE.
 #include "base/ccUTF8.h"
 #include "renderer/CCTextureCache.h"
 #include "platform/CCFileUtils.h"
+#include "base/CCWorkerPool.h"
+#include "math/CCSIMD.h"
 
 using namespace std;
 
@@ -220,6 +222,14 @@ ParticleSystem::ParticleSystem()
 , _yCoordFlipped(1)
 , _positionType(PositionType::FREE)
 , _paused(false)
+, _isMultithreadedUpdate(false)
+, _isRandomSeedSet(false)
+, _randomSeed(0)
+, _randomState(0)
+, _fixedTimeStep(0)
+, _timeStepAccumulator(0)
+, _bake(nullptr)
+, _bakeTime(0)
 {
     modeA.gravity.setZero();
     modeA.speed = 0;
@@ -588,13 +598,14 @@ ParticleSystem::~ParticleSystem()
     //unscheduleUpdate();
     _particleData.release();
     CC_SAFE_RELEASE(_texture);
+    CC_SAFE_RELEASE(_bake);
 }
 
 void ParticleSystem::addParticles(int count)
 {
     if (_paused)
         return;
-    uint32_t RANDSEED = rand();
+    uint32_t RANDSEED = _isRandomSeedSet ? _randomState : rand();
 
     int start = _particleCount;
     _particleCount += count;
@@ -780,6 +791,11 @@ dc[i] = (dc[i] - c[i]) / _particleData.timeToLive[i];\
             }
         }
     }
+
+    if (_isRandomSeedSet)
+    {
+        _randomState = RANDSEED;
+    }
 }
 
 void ParticleSystem::onEnter()
@@ -823,6 +839,16 @@ void ParticleSystem::resetSystem()
 {
     _isActive = true;
     _elapsed = 0;
+    _timeStepAccumulator = 0;
+    _randomState = _randomSeed;
+    _bakeTime = 0;
+    if (_isRandomSeedSet && !_batchNode)
+    {
+        _emitCounter = 0;
+        // drop the particles right away, so that the new run matches the previous ones particle for particle
+        _particleCount = 0;
+        return;
+    }
     for (int i = 0; i < _particleCount; ++i)
     {
         _particleData.timeToLive[i] = 0.0f;
@@ -839,6 +865,45 @@ void ParticleSystem::update(float dt)
 {
     CC_PROFILER_START_CATEGORY(kProfilerCategoryParticles , "CCParticleSystem - update");
 
+    if (_bake)
+    {
+        replayBake(dt);
+    }
+    else if (_fixedTimeStep > 0)
+    {
+        // the steps that don't fit in this frame are dropped, the simulation slows down instead of spiraling
+        _timeStepAccumulator += dt;
+        int steps = 0;
+        while (_timeStepAccumulator >= _fixedTimeStep && steps < MAX_FIXED_STEPS_PER_UPDATE)
+        {
+            _timeStepAccumulator -= _fixedTimeStep;
+            ++steps;
+            if (!simulate(_fixedTimeStep))
+                return;
+        }
+        _timeStepAccumulator = MIN(_timeStepAccumulator, _fixedTimeStep);
+    }
+    else if (!simulate(dt))
+    {
+        return;
+    }
+
+    updateParticleQuads();
+    _transformSystemDirty = false;
+
+    // only update gl buffer when visible
+    if (_visible && ! _batchNode)
+    {
+        postStep();
+    }
+
+    CC_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles , "CCParticleSystem - update");
+}
+
+const float ParticleSystem::DEFAULT_PREWARM_TIME_STEP = 1.0f / 60;
+
+bool ParticleSystem::simulate(float dt)
+{
     if (_isActive && _emissionRate)
     {
         float rate = 1.0f / _emissionRate;
@@ -863,151 +928,362 @@ void ParticleSystem::update(float dt)
         }
     }
 
+    for (int i = 0; i < _particleCount; ++i)
     {
-        for (int i = 0; i < _particleCount; ++i)
-        {
-            _particleData.timeToLive[i] -= dt;
-        }
+        _particleData.timeToLive[i] -= dt;
+    }
 
-        for (int i = 0; i < _particleCount; ++i)
+    for (int i = 0; i < _particleCount; ++i)
+    {
+        if (_particleData.timeToLive[i] <= 0.0f)
         {
-            if (_particleData.timeToLive[i] <= 0.0f)
+            int j = _particleCount - 1;
+            while (j > 0 && _particleData.timeToLive[j] <= 0)
             {
-                int j = _particleCount - 1;
-                while (j > 0 && _particleData.timeToLive[j] <= 0)
-                {
-                    _particleCount--;
-                    j--;
-                }
-                _particleData.copyParticle(i, _particleCount - 1);
-                if (_batchNode)
-                {
-                    //disable the switched particle
-                    int currentIndex = _particleData.atlasIndex[i];
-                    _batchNode->disableParticle(_atlasIndex + currentIndex);
-                    //switch indexes
-                    _particleData.atlasIndex[_particleCount - 1] = currentIndex;
-                }
-                --_particleCount;
-                if( _particleCount == 0 && _isAutoRemoveOnFinish )
-                {
-                    this->unscheduleUpdate();
-                    _parent->removeChild(this, true);
-                    return;
-                }
+                _particleCount--;
+                j--;
+            }
+            _particleData.copyParticle(i, _particleCount - 1);
+            if (_batchNode)
+            {
+                //disable the switched particle
+                int currentIndex = _particleData.atlasIndex[i];
+                _batchNode->disableParticle(_atlasIndex + currentIndex);
+                //switch indexes
+                _particleData.atlasIndex[_particleCount - 1] = currentIndex;
+            }
+            --_particleCount;
+            if( _particleCount == 0 && _isAutoRemoveOnFinish )
+            {
+                this->unscheduleUpdate();
+                _parent->removeChild(this, true);
+                return false;
             }
         }
+    }
+
+    forEachParticleRange([this, dt](ssize_t begin, ssize_t end) {
+        updateParticles((int)begin, (int)end, dt);
+    });
+
+    return true;
+}
+
+void ParticleSystem::setRandomSeed(unsigned int seed)
+{
+    _isRandomSeedSet = true;
+    _randomSeed = seed;
+    _randomState = seed;
+}
+
+void ParticleSystem::setFixedTimeStep(float step)
+{
+    _fixedTimeStep = MAX(0, step);
+    _timeStepAccumulator = 0;
+}
+
+void ParticleSystem::prewarm(float duration)
+{
+    CCASSERT(!_bake, "Can't prewarm a system replaying a bake");
+
+    // the system mustn't remove itself while it is being prewarmed
+    bool isAutoRemoveOnFinish = _isAutoRemoveOnFinish;
+    _isAutoRemoveOnFinish = false;
 
-        if (_emitterMode == Mode::GRAVITY)
+    const float step = _fixedTimeStep > 0 ? _fixedTimeStep : DEFAULT_PREWARM_TIME_STEP;
+    for (float time = 0; time < duration; time += step)
+    {
+        simulate(step);
+    }
+
+    _isAutoRemoveOnFinish = isAutoRemoveOnFinish;
+    _transformSystemDirty = true;
+}
+
+ParticleBake* ParticleSystem::bake(float duration, float frameRate)
+{
+    CCASSERT(!_bake, "Can't bake a system replaying a bake");
+    CCASSERT(frameRate > 0, "Invalid frame rate");
+
+    ParticleBake* bake = new (std::nothrow) ParticleBake();
+    if (!bake)
+        return nullptr;
+    bake->_frameRate = frameRate;
+
+    bool isAutoRemoveOnFinish = _isAutoRemoveOnFinish;
+    _isAutoRemoveOnFinish = false;
+
+    const float step = 1.0f / frameRate;
+    const int frameCount = MAX(1, (int)(duration * frameRate + 0.5f));
+    bake->_frameOffsets.reserve(frameCount + 1);
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        simulate(step);
+
+        bake->_frameOffsets.push_back((int)bake->_particles.size());
+        for (int i = 0; i < _particleCount; ++i)
         {
-            for (int i = 0 ; i < _particleCount; ++i)
-            {
-                particle_point tmp, radial = {0.0f, 0.0f}, tangential;
+            ParticleBake::Particle particle;
+            particle.x = _particleData.posx[i];
+            particle.y = _particleData.posy[i];
+            particle.size = _particleData.size[i];
+            particle.rotation = _particleData.rotation[i];
+            particle.color.set(clampf(_particleData.colorR[i], 0, 1) * 255,
+                               clampf(_particleData.colorG[i], 0, 1) * 255,
+                               clampf(_particleData.colorB[i], 0, 1) * 255,
+                               clampf(_particleData.colorA[i], 0, 1) * 255);
+            bake->_particles.push_back(particle);
+        }
+    }
+    bake->_frameOffsets.push_back((int)bake->_particles.size());
+    bake->_particles.shrink_to_fit();
 
-                // radial acceleration
-                if (_particleData.posx[i] || _particleData.posy[i])
-                {
-                    nomalize_point(_particleData.posx[i], _particleData.posy[i], &radial);
-                }
-                tangential = radial;
-                radial.x *= _particleData.modeA.radialAccel[i];
-                radial.y *= _particleData.modeA.radialAccel[i];
+    _isAutoRemoveOnFinish = isAutoRemoveOnFinish;
+    _transformSystemDirty = true;
 
-                // tangential acceleration
-                std::swap(tangential.x, tangential.y);
-                tangential.x *= - _particleData.modeA.tangentialAccel[i];
-                tangential.y *= _particleData.modeA.tangentialAccel[i];
-
-                // (gravity + radial + tangential) * dt
-                tmp.x = radial.x + tangential.x + modeA.gravity.x;
-                tmp.y = radial.y + tangential.y + modeA.gravity.y;
-                tmp.x *= dt;
-                tmp.y *= dt;
-
-                _particleData.modeA.dirX[i] += tmp.x;
-                _particleData.modeA.dirY[i] += tmp.y;
-
-                // this is cocos2d-x v3.0
-                // if (_configName.length()>0 && _yCoordFlipped != -1)
-
-                // this is cocos2d-x v3.0
-                tmp.x = _particleData.modeA.dirX[i] * dt * _yCoordFlipped;
-                tmp.y = _particleData.modeA.dirY[i] * dt * _yCoordFlipped;
-                _particleData.posx[i] += tmp.x;
-                _particleData.posy[i] += tmp.y;
-            }
+    bake->autorelease();
+    return bake;
+}
+
+void ParticleSystem::setBake(ParticleBake* bake)
+{
+    CCASSERT(!_batchNode, "Can't replay a bake in a ParticleBatchNode");
+    if (_bake != bake)
+    {
+        CC_SAFE_RETAIN(bake);
+        CC_SAFE_RELEASE(_bake);
+        _bake = bake;
+    }
+    _bakeTime = 0;
+    if (!_bake)
+    {
+        _particleCount = 0;
+    }
+}
+
+void ParticleSystem::replayBake(float dt)
+{
+    _bakeTime += dt;
+    const int frameCount = _bake->getFrameCount();
+    if (frameCount == 0)
+    {
+        _particleCount = 0;
+        return;
+    }
+
+    // baked effects loop, like ambient effects; wrapping keeps the time precise on long runs
+    _bakeTime = fmodf(_bakeTime, _bake->getDuration());
+    int frame = (int)(_bakeTime * _bake->getFrameRate()) % frameCount;
+    int count = 0;
+    const ParticleBake::Particle* particles = _bake->getFrame(frame, &count);
+    count = MIN(count, _totalParticles);
+
+    const float toFloat = 1.0f / 255;
+    for (int i = 0; i < count; ++i)
+    {
+        const ParticleBake::Particle& particle = particles[i];
+        _particleData.posx[i] = particle.x;
+        _particleData.posy[i] = particle.y;
+        _particleData.size[i] = particle.size;
+        _particleData.rotation[i] = particle.rotation;
+        _particleData.colorR[i] = particle.color.r * toFloat;
+        _particleData.colorG[i] = particle.color.g * toFloat;
+        _particleData.colorB[i] = particle.color.b * toFloat;
+        _particleData.colorA[i] = particle.color.a * toFloat;
+    }
+    _particleCount = count;
+}
+
+// values[i] += deltas[i] * dt
+static void integrate(float* values, const float* deltas, int begin, int end, float dt)
+{
+    int i = begin;
+#if CC_SIMD_ENABLED
+    const simd4::Float dt4 = simd4::set(dt);
+    for (; i + 4 <= end; i += 4)
+    {
+        simd4::store(values + i, simd4::add(simd4::load(values + i), simd4::mul(simd4::load(deltas + i), dt4)));
+    }
+#endif
+    for (; i < end; ++i)
+    {
+        values[i] += deltas[i] * dt;
+    }
+}
+
+void ParticleSystem::updateParticles(int begin, int end, float dt)
+{
+    if (_emitterMode == Mode::GRAVITY)
+    {
+        float* posx = _particleData.posx;
+        float* posy = _particleData.posy;
+        float* dirX = _particleData.modeA.dirX;
+        float* dirY = _particleData.modeA.dirY;
+        const float* radialAccel = _particleData.modeA.radialAccel;
+        const float* tangentialAccel = _particleData.modeA.tangentialAccel;
+
+        int i = begin;
+#if CC_SIMD_ENABLED
+        const simd4::Float zero = simd4::set(0.0f);
+        const simd4::Float one = simd4::set(1.0f);
+        const simd4::Float gravityX = simd4::set(modeA.gravity.x);
+        const simd4::Float gravityY = simd4::set(modeA.gravity.y);
+        const simd4::Float dt4 = simd4::set(dt);
+        const simd4::Float flip = simd4::set((float)_yCoordFlipped);
+        for (; i + 4 <= end; i += 4)
+        {
+            simd4::Float x = simd4::load(posx + i);
+            simd4::Float y = simd4::load(posy + i);
+
+            // radial acceleration, the direction is left null when nomalize_point() leaves it untouched
+            simd4::Float n = simd4::add(simd4::mul(x, x), simd4::mul(y, y));
+            simd4::Mask untouched = simd4::maskOr(simd4::equal(n, one), simd4::equal(n, zero));
+            simd4::Float invLength = simd4::invSqrt(simd4::select(untouched, one, n));
+            simd4::Float radialX = simd4::select(untouched, zero, simd4::mul(x, invLength));
+            simd4::Float radialY = simd4::select(untouched, zero, simd4::mul(y, invLength));
+
+            // tangential acceleration
+            simd4::Float tangential = simd4::load(tangentialAccel + i);
+            simd4::Float tangentialX = simd4::mul(radialY, simd4::neg(tangential));
+            simd4::Float tangentialY = simd4::mul(radialX, tangential);
+
+            simd4::Float radial = simd4::load(radialAccel + i);
+            radialX = simd4::mul(radialX, radial);
+            radialY = simd4::mul(radialY, radial);
+
+            // (gravity + radial + tangential) * dt
+            simd4::Float tmpX = simd4::mul(simd4::add(simd4::add(radialX, tangentialX), gravityX), dt4);
+            simd4::Float tmpY = simd4::mul(simd4::add(simd4::add(radialY, tangentialY), gravityY), dt4);
+
+            simd4::Float dx = simd4::add(simd4::load(dirX + i), tmpX);
+            simd4::Float dy = simd4::add(simd4::load(dirY + i), tmpY);
+            simd4::store(dirX + i, dx);
+            simd4::store(dirY + i, dy);
+
+            simd4::store(posx + i, simd4::add(x, simd4::mul(simd4::mul(dx, dt4), flip)));
+            simd4::store(posy + i, simd4::add(y, simd4::mul(simd4::mul(dy, dt4), flip)));
         }
-        else
+#endif
+        for (; i < end; ++i)
         {
-            //Why use so many for-loop separately instead of putting them together?
-            //When the processor needs to read from or write to a location in memory,
-            //it first checks whether a copy of that data is in the cache.
-            //And every property's memory of the particle system is continuous,
-            //for the purpose of improving cache hit rate, we should process only one property in one for-loop AFAP.
-            //It was proved to be effective especially for low-end machine. 
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.modeB.angle[i] += _particleData.modeB.degreesPerSecond[i] * dt;
-            }
+            particle_point tmp, radial = {0.0f, 0.0f}, tangential;
 
-            for (int i = 0; i < _particleCount; ++i)
+            // radial acceleration
+            if (posx[i] || posy[i])
             {
-                _particleData.modeB.radius[i] += _particleData.modeB.deltaRadius[i] * dt;
-            }
-
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.posx[i] = - cosf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i];
-            }
-            for (int i = 0; i < _particleCount; ++i)
-            {
-                _particleData.posy[i] = - sinf(_particleData.modeB.angle[i]) * _particleData.modeB.radius[i] * _yCoordFlipped;
+                nomalize_point(posx[i], posy[i], &radial);
             }
+            tangential = radial;
+            radial.x *= radialAccel[i];
+            radial.y *= radialAccel[i];
+
+            // tangential acceleration
+            std::swap(tangential.x, tangential.y);
+            tangential.x *= - tangentialAccel[i];
+            tangential.y *= tangentialAccel[i];
+
+            // (gravity + radial + tangential) * dt
+            tmp.x = radial.x + tangential.x + modeA.gravity.x;
+            tmp.y = radial.y + tangential.y + modeA.gravity.y;
+            tmp.x *= dt;
+            tmp.y *= dt;
+
+            dirX[i] += tmp.x;
+            dirY[i] += tmp.y;
+
+            // this is cocos2d-x v3.0
+            // if (_configName.length()>0 && _yCoordFlipped != -1)
+
+            // this is cocos2d-x v3.0
+            tmp.x = dirX[i] * dt * _yCoordFlipped;
+            tmp.y = dirY[i] * dt * _yCoordFlipped;
+            posx[i] += tmp.x;
+            posy[i] += tmp.y;
         }
-
-        //color r,g,b,a
-        for (int i = 0 ; i < _particleCount; ++i)
+    }
+    else
+    {
+        //Why use so many for-loop separately instead of putting them together?
+        //When the processor needs to read from or write to a location in memory,
+        //it first checks whether a copy of that data is in the cache.
+        //And every property's memory of the particle system is continuous,
+        //for the purpose of improving cache hit rate, we should process only one property in one for-loop AFAP.
+        //It was proved to be effective especially for low-end machine. 
+        integrate(_particleData.modeB.angle, _particleData.modeB.degreesPerSecond, begin, end, dt);
+        integrate(_particleData.modeB.radius, _particleData.modeB.deltaRadius, begin, end, dt);
+
+        const float* angle = _particleData.modeB.angle;
+        const float* radius = _particleData.modeB.radius;
+        float* posx = _particleData.posx;
+        float* posy = _particleData.posy;
+
+        int i = begin;
+#if CC_SIMD_ENABLED
+        const simd4::Float flip = simd4::set((float)_yCoordFlipped);
+        for (; i + 4 <= end; i += 4)
         {
-            _particleData.colorR[i] += _particleData.deltaColorR[i] * dt;
+            simd4::Float sine, cosine;
+            simd4::sinCos(simd4::load(angle + i), &sine, &cosine);
+            simd4::Float r = simd4::load(radius + i);
+            simd4::store(posx + i, simd4::mul(simd4::neg(cosine), r));
+            simd4::store(posy + i, simd4::mul(simd4::mul(simd4::neg(sine), r), flip));
         }
-
-        for (int i = 0 ; i < _particleCount; ++i)
+#endif
+        for (int j = i; j < end; ++j)
         {
-            _particleData.colorG[i] += _particleData.deltaColorG[i] * dt;
+            posx[j] = - cosf(angle[j]) * radius[j];
         }
-
-        for (int i = 0 ; i < _particleCount; ++i)
+        for (int j = i; j < end; ++j)
         {
-            _particleData.colorB[i] += _particleData.deltaColorB[i] * dt;
+            posy[j] = - sinf(angle[j]) * radius[j] * _yCoordFlipped;
         }
+    }
 
-        for (int i = 0 ; i < _particleCount; ++i)
-        {
-            _particleData.colorA[i] += _particleData.deltaColorA[i] * dt;
-        }
-        //size
-        for (int i = 0 ; i < _particleCount; ++i)
+    //color r,g,b,a
+    integrate(_particleData.colorR, _particleData.deltaColorR, begin, end, dt);
+    integrate(_particleData.colorG, _particleData.deltaColorG, begin, end, dt);
+    integrate(_particleData.colorB, _particleData.deltaColorB, begin, end, dt);
+    integrate(_particleData.colorA, _particleData.deltaColorA, begin, end, dt);
+
+    //size
+    {
+        float* size = _particleData.size;
+        const float* deltaSize = _particleData.deltaSize;
+
+        int i = begin;
+#if CC_SIMD_ENABLED
+        const simd4::Float zero = simd4::set(0.0f);
+        const simd4::Float dt4 = simd4::set(dt);
+        for (; i + 4 <= end; i += 4)
         {
-            _particleData.size[i] += (_particleData.deltaSize[i] * dt);
-            _particleData.size[i] = MAX(0, _particleData.size[i]);
+            simd4::Float s = simd4::add(simd4::load(size + i), simd4::mul(simd4::load(deltaSize + i), dt4));
+            simd4::store(size + i, simd4::max(s, zero));
         }
-        //angle
-        for (int i = 0 ; i < _particleCount; ++i)
+#endif
+        for (; i < end; ++i)
         {
-            _particleData.rotation[i] += _particleData.deltaRotation[i] * dt;
+            size[i] += (deltaSize[i] * dt);
+            size[i] = MAX(0, size[i]);
         }
-
-        updateParticleQuads();
-        _transformSystemDirty = false;
     }
 
-    // only update gl buffer when visible
-    if (_visible && ! _batchNode)
+    //angle
+    integrate(_particleData.rotation, _particleData.deltaRotation, begin, end, dt);
+}
+
+void ParticleSystem::forEachParticleRange(const std::function<void(ssize_t begin, ssize_t end)>& func)
+{
+    // a range per core is enough, the particles all cost the same
+    static const ssize_t MIN_RANGE_SIZE = 2048;
+
+    if (_isMultithreadedUpdate && _particleCount >= MULTITHREADED_UPDATE_MIN_PARTICLES)
     {
-        postStep();
+        WorkerPool::getInstance()->parallelFor(_particleCount, MIN_RANGE_SIZE, func);
+    }
+    else if (_particleCount > 0)
+    {
+        func(0, _particleCount);
     }
-
-    CC_PROFILER_STOP_CATEGORY(kProfilerCategoryParticles , "CCParticleSystem - update");
 }
 
 void ParticleSystem::updateWithNoTime(void)
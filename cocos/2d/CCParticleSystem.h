@@ -143,6 +143,52 @@ public:
 
 class Texture2D;
 
+/** @class ParticleBake
+ * @brief The frames of a particle system simulated ahead of time by ParticleSystem::bake(),
+ * which can be replayed by any particle system with ParticleSystem::setBake().
+ *
+ * Each frame stores the position, size, rotation and color of the living particles.
+ * The positions are relative to the emitter: replayed particles follow it, like PositionType::GROUPED.
+ * @js NA
+ */
+class CC_DLL ParticleBake : public Ref
+{
+public:
+    struct Particle
+    {
+        float x;
+        float y;
+        float size;
+        float rotation;
+        Color4B color;
+    };
+
+    /** Returns the number of frames. */
+    int getFrameCount() const { return _frameOffsets.empty() ? 0 : (int)_frameOffsets.size() - 1; }
+    /** Returns the number of frames per second. */
+    float getFrameRate() const { return _frameRate; }
+    /** Returns the duration of the bake, in seconds. */
+    float getDuration() const { return getFrameCount() / _frameRate; }
+
+    /** Returns the particles of a frame, and their number in `count`. */
+    const Particle* getFrame(int index, int* count) const
+    {
+        *count = _frameOffsets[index + 1] - _frameOffsets[index];
+        return _particles.data() + _frameOffsets[index];
+    }
+
+CC_CONSTRUCTOR_ACCESS:
+    ParticleBake() : _frameRate(30.0f) {}
+
+protected:
+    friend class ParticleSystem;
+
+    float _frameRate;
+    std::vector<Particle> _particles;
+    // where each frame starts in _particles, followed by the total number of particles
+    std::vector<int> _frameOffsets;
+};
+
 /** @class ParticleSystem
  * @brief Particle System base class.
 Attributes of a Particle System:
@@ -233,6 +279,13 @@ public:
         START_RADIUS_EQUAL_TO_END_RADIUS = -1,
     };
 
+    /** The minimum number of particles before a multithreaded update splits the system across the worker threads. */
+    static const int MULTITHREADED_UPDATE_MIN_PARTICLES = 8192;
+    /** The time step of prewarm() when the system has no fixed time step. */
+    static const float DEFAULT_PREWARM_TIME_STEP;
+    /** The maximum number of fixed time steps simulated by an update, the remaining time is dropped. */
+    static const int MAX_FIXED_STEPS_PER_UPDATE = 8;
+
     /** Creates an initializes a ParticleSystem from a plist file.
     This plist files can be created manually or with Particle Designer:
     http://particledesigner.71squared.com/
@@ -271,6 +324,57 @@ public:
      should be overridden by subclasses. */
     virtual void postStep();
 
+    /**
+     * Enable/Disable splitting the update of big systems across the worker threads.
+     * When enabled, the particles and the quads of systems with at least MULTITHREADED_UPDATE_MIN_PARTICLES
+     * particles are updated by `WorkerPool`. Disabled by default.
+     */
+    void setMultithreadedUpdateEnabled(bool enabled) { _isMultithreadedUpdate = enabled; }
+    /** Returns whether the update of big systems is split across the worker threads. */
+    bool isMultithreadedUpdateEnabled() const { return _isMultithreadedUpdate; }
+
+    /**
+     * Seeds the random numbers of the system, instead of drawing them from rand().
+     * Together with a fixed time step, two runs of a seeded system are identical.
+     * resetSystem() restarts the sequence from the seed.
+     */
+    void setRandomSeed(unsigned int seed);
+    /** Returns the seed of the random numbers, only meaningful when isRandomSeedSet() returns true. */
+    unsigned int getRandomSeed() const { return _randomSeed; }
+    /** Returns whether the random numbers of the system are seeded. */
+    bool isRandomSeedSet() const { return _isRandomSeedSet; }
+
+    /**
+     * Sets the fixed time step of the simulation, in seconds.
+     * The frame time is accumulated and the system is simulated with steps of exactly `step` seconds,
+     * at most MAX_FIXED_STEPS_PER_UPDATE per frame. 0, the default, simulates with the frame time.
+     */
+    void setFixedTimeStep(float step);
+    /** Returns the fixed time step of the simulation, 0 when the frame time is used. */
+    float getFixedTimeStep() const { return _fixedTimeStep; }
+
+    /**
+     * Simulates the system `duration` seconds ahead, e.g. so that an ambient effect is already running
+     * when it is shown. The fixed time step is used, or DEFAULT_PREWARM_TIME_STEP.
+     */
+    void prewarm(float duration);
+
+    /**
+     * Simulates the system `duration` seconds ahead and records a frame every 1 / `frameRate` seconds.
+     * The system is left in the state of the last frame, use resetSystem() to start it over.
+     *
+     * @return An autoreleased ParticleBake, to be replayed with setBake().
+     */
+    ParticleBake* bake(float duration, float frameRate = 30.0f);
+
+    /**
+     * Replays a bake in a loop instead of simulating the system, nullptr goes back to the simulation.
+     * The system must have room for the particles of the bake, and can't be in a ParticleBatchNode.
+     */
+    void setBake(ParticleBake* bake);
+    /** Returns the bake being replayed. */
+    ParticleBake* getBake() const { return _bake; }
+
     /** Call the update method with no time..
      */
     virtual void updateWithNoTime();
@@ -815,6 +919,19 @@ CC_CONSTRUCTOR_ACCESS:
 protected:
     virtual void updateBlendFunc();
 
+    /** Emits, expires and moves the particles, returns false when the system removed itself. */
+    bool simulate(float dt);
+    /** Sets the particles from the frame of the bake at the current time. */
+    void replayBake(float dt);
+
+    /** Moves the living particles in [begin, end) and updates their color, size and rotation.
+     It may be called concurrently on disjoint ranges. */
+    void updateParticles(int begin, int end, float dt);
+
+    /** Calls `func` on ranges covering the living particles, on the worker threads when the
+     update is multithreaded and the system is big enough. */
+    void forEachParticleRange(const std::function<void(ssize_t begin, ssize_t end)>& func);
+
     /** whether or not the particles are using blend additive.
      If enabled, the following blending function will be used.
      @code
@@ -970,6 +1087,22 @@ protected:
     /** is the emitter paused */
     bool _paused;
 
+    /** whether the update of big systems is split across the worker threads */
+    bool _isMultithreadedUpdate;
+
+    /** seeded random numbers */
+    bool _isRandomSeedSet;
+    uint32_t _randomSeed;
+    uint32_t _randomState;
+
+    /** fixed time step, 0 when the frame time is used */
+    float _fixedTimeStep;
+    float _timeStepAccumulator;
+
+    /** the bake being replayed */
+    ParticleBake* _bake;
+    float _bakeTime;
+
 private:
     CC_DISALLOW_COPY_AND_ASSIGN(ParticleSystem);
 };
@@ -42,6 +42,7 @@ THE SOFTWARE.
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventDispatcher.h"
 #include "base/ccUTF8.h"
+#include "math/CCSIMD.h"
 
 NS_CC_BEGIN
 
@@ -303,18 +304,61 @@ inline void updatePosWithParticle(V3F_C4B_T2F_Quad *quad, const Vec2& newPositio
     quad->tr.vertices.y = cy;
 }
 
+#if CC_SIMD_ENABLED
+// updatePosWithParticle() for 4 particles
+static void updatePosWithParticles(V3F_C4B_T2F_Quad* quads, simd4::Float x, simd4::Float y, const float* size, const float* rotation)
+{
+    const simd4::Float half = simd4::set(0.5f);
+    simd4::Float size_2 = simd4::mul(simd4::load(size), half);
+    simd4::Float x1 = simd4::neg(size_2);
+    simd4::Float y1 = x1;
+    simd4::Float x2 = size_2;
+    simd4::Float y2 = size_2;
+
+    simd4::Float r = simd4::neg(simd4::mul(simd4::load(rotation), simd4::set(0.01745329252f)));
+    simd4::Float sr, cr;
+    simd4::sinCos(r, &sr, &cr);
+
+    float ax[4], ay[4], bx[4], by[4], cx[4], cy[4], dx[4], dy[4];
+    simd4::store(ax, simd4::add(simd4::sub(simd4::mul(x1, cr), simd4::mul(y1, sr)), x));
+    simd4::store(ay, simd4::add(simd4::add(simd4::mul(x1, sr), simd4::mul(y1, cr)), y));
+    simd4::store(bx, simd4::add(simd4::sub(simd4::mul(x2, cr), simd4::mul(y1, sr)), x));
+    simd4::store(by, simd4::add(simd4::add(simd4::mul(x2, sr), simd4::mul(y1, cr)), y));
+    simd4::store(cx, simd4::add(simd4::sub(simd4::mul(x2, cr), simd4::mul(y2, sr)), x));
+    simd4::store(cy, simd4::add(simd4::add(simd4::mul(x2, sr), simd4::mul(y2, cr)), y));
+    simd4::store(dx, simd4::add(simd4::sub(simd4::mul(x1, cr), simd4::mul(y2, sr)), x));
+    simd4::store(dy, simd4::add(simd4::add(simd4::mul(x1, sr), simd4::mul(y2, cr)), y));
+
+    for (int k = 0; k < 4; ++k)
+    {
+        V3F_C4B_T2F_Quad* quad = quads + k;
+        quad->bl.vertices.x = ax[k];
+        quad->bl.vertices.y = ay[k];
+        quad->br.vertices.x = bx[k];
+        quad->br.vertices.y = by[k];
+        quad->tl.vertices.x = dx[k];
+        quad->tl.vertices.y = dy[k];
+        quad->tr.vertices.x = cx[k];
+        quad->tr.vertices.y = cy[k];
+    }
+}
+#endif
+
 void ParticleSystemQuad::updateParticleQuads()
 {
     if (_particleCount <= 0) {
         return;
     }
 
+    // the particles of a bake are relative to the emitter, and have no start position
+    const PositionType positionType = _bake ? PositionType::GROUPED : _positionType;
+
     Vec2 currentPosition;
-    if (_positionType == PositionType::FREE)
+    if (positionType == PositionType::FREE)
     {
         currentPosition = this->convertToWorldSpace(Vec2::ZERO);
     }
-    else if (_positionType == PositionType::RELATIVE)
+    else if (positionType == PositionType::RELATIVE)
     {
         currentPosition = _position;
     }
@@ -332,107 +376,141 @@ void ParticleSystemQuad::updateParticleQuads()
         startQuad = &(_quads[0]);
     }
 
-    if( _positionType == PositionType::FREE )
+    Vec3 p1(currentPosition.x, currentPosition.y, 0);
+    Mat4 worldToNodeTM;
+    if( positionType == PositionType::FREE )
     {
-        Vec3 p1(currentPosition.x, currentPosition.y, 0);
-        Mat4 worldToNodeTM = getWorldToNodeTransform();
+        worldToNodeTM = getWorldToNodeTransform();
         worldToNodeTM.transformPoint(&p1);
-        Vec3 p2;
+    }
+
+    forEachParticleRange([&](ssize_t begin, ssize_t end) {
+        updateQuadsInRange((int)begin, (int)end, positionType, startQuad, pos, currentPosition, p1, worldToNodeTM);
+    });
+}
+
+void ParticleSystemQuad::updateQuadsInRange(int begin, int end, PositionType positionType, V3F_C4B_T2F_Quad* startQuad, const Vec2& pos,
+                                            const Vec2& currentPosition, const Vec3& p1, const Mat4& worldToNodeTM)
+{
+    const float* startX = _particleData.startPosX;
+    const float* startY = _particleData.startPosY;
+    const float* x = _particleData.posx;
+    const float* y = _particleData.posy;
+    const float* s = _particleData.size;
+    const float* r = _particleData.rotation;
+
+    int i = begin;
+#if CC_SIMD_ENABLED
+    const float* m = worldToNodeTM.m;
+    for (; i + 4 <= end; i += 4)
+    {
+        simd4::Float newX = simd4::load(x + i);
+        simd4::Float newY = simd4::load(y + i);
+        if( positionType == PositionType::FREE )
+        {
+            // p2 = p1 - worldToNodeTM * start
+            simd4::Float sx = simd4::load(startX + i);
+            simd4::Float sy = simd4::load(startY + i);
+            simd4::Float p2x = simd4::add(simd4::add(simd4::mul(simd4::set(m[0]), sx), simd4::mul(simd4::set(m[4]), sy)), simd4::set(m[12]));
+            simd4::Float p2y = simd4::add(simd4::add(simd4::mul(simd4::set(m[1]), sx), simd4::mul(simd4::set(m[5]), sy)), simd4::set(m[13]));
+            p2x = simd4::sub(simd4::set(p1.x), p2x);
+            p2y = simd4::sub(simd4::set(p1.y), p2y);
+            newX = simd4::sub(newX, simd4::sub(p2x, simd4::set(pos.x)));
+            newY = simd4::sub(newY, simd4::sub(p2y, simd4::set(pos.y)));
+        }
+        else if( positionType == PositionType::RELATIVE )
+        {
+            newX = simd4::add(simd4::sub(newX, simd4::sub(simd4::set(currentPosition.x), simd4::load(startX + i))), simd4::set(pos.x));
+            newY = simd4::add(simd4::sub(newY, simd4::sub(simd4::set(currentPosition.y), simd4::load(startY + i))), simd4::set(pos.y));
+        }
+        else
+        {
+            newX = simd4::add(newX, simd4::set(pos.x));
+            newY = simd4::add(newY, simd4::set(pos.y));
+        }
+        updatePosWithParticles(startQuad + i, newX, newY, s + i, r + i);
+    }
+#endif
+    for (; i < end; ++i)
+    {
         Vec2 newPos;
-        float* startX = _particleData.startPosX;
-        float* startY = _particleData.startPosY;
-        float* x = _particleData.posx;
-        float* y = _particleData.posy;
-        float* s = _particleData.size;
-        float* r = _particleData.rotation;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        for (int i = 0 ; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r)
+        if( positionType == PositionType::FREE )
         {
-            p2.set(*startX, *startY, 0);
+            Vec3 p2(startX[i], startY[i], 0);
             worldToNodeTM.transformPoint(&p2);
-            newPos.set(*x,*y);
+            newPos.set(x[i], y[i]);
             p2 = p1 - p2;
             newPos.x -= p2.x - pos.x;
             newPos.y -= p2.y - pos.y;
-            updatePosWithParticle(quadStart, newPos, *s, *r);
         }
-    }
-    else if( _positionType == PositionType::RELATIVE )
-    {
-        Vec2 newPos;
-        float* startX = _particleData.startPosX;
-        float* startY = _particleData.startPosY;
-        float* x = _particleData.posx;
-        float* y = _particleData.posy;
-        float* s = _particleData.size;
-        float* r = _particleData.rotation;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        for (int i = 0 ; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r)
+        else if( positionType == PositionType::RELATIVE )
         {
-            newPos.set(*x, *y);
-            newPos.x = *x - (currentPosition.x - *startX);
-            newPos.y = *y - (currentPosition.y - *startY);
+            newPos.x = x[i] - (currentPosition.x - startX[i]);
+            newPos.y = y[i] - (currentPosition.y - startY[i]);
             newPos += pos;
-            updatePosWithParticle(quadStart, newPos, *s, *r);
         }
-    }
-    else
-    {
-        Vec2 newPos;
-        float* startX = _particleData.startPosX;
-        float* startY = _particleData.startPosY;
-        float* x = _particleData.posx;
-        float* y = _particleData.posy;
-        float* s = _particleData.size;
-        float* r = _particleData.rotation;
-        V3F_C4B_T2F_Quad* quadStart = startQuad;
-        for (int i = 0 ; i < _particleCount; ++i, ++startX, ++startY, ++x, ++y, ++quadStart, ++s, ++r)
+        else
         {
-            newPos.set(*x + pos.x, *y + pos.y);
-            updatePosWithParticle(quadStart, newPos, *s, *r);
+            newPos.set(x[i] + pos.x, y[i] + pos.y);
         }
+        updatePosWithParticle(startQuad + i, newPos, s[i], r[i]);
     }
 
     //set color
-    if(_opacityModifyRGB)
+    const float* cr = _particleData.colorR;
+    const float* cg = _particleData.colorG;
+    const float* cb = _particleData.colorB;
+    const float* ca = _particleData.colorA;
+
+    i = begin;
+#if CC_SIMD_ENABLED
+    const simd4::Float full = simd4::set(255.0f);
+    for (; i + 4 <= end; i += 4)
     {
-        V3F_C4B_T2F_Quad* quad = startQuad;
-        float* r = _particleData.colorR;
-        float* g = _particleData.colorG;
-        float* b = _particleData.colorB;
-        float* a = _particleData.colorA;
+        simd4::Float a = simd4::load(ca + i);
+        simd4::Float colorR = simd4::load(cr + i);
+        simd4::Float colorG = simd4::load(cg + i);
+        simd4::Float colorB = simd4::load(cb + i);
+        if (_opacityModifyRGB)
+        {
+            colorR = simd4::mul(colorR, a);
+            colorG = simd4::mul(colorG, a);
+            colorB = simd4::mul(colorB, a);
+        }
 
-        for (int i = 0; i < _particleCount; ++i,++quad,++r,++g,++b,++a)
+        unsigned int colors[4];
+        simd4::storeColors(colors, simd4::mul(colorR, full), simd4::mul(colorG, full), simd4::mul(colorB, full), simd4::mul(a, full));
+        for (int k = 0; k < 4; ++k)
         {
-            GLubyte colorR = *r * *a * 255;
-            GLubyte colorG = *g * *a * 255;
-            GLubyte colorB = *b * *a * 255;
-            GLubyte colorA = *a * 255;
-            quad->bl.colors.set(colorR, colorG, colorB, colorA);
-            quad->br.colors.set(colorR, colorG, colorB, colorA);
-            quad->tl.colors.set(colorR, colorG, colorB, colorA);
-            quad->tr.colors.set(colorR, colorG, colorB, colorA);
+            V3F_C4B_T2F_Quad* quad = startQuad + i + k;
+            memcpy(&quad->bl.colors, &colors[k], sizeof(Color4B));
+            memcpy(&quad->br.colors, &colors[k], sizeof(Color4B));
+            memcpy(&quad->tl.colors, &colors[k], sizeof(Color4B));
+            memcpy(&quad->tr.colors, &colors[k], sizeof(Color4B));
         }
     }
-    else
+#endif
+    for (; i < end; ++i)
     {
-        V3F_C4B_T2F_Quad* quad = startQuad;
-        float* r = _particleData.colorR;
-        float* g = _particleData.colorG;
-        float* b = _particleData.colorB;
-        float* a = _particleData.colorA;
-
-        for (int i = 0; i < _particleCount; ++i,++quad,++r,++g,++b,++a)
+        V3F_C4B_T2F_Quad* quad = startQuad + i;
+        GLubyte colorR, colorG, colorB;
+        if (_opacityModifyRGB)
+        {
+            colorR = cr[i] * ca[i] * 255;
+            colorG = cg[i] * ca[i] * 255;
+            colorB = cb[i] * ca[i] * 255;
+        }
+        else
         {
-            GLubyte colorR = *r * 255;
-            GLubyte colorG = *g * 255;
-            GLubyte colorB = *b * 255;
-            GLubyte colorA = *a * 255;
-            quad->bl.colors.set(colorR, colorG, colorB, colorA);
-            quad->br.colors.set(colorR, colorG, colorB, colorA);
-            quad->tl.colors.set(colorR, colorG, colorB, colorA);
-            quad->tr.colors.set(colorR, colorG, colorB, colorA);
+            colorR = cr[i] * 255;
+            colorG = cg[i] * 255;
+            colorB = cb[i] * 255;
         }
+        GLubyte colorA = ca[i] * 255;
+        quad->bl.colors.set(colorR, colorG, colorB, colorA);
+        quad->br.colors.set(colorR, colorG, colorB, colorA);
+        quad->tl.colors.set(colorR, colorG, colorB, colorA);
+        quad->tr.colors.set(colorR, colorG, colorB, colorA);
     }
 }
 
@@ -172,6 +172,11 @@ protected:
     /** Updates texture coords */
     void updateTexCoords();
 
+    /** Updates the vertices and colors of the quads of the particles in [begin, end),
+     it may be called concurrently on disjoint ranges. */
+    void updateQuadsInRange(int begin, int end, PositionType positionType, V3F_C4B_T2F_Quad* startQuad, const Vec2& pos,
+                            const Vec2& currentPosition, const Vec3& p1, const Mat4& worldToNodeTM);
+
     void setupVBOandVAO();
     void setupVBO();
     bool allocMemory();
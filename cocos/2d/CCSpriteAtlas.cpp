@@ -0,0 +1,477 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "2d/CCSpriteAtlas.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <algorithm>
+
+#include "base/ccMacros.h"
+#include "base/CCNS.h"
+#include "platform/CCFileUtils.h"
+
+NS_CC_BEGIN
+
+static const char ATLAS_MAGIC[4] = { 'C', 'A', 'T', 'L' };
+
+// magic, version, frame count, alias count, texture width and height, texture file name, pixel format name,
+// offset and size of the string table, offset and size of the polygons
+static const ssize_t HEADER_SIZE = 12 * 4;
+// name, rect, offset, original size, anchor, flags, polygon
+static const ssize_t FRAME_SIZE = 13 * 4;
+// name, frame index
+static const ssize_t ALIAS_SIZE = 2 * 4;
+
+static uint32_t readUInt32(const unsigned char* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static float readFloat(const unsigned char* p)
+{
+    uint32_t bits = readUInt32(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void readInts(const unsigned char* p, uint32_t count, std::vector<int>& out)
+{
+    out.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        out[i] = (int)readUInt32(p + i * 4);
+    }
+}
+
+static void writeUInt32(std::vector<unsigned char>& out, uint32_t value)
+{
+    out.push_back((unsigned char)(value & 0xff));
+    out.push_back((unsigned char)((value >> 8) & 0xff));
+    out.push_back((unsigned char)((value >> 16) & 0xff));
+    out.push_back((unsigned char)((value >> 24) & 0xff));
+}
+
+static void writeFloat(std::vector<unsigned char>& out, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    writeUInt32(out, bits);
+}
+
+SpriteAtlas::SpriteAtlas()
+: _data(nullptr)
+, _dataLen(0)
+, _frameCount(0)
+, _aliasCount(0)
+, _textureFileName("")
+, _pixelFormatName("")
+, _frames(nullptr)
+, _aliases(nullptr)
+, _strings(nullptr)
+, _stringsSize(0)
+, _polygons(nullptr)
+, _polygonsSize(0)
+{
+}
+
+bool SpriteAtlas::isSpriteAtlas(const unsigned char* data, ssize_t dataLen)
+{
+    return dataLen >= (ssize_t)sizeof(ATLAS_MAGIC) && memcmp(data, ATLAS_MAGIC, sizeof(ATLAS_MAGIC)) == 0;
+}
+
+bool SpriteAtlas::isSpriteAtlasFile(const std::string& filename)
+{
+    static const std::string extension(".catlas");
+    if (filename.size() < extension.size())
+        return false;
+
+    std::string fileExtension = filename.substr(filename.size() - extension.size());
+    std::transform(fileExtension.begin(), fileExtension.end(), fileExtension.begin(), ::tolower);
+    return fileExtension == extension;
+}
+
+bool SpriteAtlas::init(const unsigned char* data, ssize_t dataLen)
+{
+    if (dataLen < HEADER_SIZE || !isSpriteAtlas(data, dataLen))
+    {
+        CCLOG("cocos2d: SpriteAtlas: not a sprite atlas");
+        return false;
+    }
+
+    uint32_t version = readUInt32(data + 4);
+    if (version != VERSION)
+    {
+        CCLOG("cocos2d: SpriteAtlas: unsupported version %u", version);
+        return false;
+    }
+
+    uint32_t frameCount = readUInt32(data + 8);
+    uint32_t aliasCount = readUInt32(data + 12);
+    uint32_t textureFileName = readUInt32(data + 24);
+    uint32_t pixelFormatName = readUInt32(data + 28);
+    uint32_t stringsOffset = readUInt32(data + 32);
+    uint32_t stringsSize = readUInt32(data + 36);
+    uint32_t polygonsOffset = readUInt32(data + 40);
+    uint32_t polygonsSize = readUInt32(data + 44);
+
+    // 64 bit, so that nothing overflows
+    uint64_t tablesEnd = (uint64_t)HEADER_SIZE + (uint64_t)frameCount * FRAME_SIZE + (uint64_t)aliasCount * ALIAS_SIZE;
+    if (tablesEnd > (uint64_t)dataLen
+        || (uint64_t)stringsOffset + stringsSize > (uint64_t)dataLen
+        || (uint64_t)polygonsOffset + polygonsSize > (uint64_t)dataLen)
+    {
+        CCLOG("cocos2d: SpriteAtlas: the tables are out of the data");
+        return false;
+    }
+
+    // every string ends before the end of the table, so any offset in the table is a valid string
+    const char* strings = reinterpret_cast<const char*>(data + stringsOffset);
+    if (stringsSize == 0 || strings[stringsSize - 1] != '\0'
+        || textureFileName >= stringsSize || pixelFormatName >= stringsSize)
+    {
+        CCLOG("cocos2d: SpriteAtlas: invalid string table");
+        return false;
+    }
+
+    const unsigned char* frames = data + HEADER_SIZE;
+    for (uint32_t i = 0; i < frameCount; ++i)
+    {
+        const unsigned char* frame = frames + i * FRAME_SIZE;
+        if (readUInt32(frame) >= stringsSize)
+        {
+            CCLOG("cocos2d: SpriteAtlas: invalid name of frame %u", i);
+            return false;
+        }
+
+        if (readUInt32(frame + 44) & FLAG_POLYGON)
+        {
+            uint64_t polygonOffset = readUInt32(frame + 48);
+            if (polygonOffset + 8 > polygonsSize)
+            {
+                CCLOG("cocos2d: SpriteAtlas: invalid polygon of frame %u", i);
+                return false;
+            }
+
+            const unsigned char* polygon = data + polygonsOffset + polygonOffset;
+            uint64_t valueCount = (uint64_t)readUInt32(polygon) * 2 + readUInt32(polygon + 4);
+            if (polygonOffset + 8 + valueCount * 4 > polygonsSize)
+            {
+                CCLOG("cocos2d: SpriteAtlas: invalid polygon of frame %u", i);
+                return false;
+            }
+        }
+    }
+
+    const unsigned char* aliases = frames + frameCount * FRAME_SIZE;
+    for (uint32_t i = 0; i < aliasCount; ++i)
+    {
+        const unsigned char* alias = aliases + i * ALIAS_SIZE;
+        if (readUInt32(alias) >= stringsSize || readUInt32(alias + 4) >= frameCount)
+        {
+            CCLOG("cocos2d: SpriteAtlas: invalid alias %u", i);
+            return false;
+        }
+    }
+
+    _data = data;
+    _dataLen = dataLen;
+    _frameCount = (int)frameCount;
+    _aliasCount = (int)aliasCount;
+    _textureSize = Size(readFloat(data + 16), readFloat(data + 20));
+    _strings = strings;
+    _stringsSize = stringsSize;
+    _textureFileName = strings + textureFileName;
+    _pixelFormatName = strings + pixelFormatName;
+    _frames = frames;
+    _aliases = aliases;
+    _polygons = data + polygonsOffset;
+    _polygonsSize = polygonsSize;
+    return true;
+}
+
+const char* SpriteAtlas::getFrameName(int index) const
+{
+    CCASSERT(index >= 0 && index < _frameCount, "invalid frame index");
+    return _strings + readUInt32(_frames + index * FRAME_SIZE);
+}
+
+void SpriteAtlas::getFrame(int index, Frame* frame) const
+{
+    CCASSERT(index >= 0 && index < _frameCount, "invalid frame index");
+
+    const unsigned char* p = _frames + index * FRAME_SIZE;
+    uint32_t flags = readUInt32(p + 44);
+
+    frame->name = getFrameName(index);
+    frame->rect.setRect(readFloat(p + 4), readFloat(p + 8), readFloat(p + 12), readFloat(p + 16));
+    frame->rotated = (flags & FLAG_ROTATED) != 0;
+    frame->offset.set(readFloat(p + 20), readFloat(p + 24));
+    frame->originalSize.setSize(readFloat(p + 28), readFloat(p + 32));
+    frame->hasAnchor = (flags & FLAG_ANCHOR) != 0;
+    frame->anchor.set(readFloat(p + 36), readFloat(p + 40));
+
+    if (flags & FLAG_POLYGON)
+    {
+        const unsigned char* polygon = _polygons + readUInt32(p + 48);
+        uint32_t vertexValueCount = readUInt32(polygon);
+        uint32_t indexCount = readUInt32(polygon + 4);
+        readInts(polygon + 8, vertexValueCount, frame->vertices);
+        readInts(polygon + 8 + vertexValueCount * 4, vertexValueCount, frame->verticesUV);
+        readInts(polygon + 8 + vertexValueCount * 8, indexCount, frame->indices);
+    }
+    else
+    {
+        frame->vertices.clear();
+        frame->verticesUV.clear();
+        frame->indices.clear();
+    }
+}
+
+const char* SpriteAtlas::getAlias(int index, int* frameIndex) const
+{
+    CCASSERT(index >= 0 && index < _aliasCount, "invalid alias index");
+
+    const unsigned char* p = _aliases + index * ALIAS_SIZE;
+    if (frameIndex)
+    {
+        *frameIndex = (int)readUInt32(p + 4);
+    }
+    return _strings + readUInt32(p);
+}
+
+// parses a list of space separated integers, see SpriteFrameCache::parseIntegerList()
+static void parseIntegerList(const std::string& string, std::vector<int>& res)
+{
+    res.clear();
+    const char* p = string.c_str();
+    char* end = nullptr;
+    for (long value = strtol(p, &end, 10); end != p; value = strtol(p, &end, 10))
+    {
+        res.push_back((int)value);
+        p = end;
+    }
+}
+
+bool SpriteAtlas::saveToFile(const ValueMap& dictionary, const std::string& fullpath)
+{
+    auto framesIter = dictionary.find("frames");
+    if (framesIter == dictionary.end() || framesIter->second.getType() != Value::Type::MAP)
+    {
+        CCLOG("cocos2d: SpriteAtlas: the dictionary has no frames");
+        return false;
+    }
+    const ValueMap& framesDict = framesIter->second.asValueMap();
+
+    int format = 0;
+    Size textureSize;
+    std::string textureFileName;
+    std::string pixelFormatName;
+
+    auto metadataIter = dictionary.find("metadata");
+    if (metadataIter != dictionary.end() && metadataIter->second.getType() == Value::Type::MAP)
+    {
+        const ValueMap& metadataDict = metadataIter->second.asValueMap();
+        auto iter = metadataDict.find("format");
+        if (iter != metadataDict.end())
+            format = iter->second.asInt();
+        iter = metadataDict.find("size");
+        if (iter != metadataDict.end())
+            textureSize = SizeFromString(iter->second.asString());
+        iter = metadataDict.find("textureFileName");
+        if (iter != metadataDict.end())
+            textureFileName = iter->second.asString();
+        iter = metadataDict.find("pixelFormat");
+        if (iter != metadataDict.end())
+            pixelFormatName = iter->second.asString();
+    }
+
+    if (format < 0 || format > 3)
+    {
+        CCLOG("cocos2d: SpriteAtlas: format %d is not supported", format);
+        return false;
+    }
+
+    // the string table starts with the empty string
+    std::vector<unsigned char> strings(1, 0);
+    auto addString = [&strings](const std::string& string) -> uint32_t
+    {
+        if (string.empty())
+            return 0;
+        uint32_t offset = (uint32_t)strings.size();
+        strings.insert(strings.end(), string.begin(), string.end());
+        strings.push_back(0);
+        return offset;
+    };
+
+    std::vector<unsigned char> frames;
+    std::vector<unsigned char> aliases;
+    std::vector<unsigned char> polygons;
+    uint32_t frameCount = 0;
+    uint32_t aliasCount = 0;
+
+    auto frameValue = [](const ValueMap& frameDict, const std::string& key) -> Value
+    {
+        auto iter = frameDict.find(key);
+        return iter != frameDict.end() ? iter->second : Value::Null;
+    };
+
+    for (const auto& frameIter : framesDict)
+    {
+        if (frameIter.second.getType() != Value::Type::MAP)
+            continue;
+
+        const ValueMap& frameDict = frameIter.second.asValueMap();
+        Rect rect;
+        bool rotated = false;
+        Vec2 offset;
+        Size originalSize;
+        bool hasAnchor = false;
+        Vec2 anchor;
+        std::vector<int> vertices;
+        std::vector<int> verticesUV;
+        std::vector<int> indices;
+
+        if (format == 0)
+        {
+            rect.setRect(frameValue(frameDict, "x").asFloat(), frameValue(frameDict, "y").asFloat(),
+                         frameValue(frameDict, "width").asFloat(), frameValue(frameDict, "height").asFloat());
+            offset.set(frameValue(frameDict, "offsetX").asFloat(), frameValue(frameDict, "offsetY").asFloat());
+            int ow = frameValue(frameDict, "originalWidth").asInt();
+            int oh = frameValue(frameDict, "originalHeight").asInt();
+            if (!ow || !oh)
+            {
+                CCLOGWARN("cocos2d: WARNING: originalWidth/Height not found on the SpriteFrame %s", frameIter.first.c_str());
+            }
+            originalSize.setSize((float)std::abs(ow), (float)std::abs(oh));
+        }
+        else if (format == 1 || format == 2)
+        {
+            rect = RectFromString(frameValue(frameDict, "frame").asString());
+            rotated = format == 2 && frameValue(frameDict, "rotated").asBool();
+            offset = PointFromString(frameValue(frameDict, "offset").asString());
+            originalSize = SizeFromString(frameValue(frameDict, "sourceSize").asString());
+        }
+        else
+        {
+            Size spriteSize = SizeFromString(frameValue(frameDict, "spriteSize").asString());
+            Rect textureRect = RectFromString(frameValue(frameDict, "textureRect").asString());
+            rect.setRect(textureRect.origin.x, textureRect.origin.y, spriteSize.width, spriteSize.height);
+            rotated = frameValue(frameDict, "textureRotated").asBool();
+            offset = PointFromString(frameValue(frameDict, "spriteOffset").asString());
+            originalSize = SizeFromString(frameValue(frameDict, "spriteSourceSize").asString());
+
+            auto iter = frameDict.find("aliases");
+            if (iter != frameDict.end() && iter->second.getType() == Value::Type::VECTOR)
+            {
+                for (const auto& alias : iter->second.asValueVector())
+                {
+                    writeUInt32(aliases, addString(alias.asString()));
+                    writeUInt32(aliases, frameCount);
+                    ++aliasCount;
+                }
+            }
+
+            if (frameDict.find("vertices") != frameDict.end())
+            {
+                parseIntegerList(frameValue(frameDict, "vertices").asString(), vertices);
+                parseIntegerList(frameValue(frameDict, "verticesUV").asString(), verticesUV);
+                parseIntegerList(frameValue(frameDict, "triangles").asString(), indices);
+                if (vertices.size() != verticesUV.size())
+                {
+                    CCLOG("cocos2d: SpriteAtlas: the polygon of %s has %d vertices and %d UVs", frameIter.first.c_str(), (int)vertices.size(), (int)verticesUV.size());
+                    return false;
+                }
+            }
+
+            if (frameDict.find("anchor") != frameDict.end())
+            {
+                hasAnchor = true;
+                anchor = PointFromString(frameValue(frameDict, "anchor").asString());
+            }
+        }
+
+        uint32_t flags = (rotated ? FLAG_ROTATED : 0) | (hasAnchor ? FLAG_ANCHOR : 0) | (!vertices.empty() ? FLAG_POLYGON : 0);
+        uint32_t polygonOffset = 0;
+        if (!vertices.empty())
+        {
+            polygonOffset = (uint32_t)polygons.size();
+            writeUInt32(polygons, (uint32_t)vertices.size());
+            writeUInt32(polygons, (uint32_t)indices.size());
+            for (auto value : vertices)
+                writeUInt32(polygons, (uint32_t)value);
+            for (auto value : verticesUV)
+                writeUInt32(polygons, (uint32_t)value);
+            for (auto value : indices)
+                writeUInt32(polygons, (uint32_t)value);
+        }
+
+        writeUInt32(frames, addString(frameIter.first));
+        writeFloat(frames, rect.origin.x);
+        writeFloat(frames, rect.origin.y);
+        writeFloat(frames, rect.size.width);
+        writeFloat(frames, rect.size.height);
+        writeFloat(frames, offset.x);
+        writeFloat(frames, offset.y);
+        writeFloat(frames, originalSize.width);
+        writeFloat(frames, originalSize.height);
+        writeFloat(frames, anchor.x);
+        writeFloat(frames, anchor.y);
+        writeUInt32(frames, flags);
+        writeUInt32(frames, polygonOffset);
+        ++frameCount;
+    }
+
+    uint32_t textureFileNameOffset = addString(textureFileName);
+    uint32_t pixelFormatNameOffset = addString(pixelFormatName);
+
+    uint32_t stringsOffset = (uint32_t)(HEADER_SIZE + frames.size() + aliases.size());
+    uint32_t polygonsOffset = stringsOffset + (uint32_t)strings.size();
+
+    std::vector<unsigned char> file(ATLAS_MAGIC, ATLAS_MAGIC + sizeof(ATLAS_MAGIC));
+    writeUInt32(file, VERSION);
+    writeUInt32(file, frameCount);
+    writeUInt32(file, aliasCount);
+    writeFloat(file, textureSize.width);
+    writeFloat(file, textureSize.height);
+    writeUInt32(file, textureFileNameOffset);
+    writeUInt32(file, pixelFormatNameOffset);
+    writeUInt32(file, stringsOffset);
+    writeUInt32(file, (uint32_t)strings.size());
+    writeUInt32(file, polygonsOffset);
+    writeUInt32(file, (uint32_t)polygons.size());
+
+    file.insert(file.end(), frames.begin(), frames.end());
+    file.insert(file.end(), aliases.begin(), aliases.end());
+    file.insert(file.end(), strings.begin(), strings.end());
+    file.insert(file.end(), polygons.begin(), polygons.end());
+
+    Data data;
+    data.copy(file.data(), file.size());
+    return FileUtils::getInstance()->writeDataToFile(data, fullpath);
+}
+
+NS_CC_END
@@ -0,0 +1,147 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CC_SPRITE_ATLAS_H__
+#define __CC_SPRITE_ATLAS_H__
+
+#include "base/CCValue.h"
+#include "math/CCGeometry.h"
+#include <string>
+#include <vector>
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class SpriteAtlas
+ * @brief Binary sprite sheet descriptions (.catlas), read by SpriteFrameCache without any string parsing.
+ *
+ * An atlas holds the same frames as a .plist sprite sheet, with the rects, offsets and sizes already resolved.
+ * All the values are 32 bit little endian integers or floats:
+ * - header: "CATL" magic, version, number of frames, number of aliases, texture width and height,
+ *   texture file name, pixel format name, offset and size of the string table, offset and size of the polygons
+ * - frames: name, x, y, width, height, offset x and y, original width and height, anchor x and y, flags, polygon
+ * - aliases: name, index of the frame
+ * - string table: NUL terminated strings, referenced by their offset in the table
+ * - polygons: number of vertex coordinates, number of indices, vertices, vertices UV, indices
+ *
+ * The files are produced offline by saveToFile(), see tools/atlas-converter.
+ * @js NA
+ */
+class CC_DLL SpriteAtlas
+{
+public:
+    static const int VERSION = 1;
+
+    static const unsigned int FLAG_ROTATED = 1 << 0;
+    static const unsigned int FLAG_ANCHOR = 1 << 1;
+    static const unsigned int FLAG_POLYGON = 1 << 2;
+
+    /** A frame of the atlas, as given to SpriteFrame::createWithTexture(). */
+    struct Frame
+    {
+        /** Points into the atlas data. */
+        const char* name;
+        Rect rect;
+        bool rotated;
+        Vec2 offset;
+        Size originalSize;
+        bool hasAnchor;
+        Vec2 anchor;
+        /** The polygon outline, in the layout of the .plist values. Empty when there is no polygon. */
+        std::vector<int> vertices;
+        std::vector<int> verticesUV;
+        std::vector<int> indices;
+    };
+
+    /** Returns whether the data starts with the sprite atlas magic. */
+    static bool isSpriteAtlas(const unsigned char* data, ssize_t dataLen);
+
+    /** Returns whether the file name has the .catlas extension. */
+    static bool isSpriteAtlasFile(const std::string& filename);
+
+    SpriteAtlas();
+
+    /**
+     * Checks the header and the tables of an atlas. Nothing is copied: `data` must outlive the atlas.
+     * @return false if the data is not a valid sprite atlas.
+     */
+    bool init(const unsigned char* data, ssize_t dataLen);
+
+    int getFrameCount() const { return _frameCount; }
+
+    /** Returns the name of a frame, without reading the rest of the frame. */
+    const char* getFrameName(int index) const;
+
+    /**
+     * Reads a frame of the atlas.
+     * `frame` can be reused from a frame to the next, so that the polygon vectors keep their capacity.
+     */
+    void getFrame(int index, Frame* frame) const;
+
+    int getAliasCount() const { return _aliasCount; }
+
+    /** Returns the name of an alias, and the index of its frame in `frameIndex`. */
+    const char* getAlias(int index, int* frameIndex) const;
+
+    /** The texture file name, relative to the atlas. Empty if the .plist didn't have any. */
+    const char* getTextureFileName() const { return _textureFileName; }
+
+    /** The pixel format name of the .plist metadata, e.g. "RGBA4444". Empty if the .plist didn't have any. */
+    const char* getPixelFormatName() const { return _pixelFormatName; }
+
+    const Size& getTextureSize() const { return _textureSize; }
+
+    /**
+     * Converts the dictionary of a .plist sprite sheet (format 0 to 3) into an atlas file.
+     *
+     * @param dictionary The dictionary of the .plist, see FileUtils::getValueMapFromFile().
+     * @param fullpath Path of the file to write.
+     */
+    static bool saveToFile(const ValueMap& dictionary, const std::string& fullpath);
+
+private:
+    const unsigned char* _data;
+    ssize_t _dataLen;
+    int _frameCount;
+    int _aliasCount;
+    Size _textureSize;
+    const char* _textureFileName;
+    const char* _pixelFormatName;
+    const unsigned char* _frames;
+    const unsigned char* _aliases;
+    const char* _strings;
+    uint32_t _stringsSize;
+    const unsigned char* _polygons;
+    uint32_t _polygonsSize;
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_SPRITE_ATLAS_H__
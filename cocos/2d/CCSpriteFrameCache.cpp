@@ -34,6 +34,7 @@ THE SOFTWARE.
 
 #include "2d/CCSprite.h"
 #include "2d/CCAutoPolygon.h"
+#include "2d/CCSpriteAtlas.h"
 #include "platform/CCFileUtils.h"
 #include "base/CCNS.h"
 #include "base/ccMacros.h"
@@ -296,18 +297,9 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dictionary, Textu
     CC_SAFE_DELETE(image);
 }
 
-void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dict, const std::string &texturePath)
+// loads the texture of a sprite sheet, in the pixel format of its metadata if there is one
+static Texture2D* addSpriteSheetTexture(const std::string& texturePath, const std::string& pixelFormatName)
 {
-    std::string pixelFormatName;
-    if (dict.find("metadata") != dict.end())
-    {
-        ValueMap& metadataDict = dict.at("metadata").asValueMap();
-        if (metadataDict.find("pixelFormat") != metadataDict.end())
-        {
-            pixelFormatName = metadataDict.at("pixelFormat").asString();
-        }
-    }
-    
     Texture2D *texture = nullptr;
     static std::unordered_map<std::string, Texture2D::PixelFormat> pixelFormats = {
         {"RGBA8888", Texture2D::PixelFormat::RGBA8888},
@@ -337,7 +329,23 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dict, const std::
     {
         texture = Director::getInstance()->getTextureCache()->addImage(texturePath);
     }
-    
+
+    return texture;
+}
+
+void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dict, const std::string &texturePath)
+{
+    std::string pixelFormatName;
+    if (dict.find("metadata") != dict.end())
+    {
+        ValueMap& metadataDict = dict.at("metadata").asValueMap();
+        if (metadataDict.find("pixelFormat") != metadataDict.end())
+        {
+            pixelFormatName = metadataDict.at("pixelFormat").asString();
+        }
+    }
+
+    Texture2D *texture = addSpriteSheetTexture(texturePath, pixelFormatName);
     if (texture)
     {
         addSpriteFramesWithDictionary(dict, texture);
@@ -348,6 +356,118 @@ void SpriteFrameCache::addSpriteFramesWithDictionary(ValueMap& dict, const std::
     }
 }
 
+void SpriteFrameCache::addSpriteFramesWithAtlas(const SpriteAtlas& atlas, Texture2D *texture, bool reload)
+{
+    auto textureFileName = Director::getInstance()->getTextureCache()->getTextureFilePath(texture);
+    Image* image = nullptr;
+    NinePatchImageParser parser;
+    SpriteAtlas::Frame frame;
+
+    const int frameCount = atlas.getFrameCount();
+    _spriteFrames.reserve(_spriteFrames.size() + frameCount);
+
+    for (int i = 0; i < frameCount; ++i)
+    {
+        std::string spriteFrameName(atlas.getFrameName(i));
+        if (reload)
+        {
+            _spriteFrames.erase(spriteFrameName);
+        }
+        else if (_spriteFrames.at(spriteFrameName))
+        {
+            continue;
+        }
+
+        atlas.getFrame(i, &frame);
+        SpriteFrame* spriteFrame = SpriteFrame::createWithTexture(texture,
+                                                                  frame.rect,
+                                                                  frame.rotated,
+                                                                  frame.offset,
+                                                                  frame.originalSize);
+
+        if (!frame.vertices.empty())
+        {
+            PolygonInfo info;
+            initializePolygonInfo(atlas.getTextureSize(), frame.originalSize, frame.vertices, frame.verticesUV, frame.indices, info);
+            spriteFrame->setPolygonInfo(info);
+        }
+        if (frame.hasAnchor)
+        {
+            spriteFrame->setAnchorPoint(frame.anchor);
+        }
+
+        if (NinePatchImageParser::isNinePatchImage(spriteFrameName))
+        {
+            if (image == nullptr) {
+                image = new (std::nothrow) Image();
+                image->initWithImageFile(textureFileName);
+            }
+            parser.setSpriteFrameInfo(image, spriteFrame->getRectInPixels(), spriteFrame->isRotated());
+            texture->addSpriteFrameCapInset(spriteFrame, parser.parseCapInset());
+        }
+
+        _spriteFrames.insert(spriteFrameName, spriteFrame);
+    }
+    CC_SAFE_DELETE(image);
+
+    for (int i = 0; i < atlas.getAliasCount(); ++i)
+    {
+        int frameIndex = 0;
+        std::string oneAlias(atlas.getAlias(i, &frameIndex));
+        if (_spriteFramesAliases.find(oneAlias) != _spriteFramesAliases.end())
+        {
+            CCLOGWARN("cocos2d: WARNING: an alias with name %s already exists", oneAlias.c_str());
+        }
+
+        _spriteFramesAliases[oneAlias] = Value(atlas.getFrameName(frameIndex));
+    }
+}
+
+void SpriteFrameCache::removeSpriteFramesFromAtlas(const SpriteAtlas& atlas)
+{
+    std::vector<std::string> keysToRemove;
+
+    for (int i = 0; i < atlas.getFrameCount(); ++i)
+    {
+        std::string spriteFrameName(atlas.getFrameName(i));
+        if (_spriteFrames.at(spriteFrameName))
+        {
+            keysToRemove.push_back(spriteFrameName);
+        }
+    }
+
+    _spriteFrames.erase(keysToRemove);
+}
+
+// reads an atlas file into `data`, which must outlive `atlas`
+static bool loadAtlas(const std::string& fullPath, Data* data, SpriteAtlas* atlas)
+{
+    *data = FileUtils::getInstance()->getDataFromFile(fullPath);
+    if (!atlas->init(data->getBytes(), data->getSize()))
+    {
+        CCLOG("cocos2d: SpriteFrameCache: can not load %s", fullPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+// the texture of an atlas is named in the atlas, relative to it, or has the name of the atlas with a .png extension
+static std::string getAtlasTexturePath(const SpriteAtlas& atlas, const std::string& atlasFile)
+{
+    std::string texturePath(atlas.getTextureFileName());
+    if (!texturePath.empty())
+    {
+        return FileUtils::getInstance()->fullPathFromRelativeFile(texturePath, atlasFile);
+    }
+
+    texturePath = atlasFile;
+    texturePath.erase(texturePath.find_last_of("."));
+    texturePath.append(".png");
+
+    CCLOG("cocos2d: SpriteFrameCache: Trying to use file %s as texture", texturePath.c_str());
+    return texturePath;
+}
+
 void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist, Texture2D *texture)
 {
     if (_loadedFileNames->find(plist) != _loadedFileNames->end())
@@ -356,6 +476,19 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist, Texture
     }
     
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
+    if (SpriteAtlas::isSpriteAtlasFile(fullPath))
+    {
+        Data data;
+        SpriteAtlas atlas;
+        if (!loadAtlas(fullPath, &data, &atlas))
+        {
+            return;
+        }
+        addSpriteFramesWithAtlas(atlas, texture);
+        _loadedFileNames->insert(plist);
+        return;
+    }
+
     ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
 
     addSpriteFramesWithDictionary(dict, texture);
@@ -377,6 +510,28 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist, const s
     }
     
     const std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
+    if (SpriteAtlas::isSpriteAtlasFile(fullPath))
+    {
+        Data data;
+        SpriteAtlas atlas;
+        if (!loadAtlas(fullPath, &data, &atlas))
+        {
+            return;
+        }
+
+        Texture2D *texture = addSpriteSheetTexture(textureFileName, atlas.getPixelFormatName());
+        if (texture)
+        {
+            addSpriteFramesWithAtlas(atlas, texture);
+            _loadedFileNames->insert(plist);
+        }
+        else
+        {
+            CCLOG("cocos2d: SpriteFrameCache: Couldn't load texture");
+        }
+        return;
+    }
+
     ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
     addSpriteFramesWithDictionary(dict, textureFileName);
     _loadedFileNames->insert(plist);
@@ -396,6 +551,27 @@ void SpriteFrameCache::addSpriteFramesWithFile(const std::string& plist)
 
     if (_loadedFileNames->find(plist) == _loadedFileNames->end())
     {
+        Data data;
+        SpriteAtlas atlas;
+        if (SpriteAtlas::isSpriteAtlasFile(fullPath))
+        {
+            if (!loadAtlas(fullPath, &data, &atlas))
+            {
+                return;
+            }
+
+            Texture2D *texture = addSpriteSheetTexture(getAtlasTexturePath(atlas, plist), atlas.getPixelFormatName());
+            if (texture)
+            {
+                addSpriteFramesWithAtlas(atlas, texture);
+                _loadedFileNames->insert(plist);
+            }
+            else
+            {
+                CCLOG("cocos2d: SpriteFrameCache: Couldn't load texture");
+            }
+            return;
+        }
 
         ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
 
@@ -509,14 +685,28 @@ void SpriteFrameCache::removeSpriteFrameByName(const std::string& name)
 void SpriteFrameCache::removeSpriteFramesFromFile(const std::string& plist)
 {
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
-    ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
-    if (dict.empty())
+    if (SpriteAtlas::isSpriteAtlasFile(fullPath))
     {
-        CCLOG("cocos2d:SpriteFrameCache:removeSpriteFramesFromFile: create dict by %s fail.",plist.c_str());
-        return;
+        Data data;
+        SpriteAtlas atlas;
+        if (!loadAtlas(fullPath, &data, &atlas))
+        {
+            return;
+        }
+
+        removeSpriteFramesFromAtlas(atlas);
     }
+    else
+    {
+        ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
+        if (dict.empty())
+        {
+            CCLOG("cocos2d:SpriteFrameCache:removeSpriteFramesFromFile: create dict by %s fail.",plist.c_str());
+            return;
+        }
 
-    removeSpriteFramesFromDictionary(dict);
+        removeSpriteFramesFromDictionary(dict);
+    }
 
     // remove it from the cache
     set<string>::iterator ret = _loadedFileNames->find(plist);
@@ -718,6 +908,32 @@ bool SpriteFrameCache::reloadTexture(const std::string& plist)
     }
 
     std::string fullPath = FileUtils::getInstance()->fullPathForFilename(plist);
+    if (SpriteAtlas::isSpriteAtlasFile(fullPath))
+    {
+        Data data;
+        SpriteAtlas atlas;
+        if (!loadAtlas(fullPath, &data, &atlas))
+        {
+            return true;
+        }
+
+        std::string texturePath = getAtlasTexturePath(atlas, plist);
+        Texture2D *texture = nullptr;
+        if (Director::getInstance()->getTextureCache()->reloadTexture(texturePath))
+            texture = Director::getInstance()->getTextureCache()->getTextureForKey(texturePath);
+
+        if (texture)
+        {
+            addSpriteFramesWithAtlas(atlas, texture, true);
+            _loadedFileNames->insert(plist);
+        }
+        else
+        {
+            CCLOG("cocos2d: SpriteFrameCache: Couldn't load texture");
+        }
+        return true;
+    }
+
     ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(fullPath);
 
     string texturePath("");
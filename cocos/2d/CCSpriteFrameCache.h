@@ -42,6 +42,7 @@ NS_CC_BEGIN
 class Sprite;
 class Texture2D;
 class PolygonInfo;
+class SpriteAtlas;
 
 /**
  * @addtogroup _2d
@@ -80,6 +81,9 @@ class PolygonInfo;
  Use one of the following tools to create the .plist file and sprite sheet:
  - [TexturePacker](https://www.codeandweb.com/texturepacker/cocos2d)
  - [Zwoptex](https://zwopple.com/zwoptex/)
+
+ The .plist files can be converted offline to binary atlases (.catlas), which are loaded without building
+ a dictionary or parsing any string, see SpriteAtlas. All the methods taking a .plist file also take a .catlas file.
  
  @since v0.9
  @js cc.spriteFrameCache
@@ -256,6 +260,14 @@ protected:
 
     void reloadSpriteFramesWithDictionary(ValueMap& dictionary, Texture2D *texture);
 
+    /* Adds the sprite frames of a binary atlas. When reloading, the frames already in the cache are replaced.
+     */
+    void addSpriteFramesWithAtlas(const SpriteAtlas& atlas, Texture2D *texture, bool reload = false);
+
+    /* Removes the sprite frames of a binary atlas.
+     */
+    void removeSpriteFramesFromAtlas(const SpriteAtlas& atlas);
+
     Map<std::string, SpriteFrame*> _spriteFrames;
     ValueMap _spriteFramesAliases;
     std::set<std::string>*  _loadedFileNames;
@@ -0,0 +1,295 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "2d/CCTweenBatch.h"
+#include "2d/CCNode.h"
+#include "math/CCSIMD.h"
+
+#include <algorithm>
+#include <float.h>
+
+NS_CC_BEGIN
+
+TweenBatch* TweenBatch::s_tweenBatch = nullptr;
+
+TweenBatch* TweenBatch::getInstance()
+{
+    if (s_tweenBatch == nullptr)
+    {
+        s_tweenBatch = new (std::nothrow) TweenBatch();
+    }
+    return s_tweenBatch;
+}
+
+void TweenBatch::destroyInstance()
+{
+    CC_SAFE_RELEASE_NULL(s_tweenBatch);
+}
+
+TweenBatch::TweenBatch()
+: _isEnabled(false)
+{
+}
+
+TweenBatch::~TweenBatch()
+{
+    for (auto tween : _timedTweens)
+    {
+        _nodes[tween]->release();
+    }
+}
+
+int TweenBatch::allocateTween(Node* node, Property property, const Vec3& from, const Vec3& delta, State state)
+{
+    int tween;
+    if (!_freeTweens.empty())
+    {
+        tween = _freeTweens.back();
+        _freeTweens.pop_back();
+    }
+    else
+    {
+        tween = (int)_nodes.size();
+        _nodes.push_back(nullptr);
+        _owners.push_back(nullptr);
+        _properties.push_back(property);
+        _states.push_back(State::FREE);
+        _progresses.push_back(0);
+        _isDirty.push_back(false);
+        _from.resize(_from.size() + 4);
+        _deltas.resize(_deltas.size() + 4);
+        _values.resize(_values.size() + 4);
+    }
+
+    _nodes[tween] = node;
+    _owners[tween] = nullptr;
+    _properties[tween] = property;
+    _states[tween] = state;
+    _progresses[tween] = 0;
+
+    float* values = &_from[tween * 4];
+    values[0] = from.x;
+    values[1] = from.y;
+    values[2] = from.z;
+    values[3] = 0;
+
+    values = &_deltas[tween * 4];
+    values[0] = delta.x;
+    values[1] = delta.y;
+    values[2] = delta.z;
+    values[3] = 0;
+
+    return tween;
+}
+
+void TweenBatch::freeTween(int tween)
+{
+    // it may still be in _dirtyTweens, where it is skipped
+    _nodes[tween] = nullptr;
+    _owners[tween] = nullptr;
+    _states[tween] = State::FREE;
+    _isDirty[tween] = false;
+    _freeTweens.push_back(tween);
+}
+
+void TweenBatch::addTween(Node* node, Property property, const Vec3& from, const Vec3& to, float duration, tweenfunc::TweenType easing)
+{
+    CCASSERT(node != nullptr, "node can't be nullptr!");
+    CCASSERT(easing != tweenfunc::CUSTOM_EASING, "custom easings aren't supported");
+    if (node == nullptr)
+        return;
+
+    int tween = allocateTween(node, property, from, to - from, State::TIMED);
+    node->retain();
+
+    _timedTweens.push_back(tween);
+    _elapsed.push_back(0);
+    // prevent division by 0, like ActionInterval
+    _durations.push_back(std::max(duration, FLT_EPSILON));
+    _easings.push_back(easing);
+}
+
+void TweenBatch::removeTimedTween(size_t position)
+{
+    int tween = _timedTweens[position];
+    Node* node = _nodes[tween];
+
+    size_t last = _timedTweens.size() - 1;
+    _timedTweens[position] = _timedTweens[last];
+    _elapsed[position] = _elapsed[last];
+    _durations[position] = _durations[last];
+    _easings[position] = _easings[last];
+    _timedTweens.pop_back();
+    _elapsed.pop_back();
+    _durations.pop_back();
+    _easings.pop_back();
+
+    freeTween(tween);
+    node->release();
+}
+
+void TweenBatch::stopTweens(Node* node)
+{
+    for (size_t i = 0; i < _timedTweens.size();)
+    {
+        if (_nodes[_timedTweens[i]] == node)
+        {
+            removeTimedTween(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+int TweenBatch::addDrivenTween(const void* owner, Node* node, Property property, const Vec3& from, const Vec3& delta)
+{
+    CCASSERT(node != nullptr, "node can't be nullptr!");
+
+    int tween = allocateTween(node, property, from, delta, State::DRIVEN);
+    _owners[tween] = owner;
+    return tween;
+}
+
+void TweenBatch::setProgress(int tween, float progress)
+{
+    CCASSERT(tween >= 0 && tween < (int)_nodes.size() && (_states[tween] == State::TIMED || _states[tween] == State::DRIVEN), "invalid tween");
+
+    _progresses[tween] = progress;
+    if (!_isDirty[tween])
+    {
+        _isDirty[tween] = true;
+        _dirtyTweens.push_back(tween);
+    }
+}
+
+void TweenBatch::removeDrivenTween(int tween, const void* owner, bool writeValue)
+{
+    if (tween >= 0 && tween < (int)_nodes.size() && _states[tween] == State::DRIVEN && _owners[tween] == owner)
+    {
+        if (writeValue && _isDirty[tween])
+        {
+            // it may still be in _dirtyTweens, where it is skipped once freed
+            float* value = &_values[tween * 4];
+            const float* from = &_from[tween * 4];
+            const float* delta = &_deltas[tween * 4];
+            for (int i = 0; i < 4; ++i)
+            {
+                value[i] = from[i] + delta[i] * _progresses[tween];
+            }
+            writeTween(tween);
+        }
+        freeTween(tween);
+    }
+}
+
+void TweenBatch::writeTween(int tween)
+{
+    _isDirty[tween] = false;
+
+    Node* node = _nodes[tween];
+    const float* value = &_values[tween * 4];
+    switch (_properties[tween])
+    {
+        case Property::POSITION:
+            node->setPosition(value[0], value[1]);
+            break;
+        case Property::SCALE:
+            node->setScale(value[0], value[1]);
+            node->setScaleZ(value[2]);
+            break;
+        case Property::ROTATION:
+            node->setRotationSkewX(value[0]);
+            node->setRotationSkewY(value[1]);
+            break;
+        case Property::OPACITY:
+            node->setOpacity((GLubyte)value[0]);
+            break;
+    }
+}
+
+void TweenBatch::flush()
+{
+    if (_dirtyTweens.empty())
+        return;
+
+    // the setters may set the progress of other tweens, which are written by the next flush
+    _flushedTweens.swap(_dirtyTweens);
+
+    // evaluates all the values, then writes them
+    for (auto tween : _flushedTweens)
+    {
+        const int offset = tween * 4;
+        const float progress = _progresses[tween];
+#if CC_SIMD_ENABLED
+        simd4::store(&_values[offset], simd4::add(simd4::load(&_from[offset]), simd4::mul(simd4::load(&_deltas[offset]), simd4::set(progress))));
+#else
+        for (int i = offset; i < offset + 4; ++i)
+        {
+            _values[i] = _from[i] + _deltas[i] * progress;
+        }
+#endif
+    }
+
+    for (auto tween : _flushedTweens)
+    {
+        // removed, or already written
+        if (!_isDirty[tween])
+            continue;
+
+        writeTween(tween);
+    }
+
+    _flushedTweens.clear();
+}
+
+void TweenBatch::update(float dt)
+{
+    const size_t count = _timedTweens.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        _elapsed[i] += dt;
+        float time = std::min(_elapsed[i] / _durations[i], 1.0f);
+        if (_easings[i] != tweenfunc::Linear)
+        {
+            time = tweenfunc::tweenTo(time, _easings[i], nullptr);
+        }
+        setProgress(_timedTweens[i], time);
+    }
+
+    flush();
+
+    // from the last one, so that the tweens swapped in place of the removed ones have been checked
+    for (size_t i = _timedTweens.size(); i-- > 0;)
+    {
+        if (_elapsed[i] >= _durations[i])
+        {
+            removeTimedTween(i);
+        }
+    }
+}
+
+NS_CC_END
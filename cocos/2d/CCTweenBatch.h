@@ -0,0 +1,190 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CC_TWEEN_BATCH_H__
+#define __CC_TWEEN_BATCH_H__
+
+#include "base/CCRef.h"
+#include "math/Vec3.h"
+#include "2d/CCTweenFunction.h"
+#include <vector>
+
+/**
+ * @addtogroup actions
+ * @{
+ */
+NS_CC_BEGIN
+
+class Node;
+
+/**
+ * @class TweenBatch
+ * @brief Evaluates the tweens of many nodes in a single pass, and writes them back to the nodes afterwards.
+ *
+ * The start values, deltas, durations and easings of the tweens are kept in flat arrays, so that a frame
+ * is one loop computing all the values followed by one loop calling the Node setters, instead of each
+ * action interpolating and writing its own node.
+ *
+ * There are two kinds of tweens:
+ * - timed tweens, added with addTween(), which the batch steps itself with their easing (see tweenfunc)
+ *   until they are done.
+ * - driven tweens, whose progress is set by an action. When the batch is enabled, MoveTo, ScaleTo (and ScaleBy),
+ *   RotateTo and FadeTo (and FadeIn/FadeOut) use driven tweens instead of calling the Node setters.
+ *   The values of driven tweens are written back at the end of ActionManager::update(), or when their action is done.
+ *   So the actions following a batched action in a Sequence start from its final value, but the node still has
+ *   its previous value during the update, e.g. in a CallFunc running in parallel with a MoveTo.
+ *   Batched MoveTo actions don't stack with the other moves of their node (CC_ENABLE_STACKABLE_ACTIONS).
+ *
+ * The batch is disabled by default.
+ * @js NA
+ */
+class CC_DLL TweenBatch : public Ref
+{
+public:
+    /** The property of the node a tween updates, and the components of its values used. */
+    enum class Property
+    {
+        /** x, y: setPosition() */
+        POSITION,
+        /** x, y, z: setScale(), setScaleZ() */
+        SCALE,
+        /** x, y: setRotationSkewX(), setRotationSkewY() */
+        ROTATION,
+        /** x: setOpacity() */
+        OPACITY,
+    };
+
+    static const int INVALID_TWEEN = -1;
+
+    /** Returns the shared tween batch, stepped by the Director after the actions. */
+    static TweenBatch* getInstance();
+
+    /** Returns the shared tween batch, or nullptr if it hasn't been created or has been destroyed. */
+    static TweenBatch* getInstanceOrNull() { return s_tweenBatch; }
+
+    /** Destroys the tween batch, releasing the nodes of its timed tweens. */
+    static void destroyInstance();
+
+    /** Sets whether the actions use the batch. Defaults to false. */
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    /**
+     * Tweens a property of a node from `from` to `to`. The node is retained until the tween is done,
+     * or until stopTweens() is called for it.
+     *
+     * @param node The node to update.
+     * @param property The property of the node to update.
+     * @param from The value at the beginning of the tween.
+     * @param to The value at the end of the tween.
+     * @param duration The duration in seconds.
+     * @param easing The easing of the tween, it can't be CUSTOM_EASING.
+     */
+    void addTween(Node* node, Property property, const Vec3& from, const Vec3& to, float duration, tweenfunc::TweenType easing = tweenfunc::Linear);
+
+    /** Stops the timed tweens of a node, leaving the node with its current values. */
+    void stopTweens(Node* node);
+
+    /**
+     * Adds a tween whose progress is set by setProgress(). Its value is `from + delta * progress`.
+     * The node isn't retained: the owner of the tween must remove it before the node is deleted.
+     * @param owner The object owning the tween, usually the action.
+     * @return The index of the tween, to pass to setProgress() and removeDrivenTween().
+     */
+    int addDrivenTween(const void* owner, Node* node, Property property, const Vec3& from, const Vec3& delta);
+
+    /** Sets the progress of a driven tween, its value is written to the node by the next flush(). */
+    void setProgress(int tween, float progress);
+
+    /**
+     * Removes a driven tween. Nothing is done if the tween isn't owned by `owner` anymore.
+     * @param writeValue Whether the pending value of the tween, if any, is written to the node right away,
+     * e.g. so that an action can be stopped right after its last update and the next action starts from its final value.
+     * Otherwise the pending value is dropped, e.g. when the node is being deleted.
+     */
+    void removeDrivenTween(int tween, const void* owner, bool writeValue);
+
+    /** Returns the number of tweens, timed and driven. */
+    ssize_t getTweenCount() const { return (ssize_t)(_nodes.size() - _freeTweens.size()); }
+
+    /** Writes the values of the tweens whose progress changed to their nodes. */
+    void flush();
+
+    /**
+     * Steps the timed tweens, then flushes all the tweens.
+     * @param dt In seconds.
+     */
+    void update(float dt);
+
+CC_CONSTRUCTOR_ACCESS:
+    TweenBatch();
+    virtual ~TweenBatch();
+
+protected:
+    enum class State : unsigned char
+    {
+        FREE,
+        TIMED,
+        DRIVEN,
+    };
+
+    int allocateTween(Node* node, Property property, const Vec3& from, const Vec3& delta, State state);
+    void freeTween(int tween);
+    // writes the value of a tween, computed in _values, to its node
+    void writeTween(int tween);
+    void removeTimedTween(size_t position);
+
+    bool _isEnabled;
+
+    // one element per tween
+    std::vector<Node*> _nodes;
+    std::vector<const void*> _owners;
+    std::vector<Property> _properties;
+    std::vector<State> _states;
+    std::vector<float> _progresses;
+    std::vector<bool> _isDirty;
+    // 4 floats per tween, the last one unused, so that the values are evaluated 4 components at a time
+    std::vector<float> _from;
+    std::vector<float> _deltas;
+    std::vector<float> _values;
+
+    // the timed tweens, and their timing
+    std::vector<int> _timedTweens;
+    std::vector<float> _elapsed;
+    std::vector<float> _durations;
+    std::vector<tweenfunc::TweenType> _easings;
+
+    std::vector<int> _dirtyTweens;
+    // the tweens being written back by flush()
+    std::vector<int> _flushedTweens;
+    std::vector<int> _freeTweens;
+
+    static TweenBatch* s_tweenBatch;
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_TWEEN_BATCH_H__
@@ -9,8 +9,10 @@ LOCAL_ARM_MODE := arm
 
 ifeq ($(TARGET_ARCH_ABI),armeabi-v7a)
 MATHNEONFILE := math/MathUtil.cpp.neon
+PIXELNEONFILE := renderer/CCPixelConverter.cpp.neon
 else
 MATHNEONFILE := math/MathUtil.cpp
+PIXELNEONFILE := renderer/CCPixelConverter.cpp
 endif
 
 LOCAL_SRC_FILES := \
@@ -71,6 +73,7 @@ cocos2d.cpp \
 2d/CCSpriteBatchNode.cpp \
 2d/CCSpriteFrame.cpp \
 2d/CCSpriteFrameCache.cpp \
+2d/CCSpriteAtlas.cpp \
 2d/CCTMXLayer.cpp \
 2d/CCTMXObjectGroup.cpp \
 2d/CCTMXTiledMap.cpp \
@@ -81,11 +84,14 @@ cocos2d.cpp \
 2d/CCTransitionPageTurn.cpp \
 2d/CCTransitionProgress.cpp \
 2d/CCTweenFunction.cpp \
+2d/CCTweenBatch.cpp \
+2d/CCAnimationLOD.cpp \
 2d/CCAutoPolygon.cpp \
 platform/CCFileUtils.cpp \
 platform/CCGLView.cpp \
 platform/CCImage.cpp \
 platform/CCSAXParser.cpp \
+platform/CCPlistParser.cpp \
 platform/CCThread.cpp \
 $(MATHNEONFILE) \
 math/CCAffineTransform.cpp \
@@ -100,6 +106,8 @@ math/Vec4.cpp \
 base/CCNinePatchImageParser.cpp \
 base/CCStencilStateManager.cpp \
 base/CCAsyncTaskPool.cpp \
+base/CCFrameArena.cpp \
+base/CCWorkerPool.cpp \
 base/CCAutoreleasePool.cpp \
 base/CCConfiguration.cpp \
 base/CCConsole.cpp \
@@ -153,6 +161,7 @@ renderer/CCGroupCommand.cpp \
 renderer/CCMaterial.cpp \
 renderer/CCMeshCommand.cpp \
 renderer/CCPass.cpp \
+$(PIXELNEONFILE) \
 renderer/CCPrimitive.cpp \
 renderer/CCPrimitiveCommand.cpp \
 renderer/CCQuadCommand.cpp \
@@ -163,6 +172,7 @@ renderer/CCTechnique.cpp \
 renderer/CCTexture2D.cpp \
 renderer/CCTextureAtlas.cpp \
 renderer/CCTextureCache.cpp \
+renderer/CCTextureContainer.cpp \
 renderer/CCTrianglesCommand.cpp \
 renderer/CCVertexAttribBinding.cpp \
 renderer/CCVertexIndexBuffer.cpp \
@@ -25,8 +25,13 @@ THE SOFTWARE.
 
 #include "base/CCAsyncTaskPool.h"
 
+#include <algorithm>
+
 NS_CC_BEGIN
 
+static const int MIN_WORKER_COUNT = (int)AsyncTaskPool::TaskType::TASK_MAX_TYPE;
+static const int MAX_WORKER_COUNT = 8;
+
 AsyncTaskPool* AsyncTaskPool::s_asyncTaskPool = nullptr;
 
 AsyncTaskPool* AsyncTaskPool::getInstance()
@@ -45,11 +50,164 @@ void AsyncTaskPool::destroyInstance()
 }
 
 AsyncTaskPool::AsyncTaskPool()
+: _nextWorker(0)
+, _pendingTasks(0)
+, _stop(false)
 {
+    // tasks may block on IO, so keep at least one thread per task type as before
+    int cores = (int)std::thread::hardware_concurrency();
+    int workerCount = std::min(std::max(cores - 1, MIN_WORKER_COUNT), MAX_WORKER_COUNT);
+
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers.push_back(new (std::nothrow) Worker());
+    }
+    // start the threads once all the workers exist, they steal from each other
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers[i]->thread = std::thread(&AsyncTaskPool::workerLoop, this, i);
+    }
 }
 
 AsyncTaskPool::~AsyncTaskPool()
 {
+    {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _sleepCondition.notify_all();
+
+    for (auto worker : _workers)
+    {
+        worker->thread.join();
+    }
+    for (auto worker : _workers)
+    {
+        delete worker;
+    }
+}
+
+void AsyncTaskPool::stopTasks(TaskType type)
+{
+    int removed = 0;
+    for (auto worker : _workers)
+    {
+        std::unique_lock<std::mutex> lock(worker->mutex);
+        for (auto& tasks : worker->tasks)
+        {
+            auto newEnd = std::remove_if(tasks.begin(), tasks.end(), [type](const Task& task){ return task.type == (int)type; });
+            removed += (int)(tasks.end() - newEnd);
+            tasks.erase(newEnd, tasks.end());
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    _pendingTasks -= removed;
+}
+
+void AsyncTaskPool::enqueueTask(TaskPriority priority, int type, std::function<void()> func)
+{
+    {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+
+        // don't allow enqueueing after stopping the pool
+        if (_stop)
+        {
+            CC_ASSERT(0 && "already stop");
+            return;
+        }
+    }
+
+    Worker* worker = _workers[_nextWorker++ % _workers.size()];
+    {
+        std::unique_lock<std::mutex> lock(worker->mutex);
+        Task task;
+        task.func = std::move(func);
+        task.type = type;
+        worker->tasks[(int)priority].push_back(std::move(task));
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        ++_pendingTasks;
+    }
+    _sleepCondition.notify_one();
+}
+
+bool AsyncTaskPool::takeTask(int workerIndex, Task& task)
+{
+    const int workerCount = (int)_workers.size();
+
+    for (int priority = PRIORITY_COUNT - 1; priority >= 0; --priority)
+    {
+        // own queue first, oldest task first
+        {
+            Worker* worker = _workers[workerIndex];
+            std::unique_lock<std::mutex> lock(worker->mutex);
+            auto& tasks = worker->tasks[priority];
+            if (!tasks.empty())
+            {
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                --_pendingTasks;
+                return true;
+            }
+        }
+
+        // then steal the newest task of another worker
+        for (int i = 1; i < workerCount; ++i)
+        {
+            Worker* victim = _workers[(workerIndex + i) % workerCount];
+            std::unique_lock<std::mutex> lock(victim->mutex, std::try_to_lock);
+            if (!lock.owns_lock())
+                continue;
+
+            auto& tasks = victim->tasks[priority];
+            if (!tasks.empty())
+            {
+                task = std::move(tasks.back());
+                tasks.pop_back();
+                --_pendingTasks;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void AsyncTaskPool::workerLoop(int workerIndex)
+{
+    for (;;)
+    {
+        // the tasks still queued are discarded when the pool is destroyed
+        if (_stop)
+            return;
+
+        Task task;
+        if (takeTask(workerIndex, task))
+        {
+            task.func();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        if (_stop)
+            return;
+
+        // a victim may have been skipped because it was locked, so don't sleep while tasks are pending
+        if (_pendingTasks > 0)
+        {
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        _sleepCondition.wait(lock, [this]{ return _stop || _pendingTasks > 0; });
+    }
+}
+
+void AsyncTaskPool::performInCocosThread(const std::function<void()>& func)
+{
+    Director::getInstance()->getScheduler()->performFunctionInCocosThread(func);
 }
 
 NS_CC_END
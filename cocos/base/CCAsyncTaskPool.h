@@ -29,8 +29,9 @@ THE SOFTWARE.
 #include "base/CCDirector.h"
 #include "base/CCScheduler.h"
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -48,6 +49,10 @@ NS_CC_BEGIN
 /**
  * @class AsyncTaskPool
  * @brief This class allows to perform background operations without having to manipulate threads.
+ *
+ * The tasks are run by a pool of worker threads, each one with its own task queues. An idle worker
+ * steals tasks from the queues of the busy ones, so that tasks of any kind can use all the cores.
+ * Tasks with a higher priority are run first.
  * @js NA
  */
 class CC_DLL AsyncTaskPool
@@ -63,6 +68,13 @@ public:
         TASK_MAX_TYPE,
     };
 
+    enum class TaskPriority
+    {
+        LOW,
+        NORMAL,
+        HIGH,
+    };
+
     /**
      * Returns the shared instance of the async task pool.
      */
@@ -75,6 +87,7 @@ public:
 
     /**
      * Stop tasks.
+     * Tasks of this type that didn't start yet are discarded, and their callbacks are not called.
      *
      * @param type Task type you want to stop.
      */
@@ -83,7 +96,7 @@ public:
     /**
      * Enqueue a asynchronous task.
      *
-     * @param type task type is io task, network task or others, each type of task has a thread to deal with it.
+     * @param type task type is io task, network task or others. Tasks of all the types share the worker threads.
      * @param callback callback when the task is finished. The callback is called in the main thread instead of task thread.
      * @param callbackParam parameter used by the callback.
      * @param f task can be lambda function.
@@ -92,125 +105,129 @@ public:
     template<class F>
     inline void enqueue(TaskType type, const TaskCallBack& callback, void* callbackParam, F&& f);
 
+    /**
+     * Enqueue a asynchronous task, whose result is passed to a continuation called in the main thread.
+     *
+     * @param priority tasks with a higher priority are run first.
+     * @param task task can be lambda function. Its return value, if any, is passed to the continuation.
+     * @param continuation function called in the main thread once the task is finished.
+     * @lua NA
+     */
+    template<class F, class C>
+    inline void enqueue(TaskPriority priority, F&& task, C&& continuation);
+
+    /**
+     * Enqueue a asynchronous task without continuation.
+     *
+     * @param priority tasks with a higher priority are run first.
+     * @param task task can be lambda function.
+     * @lua NA
+     */
+    template<class F>
+    inline void enqueue(TaskPriority priority, F&& task);
+
+    /**
+     * Returns the number of worker threads.
+     */
+    int getWorkerCount() const { return (int)_workers.size(); }
+
 CC_CONSTRUCTOR_ACCESS:
     AsyncTaskPool();
     ~AsyncTaskPool();
 
 protected:
+    static const int NO_TASK_TYPE = -1;
+    static const int PRIORITY_COUNT = (int)TaskPriority::HIGH + 1;
 
-    // thread tasks internally used
-    class ThreadTasks {
-        struct AsyncTaskCallBack
-        {
-            TaskCallBack          callback;
-            void*                 callbackParam;
-        };
-    public:
-        ThreadTasks()
-        : _stop(false)
-        {
-            _thread = std::thread(
-                                  [this]
-                                  {
-                                      for(;;)
-                                      {
-                                          std::function<void()> task;
-                                          AsyncTaskCallBack callback;
-                                          {
-                                              std::unique_lock<std::mutex> lock(this->_queueMutex);
-                                              this->_condition.wait(lock,
-                                                                    [this]{ return this->_stop || !this->_tasks.empty(); });
-                                              if(this->_stop && this->_tasks.empty())
-                                                  return;
-                                              task = std::move(this->_tasks.front());
-                                              callback = std::move(this->_taskCallBacks.front());
-                                              this->_tasks.pop();
-                                              this->_taskCallBacks.pop();
-                                          }
-
-                                          task();
-                                          Director::getInstance()->getScheduler()->performFunctionInCocosThread([&, callback]{ callback.callback(callback.callbackParam); });
-                                      }
-                                  }
-                                  );
-        }
-        ~ThreadTasks()
-        {
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-                _stop = true;
-
-                while(_tasks.size())
-                    _tasks.pop();
-                while (_taskCallBacks.size())
-                    _taskCallBacks.pop();
-            }
-            _condition.notify_all();
-            _thread.join();
-        }
-        void clear()
-        {
-            std::unique_lock<std::mutex> lock(_queueMutex);
-            while(_tasks.size())
-                _tasks.pop();
-            while (_taskCallBacks.size())
-                _taskCallBacks.pop();
-        }
-        template<class F>
-        void enqueue(const TaskCallBack& callback, void* callbackParam, F&& f)
+    struct Task
+    {
+        std::function<void()> func;
+        int type;
+    };
+
+    // each worker owns a queue per priority. The owner takes its oldest tasks,
+    // idle workers steal the newest ones
+    struct Worker
+    {
+        std::thread thread;
+        std::mutex mutex;
+        std::deque<Task> tasks[PRIORITY_COUNT];
+    };
+
+    // the result of a task, passed to the continuation in the main thread
+    template<class R>
+    struct ContinuationTask
+    {
+        template<class F, class C>
+        static std::function<void()> create(F task, C continuation)
         {
-            auto task = f;//std::bind(std::forward<F>(f), std::forward<Args>(args)...);
-
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-
-                // don't allow enqueueing after stopping the pool
-                if(_stop)
-                {
-                    CC_ASSERT(0 && "already stop");
-                    return;
-                }
-
-                AsyncTaskCallBack taskCallBack;
-                taskCallBack.callback = callback;
-                taskCallBack.callbackParam = callbackParam;
-                _tasks.emplace([task](){ task(); });
-                _taskCallBacks.emplace(taskCallBack);
-            }
-            _condition.notify_one();
+            return [task, continuation]() {
+                auto result = std::make_shared<R>(task());
+                AsyncTaskPool::performInCocosThread([result, continuation]() {
+                    continuation(std::move(*result));
+                });
+            };
         }
-    private:
-
-        // need to keep track of thread so we can join them
-        std::thread _thread;
-        // the task queue
-        std::queue< std::function<void()> > _tasks;
-        std::queue<AsyncTaskCallBack>            _taskCallBacks;
-
-        // synchronization
-        std::mutex _queueMutex;
-        std::condition_variable _condition;
-        bool _stop;
     };
 
-    //tasks
-    ThreadTasks _threadTasks[int(TaskType::TASK_MAX_TYPE)];
+    void enqueueTask(TaskPriority priority, int type, std::function<void()> func);
+    bool takeTask(int workerIndex, Task& task);
+    void workerLoop(int workerIndex);
+
+    static void performInCocosThread(const std::function<void()>& func);
+
+    std::vector<Worker*> _workers;
+
+    // next worker receiving a task
+    std::atomic<unsigned int> _nextWorker;
+
+    // number of queued tasks; changed under _sleepMutex so that no wake up is missed
+    std::atomic<int> _pendingTasks;
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    std::atomic<bool> _stop;
 
     static AsyncTaskPool* s_asyncTaskPool;
 };
 
-inline void AsyncTaskPool::stopTasks(TaskType type)
+template<>
+struct AsyncTaskPool::ContinuationTask<void>
 {
-    auto& threadTask = _threadTasks[(int)type];
-    threadTask.clear();
-}
+    template<class F, class C>
+    static std::function<void()> create(F task, C continuation)
+    {
+        return [task, continuation]() {
+            task();
+            AsyncTaskPool::performInCocosThread(continuation);
+        };
+    }
+};
 
 template<class F>
 inline void AsyncTaskPool::enqueue(AsyncTaskPool::TaskType type, const TaskCallBack& callback, void* callbackParam, F&& f)
 {
-    auto& threadTask = _threadTasks[(int)type];
+    auto task = f;
+    enqueueTask(TaskPriority::NORMAL, (int)type, [task, callback, callbackParam]() {
+        task();
+        AsyncTaskPool::performInCocosThread([callback, callbackParam]{ callback(callbackParam); });
+    });
+}
 
-    threadTask.enqueue(callback, callbackParam, f);
+template<class F, class C>
+inline void AsyncTaskPool::enqueue(TaskPriority priority, F&& task, C&& continuation)
+{
+    typedef typename std::decay<F>::type Function;
+    typedef typename std::decay<C>::type Continuation;
+    typedef typename std::result_of<Function()>::type Result;
+
+    enqueueTask(priority, NO_TASK_TYPE,
+                ContinuationTask<Result>::template create<Function, Continuation>(std::forward<F>(task), std::forward<C>(continuation)));
+}
+
+template<class F>
+inline void AsyncTaskPool::enqueue(TaskPriority priority, F&& task)
+{
+    enqueueTask(priority, NO_TASK_TYPE, std::forward<F>(task));
 }
 
 
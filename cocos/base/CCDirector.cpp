@@ -36,6 +36,8 @@ THE SOFTWARE.
 #include "platform/CCFileUtils.h"
 
 #include "2d/CCActionManager.h"
+#include "2d/CCTweenBatch.h"
+#include "2d/CCAnimationLOD.h"
 #include "2d/CCFontFNT.h"
 #include "2d/CCFontAtlasCache.h"
 #include "2d/CCAnimationCache.h"
@@ -59,8 +61,12 @@ THE SOFTWARE.
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCWorkerPool.h"
+#include "base/CCFrameArena.h"
 #include "platform/CCApplication.h"
 #include "editor-support/spine/SkeletonBatch.h"
+#include "editor-support/spine/SkeletonDataCache.h"
+#include "editor-support/spine/SkeletonUpdateBatch.h"
 
 #if CC_ENABLE_SCRIPT_BINDING
 #include "base/CCScriptSupport.h"
@@ -153,6 +159,10 @@ bool Director::init(void)
     // action manager
     _actionManager = new (std::nothrow) ActionManager();
     _scheduler->scheduleUpdate(_actionManager, Scheduler::PRIORITY_SYSTEM, false);
+    // tween batch, after the actions
+    _scheduler->scheduleUpdate(TweenBatch::getInstance(), Scheduler::PRIORITY_SYSTEM, false);
+    // spine poses, after the updates of the skeletons
+    _scheduler->scheduleUpdate(spine::SkeletonUpdateBatch::getInstance(), spine::SkeletonUpdateBatch::UPDATE_PRIORITY, false);
 
     _eventDispatcher = new (std::nothrow) EventDispatcher();
     _eventAfterDraw = new (std::nothrow) EventCustom(EVENT_AFTER_DRAW);
@@ -173,6 +183,8 @@ bool Director::init(void)
     _renderer = new (std::nothrow) Renderer;
     RenderState::initialize();
 
+    _frameArena = new (std::nothrow) FrameArena();
+
     return true;
 }
 
@@ -198,6 +210,7 @@ Director::~Director(void)
     delete _eventResetDirector;
 
     delete _renderer;
+    delete _frameArena;
 
     delete _console;
     
@@ -324,6 +337,9 @@ void Director::drawScene()
     {
         calculateMPF();
     }
+
+    // everything allocated for this frame has been consumed
+    _frameArena->reset();
 }
 
 void Director::calculateDeltaTime()
@@ -1024,12 +1040,16 @@ void Director::reset()
     SpriteFrameCache::destroyInstance();
     GLProgramCache::destroyInstance();
     GLProgramStateCache::destroyInstance();
+    // writes the values not yet flushed, it needs FileUtils
+    UserDefault::destroyInstance();
     FileUtils::destroyInstance();
     AsyncTaskPool::destroyInstance();
+    WorkerPool::destroyInstance();
+    TweenBatch::destroyInstance();
+    AnimationLOD::destroyInstance();
     spine::SkeletonBatch::destroyInstance();
-    
-    // cocos2d-x specific data structures
-    UserDefault::destroyInstance();
+    spine::SkeletonDataCache::destroyInstance();
+    spine::SkeletonUpdateBatch::destroyInstance();
 
     GL::invalidateStateCache();
 
@@ -1067,6 +1087,8 @@ void Director::restartDirector()
 
     // Reschedule for action manager
     getScheduler()->scheduleUpdate(getActionManager(), Scheduler::PRIORITY_SYSTEM, false);
+    getScheduler()->scheduleUpdate(TweenBatch::getInstance(), Scheduler::PRIORITY_SYSTEM, false);
+    getScheduler()->scheduleUpdate(spine::SkeletonUpdateBatch::getInstance(), spine::SkeletonUpdateBatch::UPDATE_PRIORITY, false);
 
     // release the objects
     PoolManager::getInstance()->getCurrentPool()->clear();
@@ -59,6 +59,7 @@ class EventCustom;
 class EventListenerCustom;
 class TextureCache;
 class Renderer;
+class FrameArena;
 
 class Console;
 namespace experimental
@@ -432,6 +433,12 @@ public:
      */
     Renderer* getRenderer() const { return _renderer; }
 
+    /** Returns the FrameArena of the director.
+     * Its memory is released at the end of every frame, once the scene has been drawn.
+     * @js NA
+     */
+    FrameArena* getFrameArena() const { return _frameArena; }
+
     /** Returns the Console associated with this director.
      * @since v3.0
      * @js NA
@@ -608,6 +615,9 @@ protected:
     /* Renderer for the Director */
     Renderer *_renderer;
 
+    /* per frame memory, reset at the end of drawScene() */
+    FrameArena *_frameArena;
+
     /* Default FrameBufferObject*/
     experimental::FrameBuffer* _defaultFBO;
 
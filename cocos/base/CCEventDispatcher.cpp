@@ -34,6 +34,7 @@
 #include "2d/CCScene.h"
 #include "base/CCDirector.h"
 #include "base/CCEventType.h"
+#include "base/CCFrameArena.h"
 
 #define DUMP_LISTENER_ITEM_PRIORITY_INFO 0
 
@@ -257,7 +258,7 @@ void EventDispatcher::visitTarget(Node* node, bool isRootNode)
 
     if (isRootNode)
     {
-        std::vector<float> globalZOrders;
+        std::vector<float, FrameArenaAllocator<float>> globalZOrders(FrameArenaAllocator<float>(Director::getInstance()->getFrameArena()));
         globalZOrders.reserve(_globalZOrderNodeMap.size());
 
         for (const auto& e : _globalZOrderNodeMap)
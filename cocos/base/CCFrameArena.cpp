@@ -0,0 +1,130 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/CCFrameArena.h"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <stdint.h>
+#include "base/ccMacros.h"
+
+NS_CC_BEGIN
+
+FrameArena::FrameArena(size_t chunkSize)
+: _chunkSize(chunkSize)
+, _currentChunk(0)
+, _offset(0)
+, _usedBytes(0)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    reset();
+    releaseChunks();
+}
+
+void FrameArena::releaseChunks()
+{
+    for (auto& chunk : _chunks)
+    {
+        free(chunk.data);
+    }
+    _chunks.clear();
+    _currentChunk = 0;
+    _offset = 0;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    CCASSERT((alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+
+    while (_currentChunk < _chunks.size())
+    {
+        const Chunk& chunk = _chunks[_currentChunk];
+        uintptr_t address = (uintptr_t)(chunk.data + _offset);
+        size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+        if (_offset + padding + size <= chunk.size)
+        {
+            _offset += padding + size;
+            _usedBytes += size;
+            return (void*)(address + padding);
+        }
+
+        // doesn't fit, try the next chunk
+        ++_currentChunk;
+        _offset = 0;
+    }
+
+    Chunk chunk;
+    chunk.size = std::max(_chunkSize, size + alignment);
+    chunk.data = (char*)malloc(chunk.size);
+    CCASSERT(chunk.data, "FrameArena: not enough memory");
+    _chunks.push_back(chunk);
+    _currentChunk = _chunks.size() - 1;
+
+    uintptr_t address = (uintptr_t)chunk.data;
+    size_t padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+    _offset = padding + size;
+    _usedBytes += size;
+    return (void*)(address + padding);
+}
+
+void FrameArena::reset()
+{
+    for (auto it = _destructors.rbegin(); it != _destructors.rend(); ++it)
+    {
+        it->destroy(it->object);
+    }
+    _destructors.clear();
+
+    // the frame didn't fit in one chunk: merge them, so the next frames do
+    if (_chunks.size() > 1)
+    {
+        size_t capacity = getCapacity();
+        releaseChunks();
+
+        Chunk chunk;
+        chunk.size = capacity;
+        chunk.data = (char*)malloc(chunk.size);
+        CCASSERT(chunk.data, "FrameArena: not enough memory");
+        _chunks.push_back(chunk);
+    }
+
+    _currentChunk = 0;
+    _offset = 0;
+    _usedBytes = 0;
+}
+
+size_t FrameArena::getCapacity() const
+{
+    size_t capacity = 0;
+    for (const auto& chunk : _chunks)
+    {
+        capacity += chunk.size;
+    }
+    return capacity;
+}
+
+NS_CC_END
@@ -0,0 +1,156 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_FRAME_ARENA_H__
+#define __CC_FRAME_ARENA_H__
+
+#include "platform/CCPlatformMacros.h"
+#include <vector>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+/**
+* @addtogroup base
+* @{
+*/
+NS_CC_BEGIN
+
+/**
+ * @class FrameArena
+ * @brief A linear allocator whose memory is released all at once, at the end of the frame.
+ *
+ * The Director owns one (see Director::getFrameArena()) and resets it once the frame has been drawn,
+ * so it can hold render commands, vertex scratch buffers and temporary containers that only live during a frame,
+ * without any malloc/free. Memory is never returned to the system: after a few frames the arena
+ * keeps a single chunk big enough for a whole frame.
+ * @js NA
+ */
+class CC_DLL FrameArena
+{
+public:
+    /** The default size of the chunks of memory. */
+    static const size_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+    /** The default alignment of the allocations. */
+    static const size_t DEFAULT_ALIGNMENT = 16;
+
+    explicit FrameArena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+    ~FrameArena();
+
+    /**
+     * Allocates uninitialized memory, valid until the next reset().
+     * @param size Size in bytes.
+     * @param alignment Power of two alignment of the returned address.
+     */
+    void* allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT);
+
+    /** Allocates an uninitialized array of `count` trivially copyable elements, valid until the next reset(). */
+    template<class T>
+    T* allocateArray(size_t count)
+    {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T) > DEFAULT_ALIGNMENT ? alignof(T) : DEFAULT_ALIGNMENT));
+    }
+
+    /** Constructs an object in the arena. Its destructor is called by the next reset(). */
+    template<class T, class... Args>
+    T* create(Args&&... args)
+    {
+        void* memory = allocate(sizeof(T), alignof(T) > DEFAULT_ALIGNMENT ? alignof(T) : DEFAULT_ALIGNMENT);
+        T* object = new (memory) T(std::forward<Args>(args)...);
+        Destructor destructor = { &FrameArena::destroy<T>, object };
+        _destructors.push_back(destructor);
+        return object;
+    }
+
+    /** Destroys the objects created by create() and makes all the memory available again. */
+    void reset();
+
+    /** Returns the number of bytes allocated since the last reset(). */
+    size_t getUsedBytes() const { return _usedBytes; }
+    /** Returns the number of bytes reserved by the arena. */
+    size_t getCapacity() const;
+
+protected:
+    struct Chunk
+    {
+        char* data;
+        size_t size;
+    };
+    struct Destructor
+    {
+        void (*destroy)(void*);
+        void* object;
+    };
+
+    template<class T>
+    static void destroy(void* object)
+    {
+        static_cast<T*>(object)->~T();
+    }
+
+    void releaseChunks();
+
+    size_t _chunkSize;
+    std::vector<Chunk> _chunks;
+    size_t _currentChunk;
+    size_t _offset;
+    size_t _usedBytes;
+    std::vector<Destructor> _destructors;
+};
+
+/**
+ * An STL allocator drawing from a FrameArena, for temporary containers of the frame.
+ * Deallocation is a no-op, the memory is released by FrameArena::reset().
+ */
+template<class T>
+class FrameArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    explicit FrameArenaAllocator(FrameArena* arena) : _arena(arena) {}
+    template<class U>
+    FrameArenaAllocator(const FrameArenaAllocator<U>& other) : _arena(other.getArena()) {}
+
+    T* allocate(size_t count) { return _arena->allocateArray<T>(count); }
+    void deallocate(T*, size_t) {}
+
+    FrameArena* getArena() const { return _arena; }
+
+    template<class U>
+    struct rebind { typedef FrameArenaAllocator<U> other; };
+
+private:
+    FrameArena* _arena;
+};
+
+template<class T, class U>
+inline bool operator==(const FrameArenaAllocator<T>& a, const FrameArenaAllocator<U>& b) { return a.getArena() == b.getArena(); }
+template<class T, class U>
+inline bool operator!=(const FrameArenaAllocator<T>& a, const FrameArenaAllocator<U>& b) { return a.getArena() != b.getArena(); }
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_FRAME_ARENA_H__
@@ -145,6 +145,7 @@ UserDefault::~UserDefault()
 }
 
 UserDefault::UserDefault()
+: _isDirty(false)
 {
 }
 
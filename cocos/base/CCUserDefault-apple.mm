@@ -143,6 +143,7 @@ UserDefault::~UserDefault()
 }
 
 UserDefault::UserDefault()
+: _isDirty(false)
 {
 }
 
@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include "tinyxml2/tinyxml2.h"
 #include "base/base64.h"
 #include "base/ccUtils.h"
+#include "base/CCDirector.h"
+#include "base/CCScheduler.h"
 
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_IOS && CC_TARGET_PLATFORM != CC_PLATFORM_MAC && CC_TARGET_PLATFORM != CC_PLATFORM_ANDROID)
 
@@ -36,121 +38,120 @@ THE SOFTWARE.
 
 #define XML_FILE_NAME "UserDefault.xml"
 
+// changed values are written back after this delay, so that a burst of changes is written once
+#define FLUSH_DELAY 1.0f
+
+#define FLUSH_SCHEDULE_KEY "UserDefault::flush"
+
 using namespace std;
 
 NS_CC_BEGIN
 
 /**
- * define the functions here because we don't want to
- * export xmlNodePtr and other types in "CCUserDefault.h"
+ * implements of UserDefault
  */
 
-static tinyxml2::XMLElement* getXMLNodeForKey(const char* pKey, tinyxml2::XMLElement** rootNode, tinyxml2::XMLDocument **doc)
+UserDefault* UserDefault::_userDefault = nullptr;
+string UserDefault::_filePath = string("");
+bool UserDefault::_isFilePathInitialized = false;
+
+UserDefault::~UserDefault()
 {
-    tinyxml2::XMLElement* curNode = nullptr;
+    // don't lose the values changed since the last flush
+    flush();
+}
 
-    // check the key value
-    if (! pKey)
-    {
-        return nullptr;
-    }
+UserDefault::UserDefault()
+: _isDirty(false)
+{
+    loadValues();
+}
 
-    do
+void UserDefault::loadValues()
+{
+    _values.clear();
+
+    std::string xmlBuffer = FileUtils::getInstance()->getStringFromFile(getXMLFilePath());
+    if (xmlBuffer.empty())
     {
-         tinyxml2::XMLDocument* xmlDoc = new (std::nothrow) tinyxml2::XMLDocument();
-        *doc = xmlDoc;
+        CCLOG("can not read xml file");
+        return;
+    }
 
-        std::string xmlBuffer = FileUtils::getInstance()->getStringFromFile(UserDefault::getInstance()->getXMLFilePath());
+    tinyxml2::XMLDocument xmlDoc;
+    xmlDoc.Parse(xmlBuffer.c_str(), xmlBuffer.size());
 
-        if (xmlBuffer.empty())
-        {
-            CCLOG("can not read xml file");
-            break;
-        }
-        xmlDoc->Parse(xmlBuffer.c_str(), xmlBuffer.size());
+    tinyxml2::XMLElement* rootNode = xmlDoc.RootElement();
+    if (nullptr == rootNode)
+    {
+        CCLOG("read root node error");
+        return;
+    }
 
-        // get root node
-        *rootNode = xmlDoc->RootElement();
-        if (nullptr == *rootNode)
+    for (tinyxml2::XMLElement* curNode = rootNode->FirstChildElement(); curNode != nullptr; curNode = curNode->NextSiblingElement())
+    {
+        // nodes without content have never been readable, skip them
+        if (curNode->FirstChild())
         {
-            CCLOG("read root node error");
-            break;
+            // keep the first node of a key, as the lookup in the file did
+            _values.emplace(curNode->Value(), curNode->FirstChild()->Value());
         }
-        // find the node
-        curNode = (*rootNode)->FirstChildElement();
-        while (nullptr != curNode)
-        {
-            const char* nodeName = curNode->Value();
-            if (!strcmp(nodeName, pKey))
-            {
-                break;
-            }
+    }
+}
 
-            curNode = curNode->NextSiblingElement();
-        }
-    } while (0);
+const std::string* UserDefault::getValueForKey(const char* key) const
+{
+    if (! key)
+    {
+        return nullptr;
+    }
 
-    return curNode;
+    auto iter = _values.find(key);
+    if (iter == _values.end())
+    {
+        return nullptr;
+    }
+    return &iter->second;
 }
 
-static void setValueForKey(const char* pKey, const char* pValue)
+void UserDefault::setValueForKey(const char* key, const std::string& value)
 {
-     tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
     // check the params
-    if (! pKey || ! pValue)
+    if (! key)
     {
         return;
     }
-    // find the node
-    node = getXMLNodeForKey(pKey, &rootNode, &doc);
-    // if node exist, change the content
-    if (node)
+
+    auto iter = _values.find(key);
+    if (iter != _values.end())
     {
-        if (node->FirstChild())
+        if (iter->second == value)
         {
-            node->FirstChild()->SetValue(pValue);
-        }
-        else
-        {
-            tinyxml2::XMLText* content = doc->NewText(pValue);
-            node->LinkEndChild(content);
+            return;
         }
+        iter->second = value;
     }
     else
     {
-        if (rootNode)
-        {
-            tinyxml2::XMLElement* tmpNode = doc->NewElement(pKey);//new tinyxml2::XMLElement(pKey);
-            rootNode->LinkEndChild(tmpNode);
-            tinyxml2::XMLText* content = doc->NewText(pValue);//new tinyxml2::XMLText(pValue);
-            tmpNode->LinkEndChild(content);
-        }
+        _values.emplace(key, value);
     }
 
-    // save file and free doc
-    if (doc)
-    {
-        doc->SaveFile(FileUtils::getInstance()->getSuitableFOpen(UserDefault::getInstance()->getXMLFilePath()).c_str());
-        delete doc;
-    }
+    _isDirty = true;
+    scheduleFlush();
 }
 
-/**
- * implements of UserDefault
- */
-
-UserDefault* UserDefault::_userDefault = nullptr;
-string UserDefault::_filePath = string("");
-bool UserDefault::_isFilePathInitialized = false;
-
-UserDefault::~UserDefault()
+void UserDefault::scheduleFlush()
 {
-}
+    // ask the scheduler rather than keeping a flag, Director::reset() unschedules everything
+    Scheduler* scheduler = Director::getInstance()->getScheduler();
+    if (scheduler->isScheduled(FLUSH_SCHEDULE_KEY, this))
+    {
+        return;
+    }
 
-UserDefault::UserDefault()
-{
+    scheduler->schedule([this](float){
+        flush();
+    }, this, 0, 0, FLUSH_DELAY, false, FLUSH_SCHEDULE_KEY);
 }
 
 bool UserDefault::getBoolForKey(const char* pKey)
@@ -160,26 +161,15 @@ bool UserDefault::getBoolForKey(const char* pKey)
 
 bool UserDefault::getBoolForKey(const char* pKey, bool defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
-    {
-        value = (const char*)(node->FirstChild()->Value());
-    }
+    const std::string* value = getValueForKey(pKey);
 
     bool ret = defaultValue;
 
     if (value)
     {
-        ret = (! strcmp(value, "true"));
+        ret = (*value == "true");
     }
 
-    if (doc) delete doc;
-
     return ret;
 }
 
@@ -190,30 +180,15 @@ int UserDefault::getIntegerForKey(const char* pKey)
 
 int UserDefault::getIntegerForKey(const char* pKey, int defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
-    {
-        value = (const char*)(node->FirstChild()->Value());
-    }
+    const std::string* value = getValueForKey(pKey);
 
     int ret = defaultValue;
 
     if (value)
     {
-        ret = atoi(value);
+        ret = atoi(value->c_str());
     }
 
-    if(doc)
-    {
-        delete doc;
-    }
-
-
     return ret;
 }
 
@@ -236,26 +211,15 @@ double  UserDefault::getDoubleForKey(const char* pKey)
 
 double UserDefault::getDoubleForKey(const char* pKey, double defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
-    {
-        value = (const char*)(node->FirstChild()->Value());
-    }
+    const std::string* value = getValueForKey(pKey);
 
     double ret = defaultValue;
 
     if (value)
     {
-        ret = utils::atof(value);
+        ret = utils::atof(value->c_str());
     }
 
-    if (doc) delete doc;
-
     return ret;
 }
 
@@ -266,27 +230,14 @@ std::string UserDefault::getStringForKey(const char* pKey)
 
 string UserDefault::getStringForKey(const char* pKey, const std::string & defaultValue)
 {
-    const char* value = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
-    {
-        value = (const char*)(node->FirstChild()->Value());
-    }
-
-    string ret = defaultValue;
+    const std::string* value = getValueForKey(pKey);
 
     if (value)
     {
-        ret = string(value);
+        return *value;
     }
 
-    if (doc) delete doc;
-
-    return ret;
+    return defaultValue;
 }
 
 Data UserDefault::getDataForKey(const char* pKey)
@@ -296,31 +247,20 @@ Data UserDefault::getDataForKey(const char* pKey)
 
 Data UserDefault::getDataForKey(const char* pKey, const Data& defaultValue)
 {
-    const char* encodedData = nullptr;
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-    node =  getXMLNodeForKey(pKey, &rootNode, &doc);
-    // find the node
-    if (node && node->FirstChild())
-    {
-        encodedData = (const char*)(node->FirstChild()->Value());
-    }
+    const std::string* encodedData = getValueForKey(pKey);
 
     Data ret = defaultValue;
 
     if (encodedData)
     {
         unsigned char * decodedData = nullptr;
-        int decodedDataLen = base64Decode((unsigned char*)encodedData, (unsigned int)strlen(encodedData), &decodedData);
+        int decodedDataLen = base64Decode((unsigned char*)encodedData->c_str(), (unsigned int)encodedData->size(), &decodedData);
 
         if (decodedData) {
             ret.fastSet(decodedData, decodedDataLen);
         }
     }
 
-    if (doc) delete doc;
-
     return ret;
 }
 
@@ -384,7 +324,7 @@ void UserDefault::setStringForKey(const char* pKey, const std::string & value)
         return;
     }
 
-    setValueForKey(pKey, value.c_str());
+    setValueForKey(pKey, value);
 }
 
 void UserDefault::setDataForKey(const char* pKey, const Data& value) {
@@ -398,10 +338,11 @@ void UserDefault::setDataForKey(const char* pKey, const Data& value) {
 
     base64Encode(value.getBytes(), static_cast<unsigned int>(value.getSize()), &encodedData);
 
-    setValueForKey(pKey, encodedData);
-
     if (encodedData)
+    {
+        setValueForKey(pKey, encodedData);
         free(encodedData);
+    }
 }
 
 UserDefault* UserDefault::getInstance()
@@ -488,14 +429,46 @@ const string& UserDefault::getXMLFilePath()
 
 void UserDefault::flush()
 {
+    if (! _isDirty)
+    {
+        return;
+    }
+
+    Director::getInstance()->getScheduler()->unschedule(FLUSH_SCHEDULE_KEY, this);
+
+    // same layout as the file created by createXMLFile()
+    tinyxml2::XMLDocument doc;
+    doc.LinkEndChild(doc.NewDeclaration(nullptr));
+    tinyxml2::XMLElement* rootNode = doc.NewElement(USERDEFAULT_ROOT_NAME);
+    doc.LinkEndChild(rootNode);
+
+    for (const auto& value : _values)
+    {
+        tinyxml2::XMLElement* node = doc.NewElement(value.first.c_str());
+        node->LinkEndChild(doc.NewText(value.second.c_str()));
+        rootNode->LinkEndChild(node);
+    }
+
+    tinyxml2::XMLPrinter printer;
+    doc.Print(&printer);
+
+    // write a temporary file and replace the old one with it,
+    // so that the file is never left half written
+    auto fileUtils = FileUtils::getInstance();
+    const std::string tempPath = _filePath + ".tmp";
+    if (!fileUtils->writeStringToFile(printer.CStr(), tempPath)
+        || !fileUtils->renameFile(tempPath, _filePath))
+    {
+        // keep the values dirty, the next flush tries again
+        CCLOG("can not write xml file");
+        return;
+    }
+
+    _isDirty = false;
 }
 
 void UserDefault::deleteValueForKey(const char* key)
 {
-    tinyxml2::XMLElement* rootNode;
-    tinyxml2::XMLDocument* doc;
-    tinyxml2::XMLElement* node;
-
     // check the params
     if (!key)
     {
@@ -503,24 +476,14 @@ void UserDefault::deleteValueForKey(const char* key)
         return;
     }
 
-    // find the node
-    node = getXMLNodeForKey(key, &rootNode, &doc);
-
     // if node not exist, don't need to delete
-    if (!node)
+    if (_values.erase(key) == 0)
     {
         return;
     }
 
-    // save file and free doc
-    if (doc)
-    {
-        doc->DeleteNode(node);
-        doc->SaveFile(FileUtils::getInstance()->getSuitableFOpen(UserDefault::getInstance()->getXMLFilePath()).c_str());
-        delete doc;
-    }
-
-    flush();
+    _isDirty = true;
+    scheduleFlush();
 }
 
 NS_CC_END
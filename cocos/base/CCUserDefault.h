@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include "platform/CCPlatformMacros.h"
 #include <string>
+#include <unordered_map>
 #include "base/CCData.h"
 
 /**
@@ -43,6 +44,10 @@ NS_CC_BEGIN
  *
  * It supports the following base types:
  * bool, int, float, double, string
+ *
+ * On the platforms using the xml file, the file is read once and the values are kept in memory.
+ * Values set by setXXXForKey() are written back to the file shortly after they changed,
+ * or when flush() is invoked.
  */
 class CC_DLL UserDefault
 {
@@ -198,6 +203,7 @@ public:
     virtual void setDataForKey(const char* key, const Data& value);
     /**
      * You should invoke this function to save values set by setXXXForKey().
+     * Otherwise they are saved within a second, and when the instance is destroyed.
      * @js NA
      */
     virtual void flush();
@@ -250,9 +256,18 @@ private:
     static bool createXMLFile();
     static void initXMLFilePath();
 
+    void loadValues();
+    const std::string* getValueForKey(const char* key) const;
+    void setValueForKey(const char* key, const std::string& value);
+    void scheduleFlush();
+
     static UserDefault* _userDefault;
     static std::string _filePath;
     static bool _isFilePathInitialized;
+
+    // values read from the xml file, and not yet saved changes
+    std::unordered_map<std::string, std::string> _values;
+    bool _isDirty;
 };
 
 
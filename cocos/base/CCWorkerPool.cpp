@@ -0,0 +1,170 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "base/CCWorkerPool.h"
+
+#include <algorithm>
+
+NS_CC_BEGIN
+
+// more threads than this doesn't pay off for frame-bound jobs
+static const int MAX_WORKER_COUNT = 7;
+
+WorkerPool* WorkerPool::s_workerPool = nullptr;
+
+WorkerPool* WorkerPool::getInstance()
+{
+    if (s_workerPool == nullptr)
+    {
+        s_workerPool = new (std::nothrow) WorkerPool();
+    }
+    return s_workerPool;
+}
+
+void WorkerPool::destroyInstance()
+{
+    delete s_workerPool;
+    s_workerPool = nullptr;
+}
+
+WorkerPool::WorkerPool()
+: _func(nullptr)
+, _count(0)
+, _rangeSize(0)
+, _nextIndex(0)
+, _busyWorkers(0)
+, _generation(0)
+, _stop(false)
+{
+    // hardware_concurrency() may return 0 when it can't be computed
+    int cores = (int)std::thread::hardware_concurrency();
+    int workerCount = std::min(std::max(cores - 1, 0), MAX_WORKER_COUNT);
+
+    for (int i = 0; i < workerCount; ++i)
+    {
+        _workers.push_back(std::thread(&WorkerPool::workerLoop, this));
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _workCondition.notify_all();
+
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+bool WorkerPool::isWorkerThread() const
+{
+    auto currentId = std::this_thread::get_id();
+    for (const auto& worker : _workers)
+    {
+        if (worker.get_id() == currentId)
+            return true;
+    }
+    return false;
+}
+
+void WorkerPool::parallelFor(ssize_t count, ssize_t minRangeSize, const RangeFunction& func)
+{
+    if (count <= 0)
+        return;
+
+    minRangeSize = std::max(minRangeSize, (ssize_t)1);
+    if (_workers.empty() || count <= minRangeSize || isWorkerThread())
+    {
+        func(0, count);
+        return;
+    }
+
+    std::lock_guard<std::mutex> jobLock(_jobMutex);
+
+    // a few ranges per thread, so that uneven ranges get balanced
+    const ssize_t threadCount = (ssize_t)_workers.size() + 1;
+    const ssize_t rangeSize = std::max(minRangeSize, (count + threadCount * 4 - 1) / (threadCount * 4));
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _func = &func;
+        _count = count;
+        _rangeSize = rangeSize;
+        _nextIndex = 0;
+        _busyWorkers = (int)_workers.size();
+        ++_generation;
+    }
+    _workCondition.notify_all();
+
+    processRanges();
+
+    // the job is referenced by the workers until all of them are done
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCondition.wait(lock, [this]{ return _busyWorkers == 0; });
+    _func = nullptr;
+}
+
+void WorkerPool::processRanges()
+{
+    for (;;)
+    {
+        ssize_t begin = _nextIndex.fetch_add(_rangeSize);
+        if (begin >= _count)
+            break;
+
+        (*_func)(begin, std::min(begin + _rangeSize, _count));
+    }
+}
+
+void WorkerPool::workerLoop()
+{
+    unsigned int lastGeneration = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _workCondition.wait(lock, [this, lastGeneration]{ return _stop || _generation != lastGeneration; });
+            if (_stop)
+                return;
+            lastGeneration = _generation;
+        }
+
+        processRanges();
+
+        bool lastOne = false;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            lastOne = (--_busyWorkers == 0);
+        }
+        if (lastOne)
+            _doneCondition.notify_one();
+    }
+}
+
+NS_CC_END
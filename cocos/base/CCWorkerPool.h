@@ -0,0 +1,115 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_WORKER_POOL_H__
+#define __CC_WORKER_POOL_H__
+
+#include "platform/CCPlatformMacros.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/**
+* @addtogroup base
+* @{
+*/
+NS_CC_BEGIN
+
+/**
+ * @class WorkerPool
+ * @brief A fixed set of worker threads used to split data parallel work (fork/join) across the CPU cores.
+ *
+ * Unlike AsyncTaskPool, the caller blocks until all the work is done, and takes part in it.
+ * It is meant for short, frame-bound jobs like filling vertex buffers.
+ * @js NA
+ */
+class CC_DLL WorkerPool
+{
+public:
+    /** The function which processes the elements in [begin, end). */
+    typedef std::function<void(ssize_t begin, ssize_t end)> RangeFunction;
+
+    /**
+     * Returns the shared instance of the worker pool.
+     */
+    static WorkerPool* getInstance();
+
+    /**
+     * Destroys the worker pool, joining all the worker threads.
+     */
+    static void destroyInstance();
+
+    /**
+     * Returns the number of worker threads, not counting the calling thread.
+     */
+    int getWorkerCount() const { return (int)_workers.size(); }
+
+    /**
+     * Splits [0, count) into ranges of at least `minRangeSize` elements and runs `func` on them,
+     * using the worker threads and the calling thread. Returns once every range has been processed.
+     * When called from a worker thread, or when there is not enough work, `func` is run inline.
+     *
+     * @param count Number of elements to process.
+     * @param minRangeSize Minimum number of elements given to a single call of `func`.
+     * @param func Function processing a range. It must be safe to call it concurrently on disjoint ranges.
+     */
+    void parallelFor(ssize_t count, ssize_t minRangeSize, const RangeFunction& func);
+
+CC_CONSTRUCTOR_ACCESS:
+    WorkerPool();
+    ~WorkerPool();
+
+protected:
+    void workerLoop();
+    void processRanges();
+    bool isWorkerThread() const;
+
+    std::vector<std::thread> _workers;
+
+    // serializes concurrent parallelFor() callers
+    std::mutex _jobMutex;
+
+    std::mutex _mutex;
+    std::condition_variable _workCondition;
+    std::condition_variable _doneCondition;
+
+    // current job
+    const RangeFunction* _func;
+    ssize_t _count;
+    ssize_t _rangeSize;
+    std::atomic<ssize_t> _nextIndex;
+    int _busyWorkers;
+    unsigned int _generation;
+    bool _stop;
+
+    static WorkerPool* s_workerPool;
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_WORKER_POOL_H__
@@ -39,6 +39,8 @@ THE SOFTWARE.
 
 // base
 #include "base/CCAsyncTaskPool.h"
+#include "base/CCWorkerPool.h"
+#include "base/CCFrameArena.h"
 #include "base/CCAutoreleasePool.h"
 #include "base/CCConfiguration.h"
 #include "base/CCConsole.h"
@@ -106,6 +108,8 @@ THE SOFTWARE.
 #include "2d/CCActionTiledGrid.h"
 #include "2d/CCActionTween.h"
 #include "2d/CCTweenFunction.h"
+#include "2d/CCTweenBatch.h"
+#include "2d/CCAnimationLOD.h"
 
 // 2d nodes
 #include "2d/CCAtlasNode.h"
@@ -175,6 +179,7 @@ THE SOFTWARE.
 #include "platform/CCPlatformConfig.h"
 #include "platform/CCPlatformMacros.h"
 #include "platform/CCSAXParser.h"
+#include "platform/CCPlistParser.h"
 #include "platform/CCThread.h"
 
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_IOS)
@@ -216,6 +221,7 @@ THE SOFTWARE.
 #include "2d/CCSpriteBatchNode.h"
 #include "2d/CCSpriteFrame.h"
 #include "2d/CCSpriteFrameCache.h"
+#include "2d/CCSpriteAtlas.h"
 
 // text_input_node
 #include "2d/CCTextFieldTTF.h"
@@ -381,13 +381,35 @@ bool Armature::getArmatureTransformDirty() const
 
 void Armature::update(float dt)
 {
+    // the tweens fire the frame events, the bones only compute the pose
     _animation->update(dt);
 
-    for(const auto &bone : _topBoneList) {
-        bone->update(dt);
+    if (_parentBone != nullptr || AnimationLOD::getInstance()->checkUpdate(_lodState))
+    {
+        for(const auto &bone : _topBoneList) {
+            bone->update(dt);
+        }
+
+        _armatureTransformDirty = false;
+    }
+    else
+    {
+        // the bones update the armatures they display, which would miss this time and its events
+        updateChildAnimations(dt);
     }
+}
 
-    _armatureTransformDirty = false;
+void Armature::updateChildAnimations(float dt)
+{
+    for (const auto& element : _boneDic)
+    {
+        Armature *childArmature = element.second->getChildArmature();
+        if (childArmature)
+        {
+            childArmature->getAnimation()->update(dt);
+            childArmature->updateChildAnimations(dt);
+        }
+    }
 }
 
 void Armature::draw(cocos2d::Renderer *renderer, const Mat4 &transform, uint32_t flags)
@@ -490,6 +512,20 @@ void Armature::visit(cocos2d::Renderer *renderer, const Mat4 &parentTransform, u
 
     uint32_t flags = processParentFlags(parentTransform, parentFlags);
 
+    if (_parentBone == nullptr)
+    {
+        AnimationLOD* lod = AnimationLOD::getInstance();
+        if (lod->isEnabled())
+        {
+            _lodState.bounds = getBonesBoundingBox();
+        }
+
+        if (!lod->checkDraw(_lodState, _modelViewTransform))
+        {
+            return;
+        }
+    }
+
     if (isVisitableByVisitingCamera())
     {
         // IMPORTANT:
@@ -509,6 +545,11 @@ void Armature::visit(cocos2d::Renderer *renderer, const Mat4 &parentTransform, u
 }
 
 Rect Armature::getBoundingBox() const
+{
+    return RectApplyTransform(getBonesBoundingBox(), getNodeToParentTransform());
+}
+
+Rect Armature::getBonesBoundingBox() const
 {
     float minx, miny, maxx, maxy = 0;
 
@@ -546,7 +587,7 @@ Rect Armature::getBoundingBox() const
 
     }
 
-    return RectApplyTransform(boundingBox, getNodeToParentTransform());
+    return boundingBox;
 }
 
 Bone *Armature::getBoneAtPoint(float x, float y) const
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "editor-support/cocostudio/CCArmatureDataManager.h"
 #include "editor-support/cocostudio/CocosStudioExport.h"
 #include "math/CCMath.h"
+#include "2d/CCAnimationLOD.h"
 
 class b2Body;
 struct cpBody;
@@ -220,6 +221,12 @@ protected:
      */
     Bone *createBone(const std::string& boneName );
 
+    // the bounding box of the bones, in the space of the armature
+    cocos2d::Rect getBonesBoundingBox() const;
+
+    // advances the animations of the armatures displayed by the bones, whose pose is kept
+    void updateChildAnimations(float dt);
+
 protected:
     ArmatureData *_armatureData;
 
@@ -241,6 +248,9 @@ protected:
 
     ArmatureAnimation *_animation;
 
+    // the level of detail of the armatures which aren't the display of a bone
+    cocos2d::AnimationLOD::State _lodState;
+
 #if ENABLE_PHYSICS_BOX2D_DETECT
     b2Body *_body;
 #elif ENABLE_PHYSICS_CHIPMUNK_DETECT
@@ -25,6 +25,7 @@
 // parsers
 #include "parsers/DataParser.h"
 #include "parsers/JSONDataParser.h"
+#include "parsers/BinaryDataParser.h"
 
 // factories
 #include "factories/BaseFactory.h"
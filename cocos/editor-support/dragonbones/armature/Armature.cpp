@@ -223,6 +223,16 @@ void Armature::dispose()
 }
 
 void Armature::advanceTime(float passedTime)
+{
+    _advanceTime(passedTime, true);
+}
+
+void Armature::advanceTimeWithoutPose(float passedTime)
+{
+    _advanceTime(passedTime, false);
+}
+
+void Armature::_advanceTime(float passedTime, bool updatePose)
 {
     if (!_animation) 
     {
@@ -250,24 +260,32 @@ void Armature::advanceTime(float passedTime)
     //
     for (const auto bone : _bones)
     {
-        bone->_update(_cacheFrameIndex);
+        if (updatePose)
+        {
+            bone->_update(_cacheFrameIndex);
+        }
+        else
+        {
+            // the dirty flags are kept until the pose is updated, only the blending of the timelines is reset
+            bone->_blendIndex = 0;
+        }
     }
 
     for (const auto slot : _slots)
     {
-        slot->_update(_cacheFrameIndex);
+        if (updatePose)
+        {
+            slot->_update(_cacheFrameIndex);
+        }
+        else
+        {
+            slot->_blendIndex = 0;
+        }
 
         const auto childArmature = slot->getChildArmature();
         if (childArmature)
         {
-            if (slot->inheritAnimation)
-            {
-                childArmature->advanceTime(scaledPassedTime);
-            }
-            else
-            {
-                childArmature->advanceTime(passedTime);
-            }
+            childArmature->_advanceTime(slot->inheritAnimation ? scaledPassedTime : passedTime, updatePose);
         }
     }
 
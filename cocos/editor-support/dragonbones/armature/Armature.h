@@ -61,6 +61,7 @@ private:
     void _sortBones();
     void _sortSlots();
     void _doAction(const ActionData& value);
+    void _advanceTime(float passedTime, bool updatePose);
 
 protected:
     void _onClear() override;
@@ -82,6 +83,11 @@ public:
 public:
     void dispose();
     void advanceTime(float passedTime) override;
+    /**
+     * Advances the animations and dispatches their events, but keeps the current pose:
+     * the bones and the slots are updated by the next advanceTime().
+     */
+    void advanceTimeWithoutPose(float passedTime);
     void invalidUpdate(const std::string& boneName = "", bool updateSlotDisplay = false);
     Slot* getSlot(const std::string& name) const;
     Slot* getSlotByDisplay(void* display) const;
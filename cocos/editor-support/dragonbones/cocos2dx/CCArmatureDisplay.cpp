@@ -1,4 +1,5 @@
 #include "CCArmatureDisplay.h"
+#include "CCSlot.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
@@ -21,6 +22,7 @@ CCArmatureDisplay* CCArmatureDisplay::create()
 CCArmatureDisplay::CCArmatureDisplay() :
     _armature(nullptr),
     _dispatcher(nullptr),
+    _batchEnabled(false),
     _eventCallback(nullptr)
 {
     _dispatcher = new cocos2d::EventDispatcher();
@@ -61,7 +63,14 @@ void CCArmatureDisplay::dispose()
 
 void CCArmatureDisplay::update(float passedTime)
 {
-    _armature->advanceTime(passedTime);
+    if (cocos2d::AnimationLOD::getInstance()->checkUpdate(_lodState))
+    {
+        _armature->advanceTime(passedTime);
+    }
+    else
+    {
+        _armature->advanceTimeWithoutPose(passedTime);
+    }
 }
 
 void CCArmatureDisplay::advanceTimeBySelf(bool on)
@@ -76,6 +85,257 @@ void CCArmatureDisplay::advanceTimeBySelf(bool on)
     }
 }
 
+void CCArmatureDisplay::setBatchEnabled(bool enabled)
+{
+    _batchEnabled = enabled;
+
+    if (_armature)
+    {
+        for (const auto slot : _armature->getSlots())
+        {
+            const auto childArmature = slot->getChildArmature();
+            if (childArmature)
+            {
+                dynamic_cast<CCArmatureDisplay*>(childArmature->_display)->setBatchEnabled(enabled);
+            }
+        }
+    }
+}
+
+void CCArmatureDisplay::visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags)
+{
+    // culled by the AnimationLOD: the slots aren't drawn, the nodes added by the user still are
+    const auto slotsCulled = _visible && _armature && !_checkLOD(parentTransform);
+
+    if ((!_batchEnabled || !_armature) && !slotsCulled)
+    {
+        Node::visit(renderer, parentTransform, parentFlags);
+        return;
+    }
+
+    if (!_visible)
+    {
+        return;
+    }
+
+    uint32_t flags = processParentFlags(parentTransform, parentFlags);
+
+    if (slotsCulled)
+    {
+        _director->pushMatrix(cocos2d::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        _director->loadMatrix(cocos2d::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+        _visitUserChildren(renderer, flags);
+        _director->popMatrix(cocos2d::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+        return;
+    }
+
+    _director->pushMatrix(cocos2d::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+    _director->loadMatrix(cocos2d::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW, _modelViewTransform);
+
+    // the slots are sorted in draw order
+    const auto& slots = _armature->getSlots();
+    for (const auto slot : slots)
+    {
+        const auto ccSlot = static_cast<CCSlot*>(slot);
+        const auto renderDisplay = ccSlot->_getRenderDisplay();
+        if (!renderDisplay || !renderDisplay->isVisible())
+        {
+            continue;
+        }
+
+        const auto frameDisplay = ccSlot->_getFrameDisplay();
+        if (frameDisplay)
+        {
+            if (frameDisplay->getTexture())
+            {
+                _batchSprites.push_back(frameDisplay);
+            }
+        }
+        else
+        {
+            // child armatures and displays set by the user are visited as usual
+            _addBatchCommands(renderer, flags);
+            renderDisplay->visit(renderer, _modelViewTransform, flags);
+        }
+    }
+    _addBatchCommands(renderer, flags);
+
+    _visitUserChildren(renderer, flags);
+
+    _director->popMatrix(cocos2d::MATRIX_STACK_TYPE::MATRIX_STACK_MODELVIEW);
+}
+
+void CCArmatureDisplay::_visitUserChildren(cocos2d::Renderer* renderer, uint32_t flags)
+{
+    // every slot has exactly one display among the children, the others have been added by the user
+    const auto& slots = _armature->getSlots();
+    if (_children.size() <= slots.size())
+    {
+        return;
+    }
+
+    sortAllChildren();
+
+    for (const auto child : _children)
+    {
+        bool isSlotDisplay = false;
+        for (const auto slot : slots)
+        {
+            if (static_cast<CCSlot*>(slot)->_getRenderDisplay() == child)
+            {
+                isSlotDisplay = true;
+                break;
+            }
+        }
+
+        if (!isSlotDisplay)
+        {
+            child->visit(renderer, _modelViewTransform, flags);
+        }
+    }
+}
+
+bool CCArmatureDisplay::_checkLOD(const cocos2d::Mat4& parentTransform)
+{
+    const auto lod = cocos2d::AnimationLOD::getInstance();
+    if (!lod->isEnabled())
+    {
+        return lod->checkDraw(_lodState, parentTransform);
+    }
+
+    // the child armatures are measured with their root, before it is tested
+    if (!_armature->getParent())
+    {
+        _updateLODBounds();
+    }
+
+    return lod->checkDraw(_lodState, parentTransform * this->getNodeToParentTransform());
+}
+
+void CCArmatureDisplay::_updateLODBounds()
+{
+    // the bounds of the current pose
+    cocos2d::Rect bounds;
+    bool hasBounds = false;
+    for (const auto slot : _armature->getSlots())
+    {
+        const auto renderDisplay = static_cast<CCSlot*>(slot)->_getRenderDisplay();
+        if (!renderDisplay || !renderDisplay->isVisible())
+        {
+            continue;
+        }
+
+        cocos2d::Rect displayBounds;
+        const auto childArmature = slot->getChildArmature();
+        const auto childDisplay = childArmature ? dynamic_cast<CCArmatureDisplay*>(childArmature->_display) : nullptr;
+        if (childDisplay && childDisplay->_armature)
+        {
+            childDisplay->_updateLODBounds();
+            displayBounds = cocos2d::RectApplyTransform(childDisplay->_lodState.bounds, childDisplay->getNodeToParentTransform());
+        }
+        else
+        {
+            displayBounds = renderDisplay->getBoundingBox();
+        }
+
+        if (hasBounds)
+        {
+            bounds.merge(displayBounds);
+        }
+        else
+        {
+            bounds = displayBounds;
+            hasBounds = true;
+        }
+    }
+
+    _lodState.bounds = bounds;
+}
+
+void CCArmatureDisplay::_addBatchCommands(cocos2d::Renderer* renderer, uint32_t flags)
+{
+    const auto count = _batchSprites.size();
+    if (count == 0)
+    {
+        return;
+    }
+
+    // the renderer reads the vertices when the frame is drawn
+    const auto arena = _director->getFrameArena();
+
+    std::size_t begin = 0;
+    while (begin < count)
+    {
+        const auto first = _batchSprites[begin];
+        // the texture, not its name, so that the alpha texture of ETC1 textures is bound too
+        const auto texture = first->getTexture();
+        const auto glProgramState = first->getGLProgramState();
+        const auto& blendFunc = first->getBlendFunc();
+        const auto globalZOrder = first->getGlobalZOrder();
+
+        // a run of sprites which can be drawn by the same command
+        const auto& firstTriangles = first->getPolygonInfo().triangles;
+        int vertCount = firstTriangles.vertCount;
+        int indexCount = firstTriangles.indexCount;
+        std::size_t end = begin + 1;
+        for (; end < count; ++end)
+        {
+            const auto sprite = _batchSprites[end];
+            const auto& triangles = sprite->getPolygonInfo().triangles;
+            if (sprite->getTexture() != texture || sprite->getGLProgramState() != glProgramState ||
+                sprite->getBlendFunc() != blendFunc || sprite->getGlobalZOrder() != globalZOrder ||
+                vertCount + triangles.vertCount > cocos2d::Renderer::VBO_SIZE ||
+                indexCount + triangles.indexCount > cocos2d::Renderer::INDEX_VBO_SIZE)
+            {
+                break;
+            }
+
+            vertCount += triangles.vertCount;
+            indexCount += triangles.indexCount;
+        }
+
+        cocos2d::TrianglesCommand::Triangles batchTriangles;
+        batchTriangles.verts = arena->allocateArray<cocos2d::V3F_C4B_T2F>(vertCount);
+        batchTriangles.indices = arena->allocateArray<unsigned short>(indexCount);
+        batchTriangles.vertCount = vertCount;
+        batchTriangles.indexCount = indexCount;
+
+        // the vertices are moved from the space of the slot to the space of the armature
+        int vertOffset = 0;
+        int indexOffset = 0;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const auto sprite = _batchSprites[i];
+            const auto& triangles = sprite->getPolygonInfo().triangles;
+            const auto& transform = sprite->getNodeToParentTransform();
+
+            auto verts = batchTriangles.verts + vertOffset;
+            for (int j = 0; j < triangles.vertCount; ++j)
+            {
+                verts[j] = triangles.verts[j];
+                transform.transformPoint(&verts[j].vertices);
+            }
+
+            auto indices = batchTriangles.indices + indexOffset;
+            for (int j = 0; j < triangles.indexCount; ++j)
+            {
+                indices[j] = (unsigned short)(triangles.indices[j] + vertOffset);
+            }
+
+            vertOffset += triangles.vertCount;
+            indexOffset += triangles.indexCount;
+        }
+
+        const auto command = arena->create<cocos2d::TrianglesCommand>();
+        command->init(globalZOrder, texture, glProgramState, blendFunc, batchTriangles, _modelViewTransform, flags);
+        renderer->addCommand(command);
+
+        begin = end;
+    }
+
+    _batchSprites.clear();
+}
+
 void CCArmatureDisplay::addEvent(const std::string& type, const std::function<void(EventObject*)>& callback)
 {
     auto lambda = [callback](cocos2d::EventCustom* event) -> void {
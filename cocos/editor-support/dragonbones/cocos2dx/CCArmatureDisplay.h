@@ -6,6 +6,8 @@
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+class DBCCSprite;
+
 class CCArmatureDisplay : public cocos2d::Node, public virtual IArmatureDisplay
 {
 public:
@@ -18,6 +20,10 @@ public:
 
 protected:
     cocos2d::EventDispatcher* _dispatcher;
+    bool _batchEnabled;
+    // the sprites of the current batch, reused between frames
+    std::vector<DBCCSprite*> _batchSprites;
+    cocos2d::AnimationLOD::State _lodState;
 
 protected:
     CCArmatureDisplay();
@@ -38,6 +44,18 @@ public:
 
 public:
     virtual void advanceTimeBySelf(bool on) override;
+
+    /**
+     * Draws the slots with a few batched commands instead of visiting a sprite per slot.
+     * The vertices of the slots are copied into one buffer, and a command is issued for each run of slots
+     * sharing the same texture, shader, blend function and global z order.
+     * Slots are not culled one by one, and the children which are not slot displays are drawn after the slots.
+     * The child armatures are switched to the same mode. Disabled by default.
+     */
+    void setBatchEnabled(bool enabled);
+    inline bool isBatchEnabled() const { return _batchEnabled; }
+
+    virtual void visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags) override;
     
     void addEvent(const std::string& type, const std::function<void(EventObject*)>& callback);
     void removeEvent(const std::string& type);
@@ -65,6 +83,12 @@ CC_CONSTRUCTOR_ACCESS:
     inline bool hasEventCallback() { return this->_eventCallback ? true : false; }
     inline void clearEventCallback() { this->_eventCallback = nullptr; }
 
+protected:
+    void _addBatchCommands(cocos2d::Renderer* renderer, uint32_t flags);
+    bool _checkLOD(const cocos2d::Mat4& parentTransform);
+    void _visitUserChildren(cocos2d::Renderer* renderer, uint32_t flags);
+    void _updateLODBounds();
+
 private:
     // added for js bindings
     std::function<void(EventObject*)> _eventCallback;
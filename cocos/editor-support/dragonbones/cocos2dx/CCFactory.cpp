@@ -133,14 +133,22 @@ DragonBonesData* CCFactory::loadDragonBonesData(const std::string& filePath, con
     }
 
     const auto fullpath = cocos2d::FileUtils::getInstance()->fullPathForFilename(filePath);
-    const auto data = cocos2d::FileUtils::getInstance()->getStringFromFile(fullpath);
-    if (data.empty())
+    const auto data = cocos2d::FileUtils::getInstance()->getDataFromFile(fullpath);
+    if (data.isNull())
     {
         return nullptr;
     }
 
     const auto scale = cocos2d::Director::getInstance()->getContentScaleFactor();
-    return this->parseDragonBonesData(data.c_str(), dragonBonesName, 1.f / scale);
+
+    // the binary data written by tools/dragonbones-converter is read without any JSON parsing
+    if (BinaryDataParser::isBinaryData(data.getBytes(), (std::size_t)data.getSize()))
+    {
+        return this->parseBinaryDragonBonesData(data.getBytes(), (std::size_t)data.getSize(), dragonBonesName, 1.f / scale);
+    }
+
+    const std::string rawData((const char*)data.getBytes(), (std::size_t)data.getSize());
+    return this->parseDragonBonesData(rawData.c_str(), dragonBonesName, 1.f / scale);
 }
 
 TextureAtlasData* CCFactory::loadTextureAtlasData(const std::string& filePath, const std::string& dragonBonesName, float scale)
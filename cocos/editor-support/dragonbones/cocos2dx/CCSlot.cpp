@@ -18,6 +18,8 @@ void CCSlot::_onClear()
     Slot::_onClear();
 
     _renderDisplay = nullptr;
+    _renderSprite = nullptr;
+    _frameDisplay = nullptr;
 }
 
 void CCSlot::_initDisplay(void* value)
@@ -54,6 +56,18 @@ void CCSlot::_onUpdateDisplay()
     {
         _renderDisplay = static_cast<cocos2d::Node*>(this->_rawDisplay);
     }
+
+    if (!this->_display || this->_display == this->_rawDisplay || this->_display == this->_meshDisplay)
+    {
+        _frameDisplay = static_cast<DBCCSprite*>(this->_display ? this->_display : this->_rawDisplay);
+        _renderSprite = _frameDisplay;
+    }
+    else
+    {
+        // a display set by the user, or a child armature
+        _frameDisplay = nullptr;
+        _renderSprite = this->_childArmature ? nullptr : dynamic_cast<cocos2d::Sprite*>(_renderDisplay);
+    }
 }
 
 void CCSlot::_addDisplay()
@@ -82,7 +96,7 @@ void CCSlot::_updateVisible()
 
 void CCSlot::_updateBlendMode()
 {
-    cocos2d::Sprite* spriteDisplay = dynamic_cast<cocos2d::Sprite*>(_renderDisplay);
+    const auto spriteDisplay = _renderSprite;
     if (spriteDisplay)
     {
         switch (this->_blendMode)
@@ -5,12 +5,19 @@
 #include "cocos2d.h"
 
 DRAGONBONES_NAMESPACE_BEGIN
+
+class DBCCSprite;
+
 class CCSlot : public Slot
 {
     BIND_CLASS_TYPE(CCSlot);
 
 private:
     cocos2d::Node* _renderDisplay;
+    // the render display when it is a sprite, so that the blend mode can be set without a cast
+    cocos2d::Sprite* _renderSprite;
+    // the render display when it is the frame or mesh display created by the factory
+    DBCCSprite* _frameDisplay;
 
 public:
     CCSlot();
@@ -37,6 +44,18 @@ protected:
 public:
     virtual void _updateVisible() override;
     virtual void _updateBlendMode() override;
+
+    /** @private */
+    inline cocos2d::Node* _getRenderDisplay() const
+    {
+        return _renderDisplay;
+    }
+
+    /** @private */
+    inline DBCCSprite* _getFrameDisplay() const
+    {
+        return _frameDisplay;
+    }
 };
 
 DRAGONBONES_NAMESPACE_END
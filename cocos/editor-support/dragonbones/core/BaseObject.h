@@ -34,18 +34,14 @@ public:
     template<typename T>
     static T* borrowObject() 
     {
-        const auto classTypeIndex = T::getTypeIndex();
-        const auto iterator = _poolsMap.find(classTypeIndex);
-        if (iterator != _poolsMap.end())
+        // the pools are never removed from the map, so the pool of each class is only looked up once
+        static auto& pool = _poolsMap[T::getTypeIndex()];
+        if (!pool.empty())
         {
-            auto& pool = iterator->second;
-            if (!pool.empty())
-            {
-                const auto object = dynamic_cast<T*>(pool.back());
-                pool.pop_back();
+            const auto object = dynamic_cast<T*>(pool.back());
+            pool.pop_back();
 
-                return object;
-            }
+            return object;
         }
 
         return new (std::nothrow) T();
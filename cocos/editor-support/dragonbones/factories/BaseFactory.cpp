@@ -3,6 +3,7 @@
 DRAGONBONES_NAMESPACE_BEGIN
 
 JSONDataParser BaseFactory::_defaultDataParser;
+BinaryDataParser BaseFactory::_binaryDataParser;
 
 BaseFactory::BaseFactory() :
     autoSearch(false),
@@ -222,6 +223,14 @@ DragonBonesData* BaseFactory::parseDragonBonesData(const char* rawData, const st
     return dragonBonesData;
 }
 
+DragonBonesData* BaseFactory::parseBinaryDragonBonesData(const unsigned char* data, std::size_t dataLength, const std::string& dragonBonesName, float scale)
+{
+    const auto dragonBonesData = _binaryDataParser.parseDragonBonesData(data, dataLength, scale);
+    addDragonBonesData(dragonBonesData, dragonBonesName);
+
+    return dragonBonesData;
+}
+
 TextureAtlasData* BaseFactory::parseTextureAtlasData(const char* rawData, void* textureAtlas, const std::string& dragonBonesName, float scale)
 {
     const auto textureAtlasData = _generateTextureAtlasData(nullptr, nullptr);
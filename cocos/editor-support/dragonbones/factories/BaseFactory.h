@@ -2,6 +2,7 @@
 #define DRAGONBONES_BASE_FACTORY_H
 
 #include "../parsers/JSONDataParser.h"
+#include "../parsers/BinaryDataParser.h"
 #include "../armature/Armature.h"
 #include "../animation/Animation.h"
 #include "../armature/Bone.h"
@@ -38,6 +39,7 @@ class BaseFactory
 {
 protected:
     static JSONDataParser _defaultDataParser;
+    static BinaryDataParser _binaryDataParser;
 
 public:
     bool autoSearch;
@@ -66,6 +68,8 @@ protected:
 
 public:
     virtual DragonBonesData* parseDragonBonesData(const char* rawData, const std::string& dragonBonesName = "", float scale = 1.f);
+    /** Parses the binary data written by BinaryDataParser::writeDragonBonesData(). */
+    virtual DragonBonesData* parseBinaryDragonBonesData(const unsigned char* data, std::size_t dataLength, const std::string& dragonBonesName = "", float scale = 1.f);
     virtual TextureAtlasData* parseTextureAtlasData(const char* rawData, void* textureAtlas, const std::string& dragonBonesName = "", float scale = 0.f);
     virtual void addDragonBonesData(DragonBonesData* data, const std::string& dragonBonesName = "");
     virtual void removeDragonBonesData(const std::string& dragonBonesName, bool disposeData = true);
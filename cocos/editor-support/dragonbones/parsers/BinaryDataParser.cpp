@@ -0,0 +1,1241 @@
+#include "BinaryDataParser.h"
+
+#include <string.h>
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+static const unsigned char BINARY_DATA_MAGIC[4] = { 'D', 'B', 'B', 'N' };
+static const std::size_t BINARY_DATA_HEADER_SIZE = 16;
+
+/**
+ * @private
+ * Writes the model in the layout read by BinaryDataParser.
+ */
+class BinaryDataWriter final
+{
+public:
+    std::vector<std::uint32_t> words;
+    std::vector<std::string> strings;
+
+private:
+    std::map<std::string, unsigned> _stringIndices;
+    std::map<const BoneData*, unsigned> _boneIndices;
+    std::map<const SlotData*, unsigned> _slotIndices;
+    std::map<const SkinData*, unsigned> _skinIndices;
+
+public:
+    BinaryDataWriter() {}
+    ~BinaryDataWriter() {}
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(BinaryDataWriter);
+
+    void _writeUInt(unsigned value)
+    {
+        words.push_back(value);
+    }
+
+    void _writeInt(int value)
+    {
+        words.push_back((std::uint32_t)value);
+    }
+
+    void _writeFloat(float value)
+    {
+        std::uint32_t word;
+        memcpy(&word, &value, sizeof(word));
+        words.push_back(word);
+    }
+
+    void _writeBool(bool value)
+    {
+        words.push_back(value ? 1 : 0);
+    }
+
+    void _writeString(const std::string& value)
+    {
+        const auto iterator = _stringIndices.find(value);
+        if (iterator != _stringIndices.end())
+        {
+            _writeUInt(iterator->second);
+        }
+        else
+        {
+            const auto index = (unsigned)strings.size();
+            _stringIndices[value] = index;
+            strings.push_back(value);
+            _writeUInt(index);
+        }
+    }
+
+    // the references are written as index + 1, 0 is nullptr
+    template<class T>
+    void _writeReference(const std::map<const T*, unsigned>& indices, const T* value)
+    {
+        const auto iterator = indices.find(value);
+        _writeUInt(iterator != indices.end() ? iterator->second + 1 : 0);
+    }
+
+    void _writeTransform(const Transform& transform)
+    {
+        _writeFloat(transform.x);
+        _writeFloat(transform.y);
+        _writeFloat(transform.skewX);
+        _writeFloat(transform.skewY);
+        _writeFloat(transform.scaleX);
+        _writeFloat(transform.scaleY);
+    }
+
+    void _writeMatrix(const Matrix& matrix)
+    {
+        _writeFloat(matrix.a);
+        _writeFloat(matrix.b);
+        _writeFloat(matrix.c);
+        _writeFloat(matrix.d);
+        _writeFloat(matrix.tx);
+        _writeFloat(matrix.ty);
+    }
+
+    void _writeColor(const ColorTransform* color, const ColorTransform* defaultColor)
+    {
+        _writeBool(color != defaultColor);
+        if (color != defaultColor)
+        {
+            _writeFloat(color->alphaMultiplier);
+            _writeFloat(color->redMultiplier);
+            _writeFloat(color->greenMultiplier);
+            _writeFloat(color->blueMultiplier);
+            _writeInt(color->alphaOffset);
+            _writeInt(color->redOffset);
+            _writeInt(color->greenOffset);
+            _writeInt(color->blueOffset);
+        }
+    }
+
+    void _writeFloats(const std::vector<float>& values)
+    {
+        _writeUInt((unsigned)values.size());
+        for (const auto value : values)
+        {
+            _writeFloat(value);
+        }
+    }
+
+    void _writeActions(const std::vector<ActionData*>& actions)
+    {
+        _writeUInt((unsigned)actions.size());
+        for (const auto action : actions)
+        {
+            const auto& ints = std::get<0>(action->data);
+            const auto& floats = std::get<1>(action->data);
+            const auto& actionStrings = std::get<2>(action->data);
+
+            _writeInt((int)action->type);
+            _writeReference(_boneIndices, (const BoneData*)action->bone);
+            _writeReference(_slotIndices, (const SlotData*)action->slot);
+
+            _writeUInt((unsigned)ints.size());
+            for (const auto value : ints)
+            {
+                _writeInt(value);
+            }
+
+            _writeFloats(floats);
+
+            _writeUInt((unsigned)actionStrings.size());
+            for (const auto& value : actionStrings)
+            {
+                _writeString(value);
+            }
+        }
+    }
+
+    void _writeEvents(const std::vector<EventData*>& events)
+    {
+        _writeUInt((unsigned)events.size());
+        for (const auto event : events)
+        {
+            _writeInt((int)event->type);
+            _writeString(event->name);
+            _writeReference(_boneIndices, (const BoneData*)event->bone);
+            _writeReference(_slotIndices, (const SlotData*)event->slot);
+        }
+    }
+
+    template<class T>
+    void _writeTimeline(const TimelineData<T>& timeline, const std::function<void(const T&)>& frameWriter)
+    {
+        _writeFloat(timeline.scale);
+        _writeFloat(timeline.offset);
+        _writeUInt((unsigned)timeline.frames.size());
+
+        // the entries of a frame are contiguous
+        std::vector<std::pair<const T*, unsigned>> frames;
+        for (const auto frame : timeline.frames)
+        {
+            if (!frames.empty() && frames.back().first == frame)
+            {
+                frames.back().second++;
+            }
+            else
+            {
+                frames.push_back(std::make_pair(frame, 1u));
+            }
+        }
+
+        _writeUInt((unsigned)frames.size());
+        _writeBool(!frames.empty() && frames.back().first->next != nullptr);
+        for (const auto& pair : frames)
+        {
+            _writeUInt(pair.second);
+            frameWriter(*pair.first);
+        }
+    }
+
+    template<class T>
+    void _writeTweenFrame(const TweenFrameData<T>& frame)
+    {
+        _writeFloat(frame.position);
+        _writeFloat(frame.duration);
+        _writeFloat(frame.tweenEasing);
+        _writeFloats(frame.curve);
+    }
+
+    void _writeAnimationFrame(const AnimationFrameData& frame)
+    {
+        _writeFloat(frame.position);
+        _writeFloat(frame.duration);
+        _writeActions(frame.actions);
+        _writeEvents(frame.events);
+    }
+
+    void _writeBoneFrame(const BoneFrameData& frame)
+    {
+        _writeTweenFrame(frame);
+        _writeBool(frame.tweenScale);
+        _writeInt(frame.tweenRotate);
+        _writeReference(_boneIndices, (const BoneData*)frame.parent);
+        _writeTransform(frame.transform);
+        _writeActions(frame.actions);
+        _writeEvents(frame.events);
+    }
+
+    void _writeSlotFrame(const SlotFrameData& frame)
+    {
+        _writeTweenFrame(frame);
+        _writeInt(frame.displayIndex);
+        _writeInt(frame.zOrder);
+        _writeColor(frame.color, &SlotFrameData::DEFAULT_COLOR);
+        _writeActions(frame.actions);
+        _writeEvents(frame.events);
+    }
+
+    void _writeFFDFrame(const ExtensionFrameData& frame)
+    {
+        _writeTweenFrame(frame);
+        _writeInt((int)frame.type);
+        _writeFloats(frame.tweens);
+        _writeFloats(frame.keys);
+        _writeActions(frame.actions);
+        _writeEvents(frame.events);
+    }
+
+    void _writeMesh(const MeshData& mesh)
+    {
+        _writeBool(mesh.skinned);
+        _writeMatrix(mesh.slotPose);
+        _writeFloats(mesh.uvs);
+        _writeFloats(mesh.vertices);
+
+        _writeUInt((unsigned)mesh.vertexIndices.size());
+        for (const auto index : mesh.vertexIndices)
+        {
+            _writeUInt(index);
+        }
+
+        _writeUInt((unsigned)mesh.bones.size());
+        for (const auto bone : mesh.bones)
+        {
+            _writeReference(_boneIndices, (const BoneData*)bone);
+        }
+
+        _writeUInt((unsigned)mesh.inverseBindPose.size());
+        for (const auto& matrix : mesh.inverseBindPose)
+        {
+            _writeMatrix(matrix);
+        }
+
+        // the bones of each vertex
+        _writeUInt((unsigned)mesh.boneIndices.size());
+        for (std::size_t i = 0, l = mesh.boneIndices.size(); i < l; ++i)
+        {
+            const auto& boneIndices = mesh.boneIndices[i];
+            _writeUInt((unsigned)boneIndices.size());
+            for (std::size_t iB = 0, lB = boneIndices.size(); iB < lB; ++iB)
+            {
+                _writeUInt(boneIndices[iB]);
+                _writeFloat(mesh.weights[i][iB]);
+                _writeFloat(mesh.boneVertices[i][iB * 2]);
+                _writeFloat(mesh.boneVertices[i][iB * 2 + 1]);
+            }
+        }
+    }
+
+    void _writeDisplay(const DisplayData& display)
+    {
+        _writeString(display.name);
+        _writeInt((int)display.type);
+        _writeBool(display.isRelativePivot);
+        _writeFloat(display.pivot.x);
+        _writeFloat(display.pivot.y);
+        _writeTransform(display.transform);
+
+        _writeBool(display.mesh != nullptr);
+        if (display.mesh)
+        {
+            _writeMesh(*display.mesh);
+        }
+    }
+
+    void _writeSkin(const SkinData& skin)
+    {
+        _writeString(skin.name);
+        _writeUInt((unsigned)skin.slots.size());
+        for (const auto& pair : skin.slots)
+        {
+            const auto slotDisplayDataSet = pair.second;
+            _writeReference(_slotIndices, (const SlotData*)slotDisplayDataSet->slot);
+            _writeUInt((unsigned)slotDisplayDataSet->displays.size());
+            for (const auto display : slotDisplayDataSet->displays)
+            {
+                _writeDisplay(*display);
+            }
+        }
+    }
+
+    void _writeAnimation(const AnimationData& animation)
+    {
+        _writeString(animation.name);
+        _writeUInt(animation.frameCount);
+        _writeUInt(animation.playTimes);
+        _writeFloat(animation.position);
+        _writeFloat(animation.duration);
+        _writeFloat(animation.fadeInTime);
+        _writeBool(animation.hasAsynchronyTimeline);
+        _writeString(animation.animation ? animation.animation->name : "");
+
+        _writeTimeline<AnimationFrameData>(animation, std::bind(&BinaryDataWriter::_writeAnimationFrame, this, std::placeholders::_1));
+
+        _writeUInt((unsigned)animation.boneTimelines.size());
+        for (const auto& pair : animation.boneTimelines)
+        {
+            const auto timeline = pair.second;
+            _writeReference(_boneIndices, (const BoneData*)timeline->bone);
+            _writeTransform(timeline->originTransform);
+            _writeTimeline<BoneFrameData>(*timeline, std::bind(&BinaryDataWriter::_writeBoneFrame, this, std::placeholders::_1));
+        }
+
+        _writeUInt((unsigned)animation.slotTimelines.size());
+        for (const auto& pair : animation.slotTimelines)
+        {
+            const auto timeline = pair.second;
+            _writeReference(_slotIndices, (const SlotData*)timeline->slot);
+            _writeTimeline<SlotFrameData>(*timeline, std::bind(&BinaryDataWriter::_writeSlotFrame, this, std::placeholders::_1));
+        }
+
+        std::vector<const FFDTimelineData*> ffdTimelines;
+        for (const auto& skinPair : animation.ffdTimelines)
+        {
+            for (const auto& slotPair : skinPair.second)
+            {
+                for (const auto& pair : slotPair.second)
+                {
+                    ffdTimelines.push_back(pair.second);
+                }
+            }
+        }
+
+        _writeUInt((unsigned)ffdTimelines.size());
+        for (const auto timeline : ffdTimelines)
+        {
+            _writeReference(_skinIndices, (const SkinData*)timeline->skin);
+            _writeReference(_slotIndices, (const SlotData*)timeline->slot->slot);
+            _writeUInt((unsigned)timeline->displayIndex);
+            _writeTimeline<ExtensionFrameData>(*timeline, std::bind(&BinaryDataWriter::_writeFFDFrame, this, std::placeholders::_1));
+        }
+    }
+
+    void _writeArmature(ArmatureData& armature)
+    {
+        DRAGONBONES_ASSERT(armature.scale == 1.f, "The data must be parsed with a scale of 1.");
+
+        _boneIndices.clear();
+        _slotIndices.clear();
+        _skinIndices.clear();
+
+        _writeString(armature.name);
+        _writeUInt(armature.frameRate);
+        _writeInt((int)armature.type);
+        _writeFloat(armature.aabb.x);
+        _writeFloat(armature.aabb.y);
+        _writeFloat(armature.aabb.width);
+        _writeFloat(armature.aabb.height);
+
+        // the parents come first
+        const auto& bones = armature.getSortedBones();
+        for (std::size_t i = 0, l = bones.size(); i < l; ++i)
+        {
+            _boneIndices[bones[i]] = (unsigned)i;
+        }
+
+        _writeUInt((unsigned)bones.size());
+        for (const auto bone : bones)
+        {
+            _writeString(bone->name);
+            _writeReference(_boneIndices, (const BoneData*)bone->parent);
+            _writeReference(_boneIndices, (const BoneData*)bone->ik);
+            _writeBool(bone->inheritTranslation);
+            _writeBool(bone->inheritRotation);
+            _writeBool(bone->inheritScale);
+            _writeBool(bone->bendPositive);
+            _writeUInt(bone->chain);
+            _writeInt(bone->chainIndex);
+            _writeFloat(bone->weight);
+            _writeFloat(bone->length);
+            _writeTransform(bone->transform);
+        }
+
+        const auto& slots = armature.getSortedSlots();
+        for (std::size_t i = 0, l = slots.size(); i < l; ++i)
+        {
+            _slotIndices[slots[i]] = (unsigned)i;
+        }
+
+        _writeUInt((unsigned)slots.size());
+        for (const auto slot : slots)
+        {
+            _writeString(slot->name);
+            _writeReference(_boneIndices, (const BoneData*)slot->parent);
+            _writeInt(slot->displayIndex);
+            _writeInt(slot->zOrder);
+            _writeInt((int)slot->blendMode);
+            _writeColor(slot->color, &SlotData::DEFAULT_COLOR);
+            _writeActions(slot->actions);
+        }
+
+        // the default skin and animation are the first ones
+        std::vector<const SkinData*> skins;
+        if (armature.getDefaultSkin())
+        {
+            skins.push_back(armature.getDefaultSkin());
+        }
+
+        for (const auto& pair : armature.skins)
+        {
+            if (pair.second != armature.getDefaultSkin())
+            {
+                skins.push_back(pair.second);
+            }
+        }
+
+        _writeUInt((unsigned)skins.size());
+        for (std::size_t i = 0, l = skins.size(); i < l; ++i)
+        {
+            _skinIndices[skins[i]] = (unsigned)i;
+            _writeSkin(*skins[i]);
+        }
+
+        std::vector<const AnimationData*> animations;
+        if (armature.getDefaultAnimation())
+        {
+            animations.push_back(armature.getDefaultAnimation());
+        }
+
+        for (const auto& pair : armature.animations)
+        {
+            if (pair.second != armature.getDefaultAnimation())
+            {
+                animations.push_back(pair.second);
+            }
+        }
+
+        _writeUInt((unsigned)animations.size());
+        for (const auto animation : animations)
+        {
+            _writeAnimation(*animation);
+        }
+
+        _writeActions(armature.actions);
+    }
+
+public:
+    void writeDragonBonesData(DragonBonesData& data)
+    {
+        _writeString(data.name);
+        _writeUInt(data.frameRate);
+        _writeBool(data.autoSearch);
+
+        const auto& armatureNames = data.getArmatureNames();
+        _writeUInt((unsigned)armatureNames.size());
+        for (const auto& armatureName : armatureNames)
+        {
+            _writeArmature(*data.getArmature(armatureName));
+        }
+    }
+};
+
+bool BinaryDataParser::isBinaryData(const unsigned char* data, std::size_t dataLength)
+{
+    return data && dataLength >= BINARY_DATA_HEADER_SIZE && memcmp(data, BINARY_DATA_MAGIC, sizeof(BINARY_DATA_MAGIC)) == 0;
+}
+
+void BinaryDataParser::writeDragonBonesData(DragonBonesData& data, std::vector<unsigned char>& output)
+{
+    BinaryDataWriter writer;
+    writer.writeDragonBonesData(data);
+
+    std::vector<std::uint32_t> header;
+    header.push_back(0);
+    header.push_back((std::uint32_t)VERSION);
+    header.push_back((std::uint32_t)writer.strings.size());
+    header.push_back(0);
+
+    std::vector<char> strings;
+    for (const auto& value : writer.strings)
+    {
+        header.push_back((std::uint32_t)strings.size());
+        strings.insert(strings.end(), value.begin(), value.end());
+        strings.push_back('\0');
+    }
+
+    strings.resize((strings.size() + 3) & ~(std::size_t)3, '\0');
+    header[3] = (std::uint32_t)strings.size();
+
+    // the values are written in the byte order of the machine, which is little endian on all the supported platforms
+    output.resize(header.size() * 4 + strings.size() + writer.words.size() * 4);
+    auto bytes = output.data();
+    memcpy(bytes, header.data(), header.size() * 4);
+    memcpy(bytes, BINARY_DATA_MAGIC, sizeof(BINARY_DATA_MAGIC));
+    bytes += header.size() * 4;
+
+    if (!strings.empty())
+    {
+        memcpy(bytes, strings.data(), strings.size());
+        bytes += strings.size();
+    }
+
+    if (!writer.words.empty())
+    {
+        memcpy(bytes, writer.words.data(), writer.words.size() * 4);
+    }
+}
+
+BinaryDataParser::BinaryDataParser() :
+    _data(nullptr),
+    _dataLength(0),
+    _position(0),
+    _error(false),
+    _scale(1.f),
+    _armature(nullptr)
+{}
+BinaryDataParser::~BinaryDataParser() {}
+
+unsigned BinaryDataParser::_readUInt()
+{
+    // once an error is found, everything reads as 0 so that the parsing ends quickly
+    if (_error || _position + 4 > _dataLength)
+    {
+        _error = true;
+        return 0;
+    }
+
+    std::uint32_t value;
+    memcpy(&value, _data + _position, sizeof(value));
+    _position += 4;
+
+    return value;
+}
+
+int BinaryDataParser::_readInt()
+{
+    return (int)_readUInt();
+}
+
+float BinaryDataParser::_readFloat()
+{
+    const std::uint32_t word = _readUInt();
+    float value;
+    memcpy(&value, &word, sizeof(value));
+
+    return value;
+}
+
+bool BinaryDataParser::_readBool()
+{
+    return _readUInt() != 0;
+}
+
+const char* BinaryDataParser::_readString()
+{
+    const auto index = _readUInt();
+    if (index >= _strings.size())
+    {
+        _error = true;
+        return "";
+    }
+
+    return _strings[index];
+}
+
+unsigned BinaryDataParser::_readCount()
+{
+    // every element takes at least one value, which keeps corrupted counts from allocating too much
+    const auto count = _readUInt();
+    if (count > (_dataLength - _position) / 4)
+    {
+        _error = true;
+        return 0;
+    }
+
+    return count;
+}
+
+BoneData* BinaryDataParser::_readBone()
+{
+    const auto index = _readUInt();
+    if (index > _bones.size())
+    {
+        _error = true;
+        return nullptr;
+    }
+
+    return index > 0 ? _bones[index - 1] : nullptr;
+}
+
+SlotData* BinaryDataParser::_readSlot()
+{
+    const auto index = _readUInt();
+    if (index > _slots.size())
+    {
+        _error = true;
+        return nullptr;
+    }
+
+    return index > 0 ? _slots[index - 1] : nullptr;
+}
+
+void BinaryDataParser::_readTransform(Transform& transform, bool scaled)
+{
+    const auto scale = scaled ? _scale : 1.f;
+    transform.x = _readFloat() * scale;
+    transform.y = _readFloat() * scale;
+    transform.skewX = _readFloat();
+    transform.skewY = _readFloat();
+    transform.scaleX = _readFloat();
+    transform.scaleY = _readFloat();
+}
+
+void BinaryDataParser::_readMatrix(Matrix& matrix, bool scaled)
+{
+    const auto scale = scaled ? _scale : 1.f;
+    matrix.a = _readFloat();
+    matrix.b = _readFloat();
+    matrix.c = _readFloat();
+    matrix.d = _readFloat();
+    matrix.tx = _readFloat() * scale;
+    matrix.ty = _readFloat() * scale;
+}
+
+void BinaryDataParser::_readColor(ColorTransform& color)
+{
+    color.alphaMultiplier = _readFloat();
+    color.redMultiplier = _readFloat();
+    color.greenMultiplier = _readFloat();
+    color.blueMultiplier = _readFloat();
+    color.alphaOffset = _readInt();
+    color.redOffset = _readInt();
+    color.greenOffset = _readInt();
+    color.blueOffset = _readInt();
+}
+
+void BinaryDataParser::_readFloats(std::vector<float>& values, float scale)
+{
+    const auto count = _readCount();
+    values.resize(count);
+
+    for (unsigned i = 0; i < count; ++i)
+    {
+        values[i] = _readFloat() * scale;
+    }
+}
+
+bool BinaryDataParser::_readStringTable()
+{
+    _position = 8;
+    const auto stringCount = _readCount();
+    const auto stringsSize = _readUInt();
+    if (_error || stringCount * 4 + (std::size_t)stringsSize > _dataLength - _position)
+    {
+        return false;
+    }
+
+    const auto strings = (const char*)(_data + _position + stringCount * 4);
+    if (stringsSize > 0 && strings[stringsSize - 1] != '\0')
+    {
+        return false;
+    }
+
+    _strings.resize(stringCount);
+    for (unsigned i = 0; i < stringCount; ++i)
+    {
+        const auto offset = _readUInt();
+        if (offset >= stringsSize)
+        {
+            return false;
+        }
+
+        _strings[i] = strings + offset;
+    }
+
+    _position += stringsSize;
+
+    return true;
+}
+
+ArmatureData* BinaryDataParser::_parseArmature()
+{
+    const auto armature = BaseObject::borrowObject<ArmatureData>();
+    armature->name = _readString();
+    armature->frameRate = _readUInt();
+    armature->type = (ArmatureType)_readInt();
+    armature->aabb.x = _readFloat();
+    armature->aabb.y = _readFloat();
+    armature->aabb.width = _readFloat();
+    armature->aabb.height = _readFloat();
+    armature->scale = _scale;
+
+    _armature = armature;
+
+    // the bones and the slots are referenced by their index, so they are all created first
+    const auto boneCount = _readCount();
+    _bones.reserve(boneCount);
+    for (unsigned i = 0; i < boneCount; ++i)
+    {
+        _bones.push_back(BaseObject::borrowObject<BoneData>());
+    }
+
+    for (unsigned i = 0; i < boneCount; ++i)
+    {
+        _parseBone(*_bones[i]);
+    }
+
+    for (const auto bone : _bones)
+    {
+        if (_error || bone->name.empty() || armature->getBone(bone->name))
+        {
+            _error = true;
+            bone->returnToPool();
+        }
+        else
+        {
+            armature->addBone(bone);
+        }
+    }
+
+    const auto slotCount = _readCount();
+    _slots.reserve(slotCount);
+    for (unsigned i = 0; i < slotCount; ++i)
+    {
+        _slots.push_back(BaseObject::borrowObject<SlotData>());
+    }
+
+    for (unsigned i = 0; i < slotCount; ++i)
+    {
+        _parseSlot(*_slots[i]);
+    }
+
+    for (const auto slot : _slots)
+    {
+        if (_error || slot->name.empty() || armature->getSlot(slot->name))
+        {
+            _error = true;
+            slot->returnToPool();
+        }
+        else
+        {
+            armature->addSlot(slot);
+        }
+    }
+
+    const auto skinCount = _readCount();
+    _skins.reserve(skinCount);
+    for (unsigned i = 0; i < skinCount && !_error; ++i)
+    {
+        const auto skin = _parseSkin();
+        if (_error || skin->name.empty() || armature->getSkin(skin->name))
+        {
+            _error = true;
+            skin->returnToPool();
+            break;
+        }
+
+        armature->addSkin(skin);
+        _skins.push_back(skin);
+    }
+
+    // an animation can reference any other animation of the armature
+    std::vector<std::pair<AnimationData*, std::string>> animationReferences;
+    const auto animationCount = _readCount();
+    for (unsigned i = 0; i < animationCount && !_error; ++i)
+    {
+        const char* referencedAnimationName = "";
+        const auto animation = _parseAnimation(referencedAnimationName);
+        if (_error || animation->name.empty() || armature->getAnimation(animation->name))
+        {
+            _error = true;
+            animation->returnToPool();
+            break;
+        }
+
+        armature->addAnimation(animation);
+
+        if (referencedAnimationName[0] != '\0')
+        {
+            animationReferences.push_back(std::make_pair(animation, std::string(referencedAnimationName)));
+        }
+    }
+
+    for (const auto& pair : animationReferences)
+    {
+        pair.first->animation = armature->getAnimation(pair.second);
+    }
+
+    _parseActions(armature->actions);
+
+    _armature = nullptr;
+    _bones.clear();
+    _slots.clear();
+    _skins.clear();
+
+    return armature;
+}
+
+void BinaryDataParser::_parseBone(BoneData& bone)
+{
+    bone.name = _readString();
+    bone.parent = _readBone();
+    bone.ik = _readBone();
+    bone.inheritTranslation = _readBool();
+    bone.inheritRotation = _readBool();
+    bone.inheritScale = _readBool();
+    bone.bendPositive = _readBool();
+    bone.chain = _readUInt();
+    bone.chainIndex = _readInt();
+    bone.weight = _readFloat();
+    bone.length = _readFloat() * _scale;
+    _readTransform(bone.transform, true);
+}
+
+void BinaryDataParser::_parseSlot(SlotData& slot)
+{
+    slot.name = _readString();
+    slot.parent = _readBone();
+    slot.displayIndex = _readInt();
+    slot.zOrder = _readInt();
+    slot.blendMode = (BlendMode)_readInt();
+
+    if (_readBool())
+    {
+        slot.color = SlotData::generateColor();
+        _readColor(*slot.color);
+    }
+    else
+    {
+        slot.color = &SlotData::DEFAULT_COLOR;
+    }
+
+    _parseActions(slot.actions);
+}
+
+SkinData* BinaryDataParser::_parseSkin()
+{
+    const auto skin = BaseObject::borrowObject<SkinData>();
+    skin->name = _readString();
+
+    const auto slotCount = _readCount();
+    for (unsigned i = 0; i < slotCount && !_error; ++i)
+    {
+        const auto slotDisplayDataSet = BaseObject::borrowObject<SlotDisplayDataSet>();
+        slotDisplayDataSet->slot = _readSlot();
+
+        const auto displayCount = _readCount();
+        auto& displays = slotDisplayDataSet->displays;
+        displays.reserve(displayCount);
+        for (unsigned iD = 0; iD < displayCount; ++iD)
+        {
+            displays.push_back(_parseDisplay());
+        }
+
+        if (_error || !slotDisplayDataSet->slot || skin->getSlot(slotDisplayDataSet->slot->name))
+        {
+            _error = true;
+            slotDisplayDataSet->returnToPool();
+            break;
+        }
+
+        skin->addSlot(slotDisplayDataSet);
+    }
+
+    return skin;
+}
+
+DisplayData* BinaryDataParser::_parseDisplay()
+{
+    const auto display = BaseObject::borrowObject<DisplayData>();
+    display->name = _readString();
+    display->type = (DisplayType)_readInt();
+    display->isRelativePivot = _readBool();
+
+    // the absolute pivots of the old data versions are scaled
+    const auto pivotScale = display->isRelativePivot ? 1.f : _scale;
+    display->pivot.x = _readFloat() * pivotScale;
+    display->pivot.y = _readFloat() * pivotScale;
+    _readTransform(display->transform, true);
+
+    if (_readBool())
+    {
+        display->mesh = _parseMesh();
+    }
+
+    return display;
+}
+
+MeshData* BinaryDataParser::_parseMesh()
+{
+    const auto mesh = BaseObject::borrowObject<MeshData>();
+    mesh->skinned = _readBool();
+    _readMatrix(mesh->slotPose, true);
+    _readFloats(mesh->uvs, 1.f);
+    _readFloats(mesh->vertices, _scale);
+
+    const auto indexCount = _readCount();
+    mesh->vertexIndices.resize(indexCount);
+    for (unsigned i = 0; i < indexCount; ++i)
+    {
+        mesh->vertexIndices[i] = (unsigned short)_readUInt();
+    }
+
+    const auto boneCount = _readCount();
+    mesh->bones.resize(boneCount);
+    for (unsigned i = 0; i < boneCount; ++i)
+    {
+        mesh->bones[i] = _readBone();
+    }
+
+    const auto inverseBindPoseCount = _readCount();
+    mesh->inverseBindPose.resize(inverseBindPoseCount);
+    for (unsigned i = 0; i < inverseBindPoseCount; ++i)
+    {
+        _readMatrix(mesh->inverseBindPose[i], true);
+    }
+
+    const auto vertexCount = _readCount();
+    mesh->boneIndices.resize(vertexCount);
+    mesh->weights.resize(vertexCount);
+    mesh->boneVertices.resize(vertexCount);
+    for (unsigned i = 0; i < vertexCount; ++i)
+    {
+        const auto vertexBoneCount = _readCount();
+        auto& boneIndices = mesh->boneIndices[i];
+        auto& weights = mesh->weights[i];
+        auto& boneVertices = mesh->boneVertices[i];
+        boneIndices.resize(vertexBoneCount);
+        weights.resize(vertexBoneCount);
+        boneVertices.resize(vertexBoneCount * 2);
+
+        for (unsigned iB = 0; iB < vertexBoneCount; ++iB)
+        {
+            boneIndices[iB] = (unsigned short)_readUInt();
+            weights[iB] = _readFloat();
+            boneVertices[iB * 2] = _readFloat() * _scale;
+            boneVertices[iB * 2 + 1] = _readFloat() * _scale;
+
+            if (boneIndices[iB] >= boneCount)
+            {
+                _error = true;
+            }
+        }
+    }
+
+    return mesh;
+}
+
+AnimationData* BinaryDataParser::_parseAnimation(const char*& referencedAnimationName)
+{
+    const auto animation = BaseObject::borrowObject<AnimationData>();
+    animation->name = _readString();
+    animation->frameCount = _readUInt();
+    animation->playTimes = _readUInt();
+    animation->position = _readFloat();
+    animation->duration = _readFloat();
+    animation->fadeInTime = _readFloat();
+    animation->hasAsynchronyTimeline = _readBool();
+    referencedAnimationName = _readString();
+
+    _parseTimeline<AnimationFrameData>(*animation, std::bind(&BinaryDataParser::_parseAnimationFrame, this));
+
+    const auto boneTimelineCount = _readCount();
+    for (unsigned i = 0; i < boneTimelineCount && !_error; ++i)
+    {
+        const auto timeline = _parseBoneTimeline();
+        if (_error || !timeline->bone)
+        {
+            _error = true;
+            timeline->returnToPool();
+            break;
+        }
+
+        animation->addBoneTimeline(timeline);
+    }
+
+    const auto slotTimelineCount = _readCount();
+    for (unsigned i = 0; i < slotTimelineCount && !_error; ++i)
+    {
+        const auto timeline = _parseSlotTimeline();
+        if (_error || !timeline->slot)
+        {
+            _error = true;
+            timeline->returnToPool();
+            break;
+        }
+
+        animation->addSlotTimeline(timeline);
+    }
+
+    const auto ffdTimelineCount = _readCount();
+    for (unsigned i = 0; i < ffdTimelineCount && !_error; ++i)
+    {
+        const auto timeline = _parseFFDTimeline();
+        if (_error || !timeline->slot)
+        {
+            _error = true;
+            timeline->returnToPool();
+            break;
+        }
+
+        animation->addFFDTimeline(timeline);
+    }
+
+    return animation;
+}
+
+BoneTimelineData* BinaryDataParser::_parseBoneTimeline()
+{
+    const auto timeline = BaseObject::borrowObject<BoneTimelineData>();
+    timeline->bone = _readBone();
+    _readTransform(timeline->originTransform, true);
+
+    _parseTimeline<BoneFrameData>(*timeline, std::bind(&BinaryDataParser::_parseBoneFrame, this));
+
+    return timeline;
+}
+
+SlotTimelineData* BinaryDataParser::_parseSlotTimeline()
+{
+    const auto timeline = BaseObject::borrowObject<SlotTimelineData>();
+    timeline->slot = _readSlot();
+
+    _parseTimeline<SlotFrameData>(*timeline, std::bind(&BinaryDataParser::_parseSlotFrame, this));
+
+    return timeline;
+}
+
+FFDTimelineData* BinaryDataParser::_parseFFDTimeline()
+{
+    const auto timeline = BaseObject::borrowObject<FFDTimelineData>();
+    const auto skinIndex = _readUInt();
+    const auto slot = _readSlot();
+    timeline->displayIndex = _readUInt();
+
+    if (skinIndex > 0 && skinIndex <= _skins.size() && slot)
+    {
+        timeline->skin = _skins[skinIndex - 1];
+        timeline->slot = timeline->skin->getSlot(slot->name);
+    }
+
+    _parseTimeline<ExtensionFrameData>(*timeline, std::bind(&BinaryDataParser::_parseFFDFrame, this));
+
+    return timeline;
+}
+
+AnimationFrameData* BinaryDataParser::_parseAnimationFrame()
+{
+    const auto frame = BaseObject::borrowObject<AnimationFrameData>();
+    frame->position = _readFloat();
+    frame->duration = _readFloat();
+    _parseActions(frame->actions);
+    _parseEvents(frame->events);
+
+    return frame;
+}
+
+BoneFrameData* BinaryDataParser::_parseBoneFrame()
+{
+    const auto frame = BaseObject::borrowObject<BoneFrameData>();
+    _parseTweenFrame(*frame);
+    frame->tweenScale = _readBool();
+    frame->tweenRotate = _readInt();
+    frame->parent = _readBone();
+    _readTransform(frame->transform, true);
+    _parseActions(frame->actions);
+    _parseEvents(frame->events);
+
+    return frame;
+}
+
+SlotFrameData* BinaryDataParser::_parseSlotFrame()
+{
+    const auto frame = BaseObject::borrowObject<SlotFrameData>();
+    _parseTweenFrame(*frame);
+    frame->displayIndex = _readInt();
+    frame->zOrder = _readInt();
+
+    if (_readBool())
+    {
+        frame->color = SlotFrameData::generateColor();
+        _readColor(*frame->color);
+    }
+    else
+    {
+        frame->color = &SlotFrameData::DEFAULT_COLOR;
+    }
+
+    _parseActions(frame->actions);
+    _parseEvents(frame->events);
+
+    return frame;
+}
+
+ExtensionFrameData* BinaryDataParser::_parseFFDFrame()
+{
+    const auto frame = BaseObject::borrowObject<ExtensionFrameData>();
+    _parseTweenFrame(*frame);
+    frame->type = (ExtensionType)_readInt();
+    _readFloats(frame->tweens, _scale);
+    _readFloats(frame->keys, 1.f);
+    _parseActions(frame->actions);
+    _parseEvents(frame->events);
+
+    return frame;
+}
+
+void BinaryDataParser::_parseActions(std::vector<ActionData*>& actions)
+{
+    const auto actionCount = _readCount();
+    actions.reserve(actions.size() + actionCount);
+
+    for (unsigned i = 0; i < actionCount; ++i)
+    {
+        const auto action = BaseObject::borrowObject<ActionData>();
+        auto& ints = std::get<0>(action->data);
+        auto& floats = std::get<1>(action->data);
+        auto& strings = std::get<2>(action->data);
+
+        action->type = (ActionType)_readInt();
+        action->bone = _readBone();
+        action->slot = _readSlot();
+
+        const auto intCount = _readCount();
+        ints.resize(intCount);
+        for (unsigned iI = 0; iI < intCount; ++iI)
+        {
+            ints[iI] = _readInt();
+        }
+
+        _readFloats(floats, 1.f);
+
+        const auto stringCount = _readCount();
+        strings.reserve(stringCount);
+        for (unsigned iS = 0; iS < stringCount; ++iS)
+        {
+            strings.push_back(_readString());
+        }
+
+        actions.push_back(action);
+    }
+}
+
+void BinaryDataParser::_parseEvents(std::vector<EventData*>& events)
+{
+    const auto eventCount = _readCount();
+    events.reserve(events.size() + eventCount);
+
+    for (unsigned i = 0; i < eventCount; ++i)
+    {
+        const auto event = BaseObject::borrowObject<EventData>();
+        event->type = (EventType)_readInt();
+        event->name = _readString();
+        event->bone = _readBone();
+        event->slot = _readSlot();
+        events.push_back(event);
+    }
+}
+
+DragonBonesData* BinaryDataParser::parseDragonBonesData(const unsigned char* data, std::size_t dataLength, float scale)
+{
+    if (!isBinaryData(data, dataLength))
+    {
+        DRAGONBONES_ASSERT(false, "Argument error.");
+        return nullptr;
+    }
+
+    _data = data;
+    _dataLength = dataLength;
+    _position = 4;
+    _error = false;
+    _scale = scale;
+
+    DragonBonesData* dragonBonesData = nullptr;
+
+    if (_readUInt() != VERSION)
+    {
+        DRAGONBONES_ASSERT(false, "Nonsupport data version.");
+    }
+    else if (_readStringTable())
+    {
+        dragonBonesData = BaseObject::borrowObject<DragonBonesData>();
+        dragonBonesData->name = _readString();
+        dragonBonesData->frameRate = _readUInt();
+        dragonBonesData->autoSearch = _readBool();
+
+        const auto armatureCount = _readCount();
+        for (unsigned i = 0; i < armatureCount && !_error; ++i)
+        {
+            const auto armature = _parseArmature();
+            if (_error)
+            {
+                armature->returnToPool();
+                break;
+            }
+
+            dragonBonesData->addArmature(armature);
+        }
+
+        if (_error)
+        {
+            dragonBonesData->returnToPool();
+            dragonBonesData = nullptr;
+
+            DRAGONBONES_ASSERT(false, "Invalid binary data.");
+        }
+    }
+
+    _data = nullptr;
+    _dataLength = 0;
+    _position = 0;
+    _strings.clear();
+
+    return dragonBonesData;
+}
+
+DRAGONBONES_NAMESPACE_END
@@ -0,0 +1,170 @@
+#ifndef DRAGONBONES_BINARY_DATA_PARSER_H
+#define DRAGONBONES_BINARY_DATA_PARSER_H
+
+#include "../core/DragonBones.h"
+#include "../model/DragonBonesData.h"
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+/**
+ * Reads the binary DragonBones data (.dbbin) written by writeDragonBonesData(), see tools/dragonbones-converter.
+ *
+ * The binary data holds the model built by JSONDataParser, once the old data versions have been converted,
+ * the global transforms made local, the curves sampled and the frame actions and events merged,
+ * so that it is read without any JSON parsing, name lookup or conversion.
+ * All the values are 32 bit little endian integers or floats:
+ * - header: "DBBN" magic, version, number of strings, size of the string table
+ * - string table: the offset of each string, then the NUL terminated strings, padded to 4 bytes
+ * - the data, in the order of the model. Strings are referenced by their index, bones, slots and skins by their index
+ *   in the armature. The frames shared by several entries of a timeline are stored once, with their number of entries.
+ *
+ * The data is written with a scale of 1, the lengths and positions are scaled when it is read.
+ */
+class BinaryDataParser final
+{
+public:
+    static const unsigned VERSION = 1;
+    /** One entry per frame of the animation, this is more than 12 hours at 24 fps. */
+    static const unsigned MAX_TIMELINE_ENTRIES = 1 << 20;
+
+    /** Returns whether the data starts with the binary data magic. */
+    static bool isBinaryData(const unsigned char* data, std::size_t dataLength);
+
+    /**
+     * Converts DragonBones data, parsed with a scale of 1, into binary data.
+     * @param data The data, as returned by JSONDataParser::parseDragonBonesData().
+     * @param output Receives the binary data.
+     */
+    static void writeDragonBonesData(DragonBonesData& data, std::vector<unsigned char>& output);
+
+private:
+    const unsigned char* _data;
+    std::size_t _dataLength;
+    std::size_t _position;
+    bool _error;
+    float _scale;
+
+    std::vector<const char*> _strings;
+    ArmatureData* _armature;
+    std::vector<BoneData*> _bones;
+    std::vector<SlotData*> _slots;
+    std::vector<SkinData*> _skins;
+
+public:
+    BinaryDataParser();
+    ~BinaryDataParser();
+
+private:
+    DRAGONBONES_DISALLOW_COPY_AND_ASSIGN(BinaryDataParser);
+
+    unsigned _readUInt();
+    int _readInt();
+    float _readFloat();
+    bool _readBool();
+    const char* _readString();
+    unsigned _readCount();
+    BoneData* _readBone();
+    SlotData* _readSlot();
+    void _readTransform(Transform& transform, bool scaled);
+    void _readMatrix(Matrix& matrix, bool scaled);
+    void _readColor(ColorTransform& color);
+    void _readFloats(std::vector<float>& values, float scale);
+
+    bool _readStringTable();
+    ArmatureData* _parseArmature();
+    void _parseBone(BoneData& bone);
+    void _parseSlot(SlotData& slot);
+    SkinData* _parseSkin();
+    DisplayData* _parseDisplay();
+    MeshData* _parseMesh();
+    AnimationData* _parseAnimation(const char*& referencedAnimationName);
+    BoneTimelineData* _parseBoneTimeline();
+    SlotTimelineData* _parseSlotTimeline();
+    FFDTimelineData* _parseFFDTimeline();
+    void _parseActions(std::vector<ActionData*>& actions);
+    void _parseEvents(std::vector<EventData*>& events);
+    AnimationFrameData* _parseAnimationFrame();
+    BoneFrameData* _parseBoneFrame();
+    SlotFrameData* _parseSlotFrame();
+    ExtensionFrameData* _parseFFDFrame();
+
+    template<class T>
+    void _parseTweenFrame(TweenFrameData<T>& frame)
+    {
+        frame.position = _readFloat();
+        frame.duration = _readFloat();
+        frame.tweenEasing = _readFloat();
+        _readFloats(frame.curve, 1.f);
+    }
+
+    template<class T>
+    void _parseTimeline(TimelineData<T>& timeline, const std::function<T*()>& frameParser)
+    {
+        timeline.scale = _readFloat();
+        timeline.offset = _readFloat();
+
+        // the frames are stored once, with the number of entries they take in the timeline
+        const auto entryCount = _readUInt();
+        const auto frameCount = _readCount();
+        const auto looped = _readBool();
+        if (_error || entryCount < frameCount || entryCount > MAX_TIMELINE_ENTRIES)
+        {
+            _error = true;
+            return;
+        }
+
+        timeline.frames.reserve(entryCount);
+
+        T* firstFrame = nullptr;
+        T* prevFrame = nullptr;
+        for (unsigned i = 0; i < frameCount && !_error; ++i)
+        {
+            const auto repeatCount = _readUInt();
+            const auto frame = frameParser();
+            if (repeatCount == 0 || timeline.frames.size() + repeatCount > entryCount)
+            {
+                frame->returnToPool();
+                _error = true;
+                break;
+            }
+
+            timeline.frames.insert(timeline.frames.end(), repeatCount, frame);
+
+            if (prevFrame)
+            {
+                prevFrame->next = frame;
+                frame->prev = prevFrame;
+            }
+            else
+            {
+                firstFrame = frame;
+            }
+
+            prevFrame = frame;
+        }
+
+        if (!_error && timeline.frames.size() != entryCount)
+        {
+            _error = true;
+        }
+
+        // the last frame of the timelines built from several frames is linked to the first one
+        if (!_error && looped && prevFrame)
+        {
+            prevFrame->next = firstFrame;
+            firstFrame->prev = prevFrame;
+        }
+    }
+
+public:
+    /**
+     * Parses binary data.
+     * @param data The binary data, it is not referenced once the function returns.
+     * @param scale The scale of the lengths and positions, as for JSONDataParser::parseDragonBonesData().
+     * @return nullptr if the data is not valid.
+     */
+    DragonBonesData* parseDragonBonesData(const unsigned char* data, std::size_t dataLength, float scale = 1.f);
+};
+
+DRAGONBONES_NAMESPACE_END
+#endif // DRAGONBONES_BINARY_DATA_PARSER_H
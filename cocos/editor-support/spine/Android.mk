@@ -33,6 +33,8 @@ RegionAttachment.c \
 Skeleton.c \
 SkeletonAnimation.cpp \
 SkeletonBatch.cpp \
+SkeletonDataCache.cpp \
+SkeletonUpdateBatch.cpp \
 SkeletonBinary.c \
 SkeletonBounds.c \
 SkeletonData.c \
@@ -44,6 +44,8 @@ void _spAnimationState_disposeTrackEntry (spTrackEntry* entry);
 void _spAnimationState_disposeTrackEntries (spAnimationState* state, spTrackEntry* entry);
 void _spAnimationState_updateMixingFrom (spAnimationState* self, spTrackEntry* entry, float delta);
 float _spAnimationState_applyMixingFrom (spAnimationState* self, spTrackEntry* entry, spSkeleton* skeleton);
+void _spAnimationState_applyMixingFromEvents (spAnimationState* self, spTrackEntry* entry, spSkeleton* skeleton);
+void _spAnimationState_applyEventTimelines (spAnimationState* self, spTrackEntry* entry, spSkeleton* skeleton, float animationTime);
 void _spAnimationState_applyRotateTimeline (spAnimationState* self, spTimeline* timeline, spSkeleton* skeleton, float time, float alpha, int /*boolean*/ setupPose, float* timelinesRotation, int i, int /*boolean*/ firstFrame);
 void _spAnimationState_queueEvents (spAnimationState* self, spTrackEntry* entry, float animationTime);
 void _spAnimationState_setCurrent (spAnimationState* self, int index, spTrackEntry* current, int /*boolean*/ interrupt);
@@ -423,6 +425,66 @@ float _spAnimationState_applyMixingFrom (spAnimationState* self, spTrackEntry* e
 	return mix;
 }
 
+void spAnimationState_applyEvents (spAnimationState* self, spSkeleton* skeleton) {
+	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
+	spTrackEntry* current;
+	int i, n;
+	float animationTime;
+
+	if (internal->animationsChanged) _spAnimationState_animationsChanged(self);
+
+	for (i = 0, n = self->tracksCount; i < n; i++) {
+		current = self->tracks[i];
+		if (!current || current->delay > 0) continue;
+
+		if (current->mixingFrom) _spAnimationState_applyMixingFromEvents(self, current, skeleton);
+
+		animationTime = spTrackEntry_getAnimationTime(current);
+		_spAnimationState_applyEventTimelines(self, current, skeleton, animationTime);
+		_spAnimationState_queueEvents(self, current, animationTime);
+		internal->eventsCount = 0;
+		current->nextAnimationLast = animationTime;
+		current->nextTrackLast = current->trackTime;
+	}
+
+	_spEventQueue_drain(internal->queue);
+}
+
+void _spAnimationState_applyMixingFromEvents (spAnimationState* self, spTrackEntry* entry, spSkeleton* skeleton) {
+	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
+	float mix;
+	float animationTime;
+
+	spTrackEntry* from = entry->mixingFrom;
+	if (from->mixingFrom) _spAnimationState_applyMixingFromEvents(self, from, skeleton);
+
+	if (entry->mixDuration == 0)
+		mix = 1;
+	else {
+		mix = entry->mixTime / entry->mixDuration;
+		if (mix > 1) mix = 1;
+	}
+
+	animationTime = spTrackEntry_getAnimationTime(from);
+	if (mix < from->eventThreshold) _spAnimationState_applyEventTimelines(self, from, skeleton, animationTime);
+
+	if (entry->mixDuration > 0) _spAnimationState_queueEvents(self, from, animationTime);
+	internal->eventsCount = 0;
+	from->nextAnimationLast = animationTime;
+	from->nextTrackLast = from->trackTime;
+}
+
+void _spAnimationState_applyEventTimelines (spAnimationState* self, spTrackEntry* entry, spSkeleton* skeleton, float animationTime) {
+	_spAnimationState* internal = SUB_CAST(_spAnimationState, self);
+	int i, n;
+	spTimeline** timelines = entry->animation->timelines;
+
+	for (i = 0, n = entry->animation->timelinesCount; i < n; i++) {
+		if (timelines[i]->type == SP_TIMELINE_EVENT)
+			spTimeline_apply(timelines[i], skeleton, entry->animationLast, animationTime, internal->events, &internal->eventsCount, 1, 1, 0);
+	}
+}
+
 void _spAnimationState_applyRotateTimeline (spAnimationState* self, spTimeline* timeline, spSkeleton* skeleton, float time, float alpha, int /*boolean*/ setupPose, float* timelinesRotation, int i, int /*boolean*/ firstFrame) {
 	spRotateTimeline *rotateTimeline;
 	float *frames;
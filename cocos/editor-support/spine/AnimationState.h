@@ -113,6 +113,8 @@ void spAnimationState_dispose (spAnimationState* self);
 
 void spAnimationState_update (spAnimationState* self, float delta);
 void spAnimationState_apply (spAnimationState* self, struct spSkeleton* skeleton);
+/* Fires the events and the listener notifications spAnimationState_apply would, without posing the skeleton. */
+void spAnimationState_applyEvents (spAnimationState* self, struct spSkeleton* skeleton);
 
 void spAnimationState_clearTracks (spAnimationState* self);
 void spAnimationState_clearTrack (spAnimationState* self, int trackIndex);
@@ -156,6 +158,7 @@ typedef spAnimationState AnimationState;
 #define AnimationState_dispose(...) spAnimationState_dispose(__VA_ARGS__)
 #define AnimationState_update(...) spAnimationState_update(__VA_ARGS__)
 #define AnimationState_apply(...) spAnimationState_apply(__VA_ARGS__)
+#define AnimationState_applyEvents(...) spAnimationState_applyEvents(__VA_ARGS__)
 #define AnimationState_clearTracks(...) spAnimationState_clearTracks(__VA_ARGS__)
 #define AnimationState_clearTrack(...) spAnimationState_clearTrack(__VA_ARGS__)
 #define AnimationState_setAnimationByName(...) spAnimationState_setAnimationByName(__VA_ARGS__)
@@ -31,6 +31,8 @@
 #include <spine/SkeletonAnimation.h>
 #include <spine/spine-cocos2dx.h>
 #include <spine/extension.h>
+#include <spine/SkeletonDataCache.h>
+#include <spine/SkeletonUpdateBatch.h>
 #include <algorithm>
 
 USING_NS_CC;
@@ -85,8 +87,7 @@ SkeletonAnimation* SkeletonAnimation::createWithJsonFile (const std::string& ske
 
 SkeletonAnimation* SkeletonAnimation::createWithJsonFile (const std::string& skeletonJsonFile, const std::string& atlasFile, float scale) {
 	SkeletonAnimation* node = new SkeletonAnimation();
-	spAtlas* atlas = spAtlas_createFromFile(atlasFile.c_str(), 0);
-	node->initWithJsonFile(skeletonJsonFile, atlas, scale);
+	node->initWithJsonFile(skeletonJsonFile, atlasFile, scale);
 	node->autorelease();
 	return node;
 }
@@ -100,8 +101,7 @@ SkeletonAnimation* SkeletonAnimation::createWithBinaryFile (const std::string& s
 
 SkeletonAnimation* SkeletonAnimation::createWithBinaryFile (const std::string& skeletonBinaryFile, const std::string& atlasFile, float scale) {
 	SkeletonAnimation* node = new SkeletonAnimation();
-	spAtlas* atlas = spAtlas_createFromFile(atlasFile.c_str(), 0);
-	node->initWithBinaryFile(skeletonBinaryFile, atlas, scale);
+	node->initWithBinaryFile(skeletonBinaryFile, atlasFile, scale);
 	node->autorelease();
 	return node;
 }
@@ -110,12 +110,16 @@ SkeletonAnimation* SkeletonAnimation::createWithBinaryFile (const std::string& s
 void SkeletonAnimation::initialize () {
 	super::initialize();
 
-	_ownsAnimationStateData = true;
-	_state = spAnimationState_create(spAnimationStateData_create(_skeleton->data));
+	spAnimationStateData* sharedStateData = _cachedSkeletonData ? SkeletonDataCache::getInstance()->getAnimationStateData(_skeleton->data) : 0;
+	_ownsAnimationStateData = !sharedStateData;
+	_state = spAnimationState_create(sharedStateData ? sharedStateData : spAnimationStateData_create(_skeleton->data));
 	_state->rendererObject = this;
 	_state->listener = animationCallback;
 
 	_spAnimationState* stateInternal = (_spAnimationState*)_state;
+
+	_evaluatePose = true;
+	_batchIndex = -1;
 }
 
 SkeletonAnimation::SkeletonAnimation ()
@@ -143,12 +147,50 @@ SkeletonAnimation::~SkeletonAnimation () {
 }
 
 void SkeletonAnimation::update (float deltaTime) {
+	// on the main thread, even when the pose is updated by the batch
+	bool evaluatePose = AnimationLOD::getInstance()->checkUpdate(_lodState);
+
+	SkeletonUpdateBatch* batch = SkeletonUpdateBatch::getInstance();
+	if (batch->isEnabled()) {
+		// already queued by another update of this frame, the pose is evaluated if one of them needs it
+		_evaluatePose = evaluatePose || (_batchIndex >= 0 && _evaluatePose);
+		batch->addSkeleton(this, deltaTime);
+		return;
+	}
+	_evaluatePose = evaluatePose;
+
+	super::update(deltaTime);
+
+	deltaTime *= _timeScale;
+	spAnimationState_update(_state, deltaTime);
+	applyAnimationState();
+}
+
+void SkeletonAnimation::updatePose (float deltaTime) {
+	// no listener is called here, this may run on a worker thread
+	_spAnimationState* stateInternal = SUB_CAST(_spAnimationState, _state);
+	stateInternal->queue->drainDisabled = 1;
+
 	super::update(deltaTime);
 
 	deltaTime *= _timeScale;
 	spAnimationState_update(_state, deltaTime);
-	spAnimationState_apply(_state, _skeleton);
-	spSkeleton_updateWorldTransform(_skeleton);
+	applyAnimationState();
+}
+
+void SkeletonAnimation::applyAnimationState () {
+	if (_evaluatePose) {
+		spAnimationState_apply(_state, _skeleton);
+		spSkeleton_updateWorldTransform(_skeleton);
+	} else {
+		spAnimationState_applyEvents(_state, _skeleton);
+	}
+}
+
+void SkeletonAnimation::fireQueuedEvents () {
+	_spAnimationState* stateInternal = SUB_CAST(_spAnimationState, _state);
+	stateInternal->queue->drainDisabled = 0;
+	_spEventQueue_drain(stateInternal->queue);
 }
 
 void SkeletonAnimation::setAnimationStateData (spAnimationStateData* stateData) {
@@ -164,6 +206,13 @@ void SkeletonAnimation::setAnimationStateData (spAnimationStateData* stateData)
 }
 
 void SkeletonAnimation::setMix (const std::string& fromAnimation, const std::string& toAnimation, float duration) {
+	if (_cachedSkeletonData && _state->data == SkeletonDataCache::getInstance()->getAnimationStateData(_skeleton->data)) {
+		// the mixes of this skeleton don't apply to the other ones sharing the data
+		spAnimationStateData* stateData = spAnimationStateData_create(_skeleton->data);
+		stateData->defaultMix = _state->data->defaultMix;
+		CONST_CAST(spAnimationStateData*, _state->data) = stateData;
+		_ownsAnimationStateData = true;
+	}
 	spAnimationStateData_setMixByName(_state->data, fromAnimation.c_str(), toAnimation.c_str(), duration);
 }
 
@@ -106,9 +106,19 @@ CC_CONSTRUCTOR_ACCESS:
 	virtual void initialize () override;
 
 protected:
+	/* Updates the animation state and the pose like update(), but queues the events until fireQueuedEvents(). */
+	void updatePose (float deltaTime);
+	void fireQueuedEvents ();
+	/* Applies the animation state, or only fires its events when the AnimationLOD keeps the pose. */
+	void applyAnimationState ();
+
 	spAnimationState* _state;
 
 	bool _ownsAnimationStateData;
+	// whether the pose is evaluated by the current update, see AnimationLOD
+	bool _evaluatePose;
+	// the index of the skeleton in the queue of the SkeletonUpdateBatch, -1 if it isn't queued
+	int _batchIndex;
 
 	StartListener _startListener;
     InterruptListener _interruptListener;
@@ -119,6 +129,8 @@ protected:
 
 private:
 	typedef SkeletonRenderer super;
+
+	friend class SkeletonUpdateBatch;
 };
 
 }
@@ -0,0 +1,251 @@
+/******************************************************************************
+ * Spine Runtimes Software License v2.5
+ *
+ * Copyright (c) 2013-2016, Esoteric Software
+ * All rights reserved.
+ *
+ * You are granted a perpetual, non-exclusive, non-sublicensable, and
+ * non-transferable license to use, install, execute, and perform the Spine
+ * Runtimes software and derivative works solely for personal or internal
+ * use. Without the written permission of Esoteric Software (see Section 2 of
+ * the Spine Software License Agreement), you may not (a) modify, translate,
+ * adapt, or develop new applications using the Spine Runtimes or otherwise
+ * create derivative works or improvements of the Spine Runtimes or (b) remove,
+ * delete, alter, or obscure any trademarks or any copyright, trademark, patent,
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES, BUSINESS INTERRUPTION, OR LOSS OF
+ * USE, DATA, OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonDataCache.h>
+#include <spine/extension.h>
+#include <spine/Cocos2dAttachmentLoader.h>
+
+USING_NS_CC;
+
+namespace spine {
+
+    static SkeletonDataCache* instance = nullptr;
+
+    // what the runtime allocates and doesn't free while a skeleton data is loaded
+    static std::unordered_map<void*, size_t>* loadAllocations = nullptr;
+    static size_t loadBytes = 0;
+
+    // the allocators installed by the application, which do the allocations
+    static void* (*previousMalloc) (size_t size) = nullptr;
+    static void* (*previousDebugMalloc) (size_t size, const char* file, int line) = nullptr;
+    static void* (*previousRealloc) (void* ptr, size_t size) = nullptr;
+    static void (*previousFree) (void* ptr) = nullptr;
+
+    static void countAllocation (void* ptr, size_t size) {
+        (*loadAllocations)[ptr] = size;
+        loadBytes += size;
+    }
+
+    static void uncountAllocation (void* ptr) {
+        auto it = loadAllocations->find(ptr);
+        if (it != loadAllocations->end()) {
+            loadBytes -= it->second;
+            loadAllocations->erase(it);
+        }
+    }
+
+    static void* countingMalloc (size_t size, const char* file, int line) {
+        void* ptr = previousDebugMalloc ? previousDebugMalloc(size, file, line) : previousMalloc(size);
+        if (ptr) countAllocation(ptr, size);
+        return ptr;
+    }
+
+    static void* countingRealloc (void* ptr, size_t size) {
+        void* newPtr = previousRealloc(ptr, size);
+        // on failure the block is left untouched, unless it was a free
+        if (ptr && (newPtr || size == 0)) uncountAllocation(ptr);
+        if (newPtr) countAllocation(newPtr, size);
+        return newPtr;
+    }
+
+    static void countingFree (void* ptr) {
+        uncountAllocation(ptr);
+        previousFree(ptr);
+    }
+
+    SkeletonDataCache* SkeletonDataCache::getInstance () {
+        if (!instance) instance = new SkeletonDataCache();
+        return instance;
+    }
+
+    void SkeletonDataCache::destroyInstance () {
+        if (!instance) return;
+
+        // the skeleton data still used by skeletons are disposed when they are released
+        for (auto it = instance->_entries.begin(); it != instance->_entries.end();) {
+            Entry* entry = it->second;
+            if (entry->references > 0) {
+                ++it;
+                continue;
+            }
+            instance->_entriesByData.erase(entry->skeletonData);
+            it = instance->_entries.erase(it);
+            instance->dispose(entry);
+        }
+
+        if (instance->_entries.empty()) {
+            delete instance;
+            instance = nullptr;
+        } else {
+            instance->_isDestroyed = true;
+        }
+    }
+
+    SkeletonDataCache::SkeletonDataCache ()
+    : _hits(0)
+    , _misses(0)
+    , _isDestroyed(false)
+    {
+    }
+
+    SkeletonDataCache::~SkeletonDataCache () {
+        for (auto& item : _entries) {
+            dispose(item.second);
+        }
+    }
+
+    spSkeletonData* SkeletonDataCache::retainSkeletonData (const std::string& skeletonDataFile, const std::string& atlasFile, float scale, bool binary) {
+        FileUtils* fileUtils = FileUtils::getInstance();
+        std::string key = fileUtils->fullPathForFilename(skeletonDataFile) + "|" + fileUtils->fullPathForFilename(atlasFile) + "|" + StringUtils::format("%g", scale);
+
+        Entry* entry = nullptr;
+        auto it = _entries.find(key);
+        if (it != _entries.end()) {
+            entry = it->second;
+            ++_hits;
+        } else {
+            entry = load(key, skeletonDataFile, atlasFile, scale, binary);
+            if (!entry) return 0;
+            ++_misses;
+            _entries[key] = entry;
+            _entriesByData[entry->skeletonData] = entry;
+        }
+
+        ++entry->references;
+        return entry->skeletonData;
+    }
+
+    void SkeletonDataCache::releaseSkeletonData (spSkeletonData* skeletonData) {
+        auto it = _entriesByData.find(skeletonData);
+        CCASSERT(it != _entriesByData.end(), "The skeleton data is not cached.");
+        if (it == _entriesByData.end()) return;
+
+        Entry* entry = it->second;
+        if (--entry->references > 0) return;
+
+        _entriesByData.erase(it);
+        _entries.erase(entry->key);
+        dispose(entry);
+
+        // destroyInstance() was called while skeletons were still using the cache
+        if (_isDestroyed && _entries.empty()) {
+            instance = nullptr;
+            delete this;
+        }
+    }
+
+    spAnimationStateData* SkeletonDataCache::getAnimationStateData (spSkeletonData* skeletonData) const {
+        auto it = _entriesByData.find(skeletonData);
+        return it != _entriesByData.end() ? it->second->stateData : 0;
+    }
+
+    SkeletonDataCache::Stats SkeletonDataCache::getStats () const {
+        Stats stats;
+        stats.hits = _hits;
+        stats.misses = _misses;
+        stats.entries = (int)_entries.size();
+        stats.references = 0;
+        stats.dataBytes = 0;
+        for (auto& item : _entries) {
+            stats.references += item.second->references;
+            stats.dataBytes += item.second->dataBytes;
+        }
+        return stats;
+    }
+
+    SkeletonDataCache::Entry* SkeletonDataCache::load (const std::string& key, const std::string& skeletonDataFile, const std::string& atlasFile, float scale, bool binary) {
+        // the allocators are wrapped while loading, so that the allocations are counted for the stats
+        std::unordered_map<void*, size_t> allocations;
+        loadAllocations = &allocations;
+        loadBytes = 0;
+        previousMalloc = _getMalloc();
+        previousDebugMalloc = _getDebugMalloc();
+        previousRealloc = _getRealloc();
+        previousFree = _getFree();
+        _setDebugMalloc(countingMalloc);
+        _setRealloc(countingRealloc);
+        _setFree(countingFree);
+
+        spAtlas* atlas = spAtlas_createFromFile(atlasFile.c_str(), 0);
+        spAttachmentLoader* attachmentLoader = nullptr;
+        spSkeletonData* skeletonData = nullptr;
+        if (atlas) {
+            attachmentLoader = SUPER(Cocos2dAttachmentLoader_create(atlas));
+            if (binary) {
+                spSkeletonBinary* skeletonBinary = spSkeletonBinary_createWithLoader(attachmentLoader);
+                skeletonBinary->scale = scale;
+                skeletonData = spSkeletonBinary_readSkeletonDataFile(skeletonBinary, skeletonDataFile.c_str());
+                if (!skeletonData) CCLOG("Spine: %s", skeletonBinary->error ? skeletonBinary->error : "Error reading skeleton data file.");
+                spSkeletonBinary_dispose(skeletonBinary);
+            } else {
+                spSkeletonJson* json = spSkeletonJson_createWithLoader(attachmentLoader);
+                json->scale = scale;
+                skeletonData = spSkeletonJson_readSkeletonDataFile(json, skeletonDataFile.c_str());
+                if (!skeletonData) CCLOG("Spine: %s", json->error ? json->error : "Error reading skeleton data file.");
+                spSkeletonJson_dispose(json);
+            }
+        } else {
+            CCLOG("Spine: Error reading atlas file: %s", atlasFile.c_str());
+        }
+
+        spAnimationStateData* stateData = skeletonData ? spAnimationStateData_create(skeletonData) : 0;
+
+        _setDebugMalloc(previousDebugMalloc);
+        _setRealloc(previousRealloc);
+        _setFree(previousFree);
+        loadAllocations = nullptr;
+
+        if (!skeletonData) {
+            if (attachmentLoader) spAttachmentLoader_dispose(attachmentLoader);
+            if (atlas) spAtlas_dispose(atlas);
+            return nullptr;
+        }
+
+        Entry* entry = new Entry();
+        entry->key = key;
+        entry->atlas = atlas;
+        entry->attachmentLoader = attachmentLoader;
+        entry->skeletonData = skeletonData;
+        entry->stateData = stateData;
+        entry->references = 0;
+        entry->dataBytes = loadBytes;
+        return entry;
+    }
+
+    void SkeletonDataCache::dispose (Entry* entry) {
+        spAnimationStateData_dispose(entry->stateData);
+        // the attachments are disposed through the loader, which must outlive them
+        spSkeletonData_dispose(entry->skeletonData);
+        spAttachmentLoader_dispose(entry->attachmentLoader);
+        spAtlas_dispose(entry->atlas);
+        delete entry;
+    }
+
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Spine Runtimes Software License v2.5
+ *
+ * Copyright (c) 2013-2016, Esoteric Software
+ * All rights reserved.
+ *
+ * You are granted a perpetual, non-exclusive, non-sublicensable, and
+ * non-transferable license to use, install, execute, and perform the Spine
+ * Runtimes software and derivative works solely for personal or internal
+ * use. Without the written permission of Esoteric Software (see Section 2 of
+ * the Spine Software License Agreement), you may not (a) modify, translate,
+ * adapt, or develop new applications using the Spine Runtimes or otherwise
+ * create derivative works or improvements of the Spine Runtimes or (b) remove,
+ * delete, alter, or obscure any trademarks or any copyright, trademark, patent,
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES, BUSINESS INTERRUPTION, OR LOSS OF
+ * USE, DATA, OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONDATACACHE_H_
+#define SPINE_SKELETONDATACACHE_H_
+
+#include <spine/spine.h>
+#include "cocos2d.h"
+#include <string>
+#include <unordered_map>
+
+namespace spine {
+
+    /* Shares the skeleton data, atlas and animation state data loaded from the same files between the skeletons.
+     * The shared data must not be modified, SkeletonAnimation::setMix() gives the skeleton its own animation state data. */
+    class SkeletonDataCache {
+    public:
+        struct Stats {
+            /* Number of skeleton data returned from the cache. */
+            int hits;
+            /* Number of skeleton data loaded from the files. */
+            int misses;
+            /* Number of skeleton data in the cache. */
+            int entries;
+            /* Number of skeletons using the cached data. */
+            int references;
+            /* Memory allocated by the runtime for the cached skeleton data and atlases, the textures are not included. */
+            size_t dataBytes;
+        };
+
+        static SkeletonDataCache* getInstance ();
+
+        /* Disposes the cached data. The data still used by skeletons are kept until they are released,
+         * the cache is deleted with the last of them and getInstance() keeps returning it until then. */
+        static void destroyInstance ();
+
+        /* Returns the skeleton data of the file, loading it with its atlas the first time.
+         * Each call must be balanced by releaseSkeletonData(). Returns 0 if the files can't be read. */
+        spSkeletonData* retainSkeletonData (const std::string& skeletonDataFile, const std::string& atlasFile, float scale, bool binary);
+
+        /* Releases a skeleton data returned by retainSkeletonData(), it is disposed when no skeleton uses it anymore. */
+        void releaseSkeletonData (spSkeletonData* skeletonData);
+
+        /* Returns the animation state data shared by the skeletons using a cached skeleton data, or 0 if the skeleton data is not cached. */
+        spAnimationStateData* getAnimationStateData (spSkeletonData* skeletonData) const;
+
+        Stats getStats () const;
+
+    protected:
+        struct Entry {
+            std::string key;
+            spAtlas* atlas;
+            spAttachmentLoader* attachmentLoader;
+            spSkeletonData* skeletonData;
+            spAnimationStateData* stateData;
+            int references;
+            size_t dataBytes;
+        };
+
+        SkeletonDataCache ();
+        virtual ~SkeletonDataCache ();
+
+        Entry* load (const std::string& key, const std::string& skeletonDataFile, const std::string& atlasFile, float scale, bool binary);
+        void dispose (Entry* entry);
+
+        std::unordered_map<std::string, Entry*> _entries;
+        std::unordered_map<spSkeletonData*, Entry*> _entriesByData;
+        int _hits;
+        int _misses;
+        // destroyInstance() was called, the cache is deleted once the last entry is released
+        bool _isDestroyed;
+    };
+
+}
+
+#endif // SPINE_SKELETONDATACACHE_H_
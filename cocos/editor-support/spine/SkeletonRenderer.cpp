@@ -31,6 +31,7 @@
 #include <spine/SkeletonRenderer.h>
 #include <spine/extension.h>
 #include <spine/SkeletonBatch.h>
+#include <spine/SkeletonDataCache.h>
 #include <spine/AttachmentVertices.h>
 #include <spine/Cocos2dAttachmentLoader.h>
 #include <algorithm>
@@ -74,27 +75,29 @@ void SkeletonRenderer::setSkeletonData (spSkeletonData *skeletonData, bool ownsS
 }
 
 SkeletonRenderer::SkeletonRenderer ()
-	: _atlas(nullptr), _attachmentLoader(nullptr), _debugSlots(false), _debugBones(false), _timeScale(1) {
+	: _atlas(nullptr), _attachmentLoader(nullptr), _cachedSkeletonData(false), _debugSlots(false), _debugBones(false), _timeScale(1) {
 }
 
 SkeletonRenderer::SkeletonRenderer (spSkeletonData *skeletonData, bool ownsSkeletonData)
-	: _atlas(nullptr), _attachmentLoader(nullptr), _debugSlots(false), _debugBones(false), _timeScale(1) {
+	: _atlas(nullptr), _attachmentLoader(nullptr), _cachedSkeletonData(false), _debugSlots(false), _debugBones(false), _timeScale(1) {
 	initWithData(skeletonData, ownsSkeletonData);
 }
 
 SkeletonRenderer::SkeletonRenderer (const std::string& skeletonDataFile, spAtlas* atlas, float scale)
-	: _atlas(nullptr), _attachmentLoader(nullptr), _debugSlots(false), _debugBones(false), _timeScale(1) {
+	: _atlas(nullptr), _attachmentLoader(nullptr), _cachedSkeletonData(false), _debugSlots(false), _debugBones(false), _timeScale(1) {
 	initWithJsonFile(skeletonDataFile, atlas, scale);
 }
 
 SkeletonRenderer::SkeletonRenderer (const std::string& skeletonDataFile, const std::string& atlasFile, float scale)
-	: _atlas(nullptr), _attachmentLoader(nullptr), _debugSlots(false), _debugBones(false), _timeScale(1) {
+	: _atlas(nullptr), _attachmentLoader(nullptr), _cachedSkeletonData(false), _debugSlots(false), _debugBones(false), _timeScale(1) {
 	initWithJsonFile(skeletonDataFile, atlasFile, scale);
 }
 
 SkeletonRenderer::~SkeletonRenderer () {
-	if (_ownsSkeletonData) spSkeletonData_dispose(_skeleton->data);
+	spSkeletonData* skeletonData = _skeleton->data;
+	if (_ownsSkeletonData) spSkeletonData_dispose(skeletonData);
 	spSkeleton_dispose(_skeleton);
+	if (_cachedSkeletonData) SkeletonDataCache::getInstance()->releaseSkeletonData(skeletonData);
 	if (_atlas) spAtlas_dispose(_atlas);
 	if (_attachmentLoader) spAttachmentLoader_dispose(_attachmentLoader);
 	delete [] _worldVertices;
@@ -122,18 +125,12 @@ void SkeletonRenderer::initWithJsonFile (const std::string& skeletonDataFile, sp
 }
 
 void SkeletonRenderer::initWithJsonFile (const std::string& skeletonDataFile, const std::string& atlasFile, float scale) {
-	_atlas = spAtlas_createFromFile(atlasFile.c_str(), 0);
-	CCASSERT(_atlas, "Error reading atlas file.");
+	// the skeletons loaded from the same files share their data
+	spSkeletonData* skeletonData = SkeletonDataCache::getInstance()->retainSkeletonData(skeletonDataFile, atlasFile, scale, false);
+	CCASSERT(skeletonData, "Error reading skeleton data file.");
 
-	_attachmentLoader = SUPER(Cocos2dAttachmentLoader_create(_atlas));
-
-	spSkeletonJson* json = spSkeletonJson_createWithLoader(_attachmentLoader);
-	json->scale = scale;
-	spSkeletonData* skeletonData = spSkeletonJson_readSkeletonDataFile(json, skeletonDataFile.c_str());
-	CCASSERT(skeletonData, json->error ? json->error : "Error reading skeleton data file.");
-	spSkeletonJson_dispose(json);
-
-	setSkeletonData(skeletonData, true);
+	setSkeletonData(skeletonData, false);
+	_cachedSkeletonData = true;
 
 	initialize();
 }
@@ -154,18 +151,11 @@ void SkeletonRenderer::initWithBinaryFile (const std::string& skeletonDataFile,
 }
 
 void SkeletonRenderer::initWithBinaryFile (const std::string& skeletonDataFile, const std::string& atlasFile, float scale) {
-    _atlas = spAtlas_createFromFile(atlasFile.c_str(), 0);
-    CCASSERT(_atlas, "Error reading atlas file.");
-    
-    _attachmentLoader = SUPER(Cocos2dAttachmentLoader_create(_atlas));
-    
-    spSkeletonBinary* binary = spSkeletonBinary_createWithLoader(_attachmentLoader);
-    binary->scale = scale;
-    spSkeletonData* skeletonData = spSkeletonBinary_readSkeletonDataFile(binary, skeletonDataFile.c_str());
-    CCASSERT(skeletonData, binary->error ? binary->error : "Error reading skeleton data file.");
-    spSkeletonBinary_dispose(binary);
+    spSkeletonData* skeletonData = SkeletonDataCache::getInstance()->retainSkeletonData(skeletonDataFile, atlasFile, scale, true);
+    CCASSERT(skeletonData, "Error reading skeleton data file.");
     
-    setSkeletonData(skeletonData, true);
+    setSkeletonData(skeletonData, false);
+    _cachedSkeletonData = true;
     
     initialize();
 }
@@ -176,6 +166,13 @@ void SkeletonRenderer::update (float deltaTime) {
 }
 
 void SkeletonRenderer::draw (Renderer* renderer, const Mat4& transform, uint32_t transformFlags) {
+	AnimationLOD* lod = AnimationLOD::getInstance();
+	if (!lod->checkDraw(_lodState, transform)) return;
+
+	// the bounds of the pose are measured for the next draws
+	bool measureBounds = lod->isEnabled();
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+
 	SkeletonBatch* batch = SkeletonBatch::getInstance();
 
 	Color3B nodeColor = getColor();
@@ -231,6 +228,12 @@ void SkeletonRenderer::draw (Renderer* renderer, const Mat4& transform, uint32_t
             vertex->colors.g = (GLubyte)color.g;
             vertex->colors.b = (GLubyte)color.b;
             vertex->colors.a = (GLubyte)color.a;
+			if (measureBounds) {
+				minX = min(minX, _worldVertices[w]);
+				minY = min(minY, _worldVertices[w + 1]);
+				maxX = max(maxX, _worldVertices[w]);
+				maxY = max(maxY, _worldVertices[w + 1]);
+			}
 		}
 
 		BlendFunc blendFunc;
@@ -256,6 +259,10 @@ void SkeletonRenderer::draw (Renderer* renderer, const Mat4& transform, uint32_t
 			*attachmentVertices->_triangles, transform, transformFlags);
 	}
 
+	if (measureBounds) {
+		_lodState.bounds = minX <= maxX ? Rect(minX, minY, maxX - minX, maxY - minY) : Rect::ZERO;
+	}
+
 	if (_debugSlots || _debugBones) {
         drawDebug(renderer, transform, transformFlags);
 	}
@@ -122,6 +122,8 @@ protected:
 	bool _ownsSkeletonData;
 	spAtlas* _atlas;
 	spAttachmentLoader* _attachmentLoader;
+	// the skeleton data is shared through the SkeletonDataCache
+	bool _cachedSkeletonData;
 	cocos2d::CustomCommand _debugCommand;
 	cocos2d::BlendFunc _blendFunc;
 	float* _worldVertices;
@@ -130,6 +132,7 @@ protected:
 	float _timeScale;
 	bool _debugSlots;
 	bool _debugBones;
+	cocos2d::AnimationLOD::State _lodState;
 };
 
 }
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Spine Runtimes Software License v2.5
+ *
+ * Copyright (c) 2013-2016, Esoteric Software
+ * All rights reserved.
+ *
+ * You are granted a perpetual, non-exclusive, non-sublicensable, and
+ * non-transferable license to use, install, execute, and perform the Spine
+ * Runtimes software and derivative works solely for personal or internal
+ * use. Without the written permission of Esoteric Software (see Section 2 of
+ * the Spine Software License Agreement), you may not (a) modify, translate,
+ * adapt, or develop new applications using the Spine Runtimes or otherwise
+ * create derivative works or improvements of the Spine Runtimes or (b) remove,
+ * delete, alter, or obscure any trademarks or any copyright, trademark, patent,
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES, BUSINESS INTERRUPTION, OR LOSS OF
+ * USE, DATA, OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonUpdateBatch.h>
+#include <spine/SkeletonAnimation.h>
+#include "base/CCWorkerPool.h"
+#include <climits>
+
+USING_NS_CC;
+
+namespace spine {
+
+    // a skeleton takes long enough to be worth a range on its own, a few of them balance the threads better
+    static const ssize_t MIN_RANGE_SIZE = 2;
+
+    const int SkeletonUpdateBatch::UPDATE_PRIORITY = INT_MAX;
+
+    static SkeletonUpdateBatch* instance = nullptr;
+
+    SkeletonUpdateBatch* SkeletonUpdateBatch::getInstance () {
+        if (!instance) instance = new SkeletonUpdateBatch();
+        return instance;
+    }
+
+    void SkeletonUpdateBatch::destroyInstance () {
+        if (instance) {
+            instance->release();
+            instance = nullptr;
+        }
+    }
+
+    SkeletonUpdateBatch::SkeletonUpdateBatch ()
+    : _enabled(false)
+    {
+    }
+
+    SkeletonUpdateBatch::~SkeletonUpdateBatch () {
+        // destroyed by Director::reset(), when the listeners can't be called anymore.
+        // The pose of the queued skeletons wasn't updated, so they have no queued events.
+        for (auto& queued : _skeletons) {
+            queued.skeleton->_batchIndex = -1;
+            queued.skeleton->release();
+        }
+    }
+
+    void SkeletonUpdateBatch::addSkeleton (SkeletonAnimation* skeleton, float deltaTime) {
+        // two workers must never update the same skeleton
+        if (skeleton->_batchIndex >= 0) {
+            _skeletons[skeleton->_batchIndex].deltaTime += deltaTime;
+            return;
+        }
+
+        skeleton->retain();
+        skeleton->_batchIndex = (int)_skeletons.size();
+        QueuedSkeleton queued = { skeleton, deltaTime };
+        _skeletons.push_back(queued);
+    }
+
+    void SkeletonUpdateBatch::update (float deltaTime) {
+        if (_skeletons.empty()) return;
+
+        // the listeners may queue skeletons again, e.g. by updating them by hand
+        std::vector<QueuedSkeleton> skeletons;
+        skeletons.swap(_skeletons);
+        for (auto& queued : skeletons) {
+            queued.skeleton->_batchIndex = -1;
+        }
+
+        WorkerPool::getInstance()->parallelFor((ssize_t)skeletons.size(), MIN_RANGE_SIZE, [&skeletons](ssize_t begin, ssize_t end) {
+            for (ssize_t i = begin; i < end; ++i) {
+                skeletons[i].skeleton->updatePose(skeletons[i].deltaTime);
+            }
+        });
+
+        for (auto& queued : skeletons) {
+            queued.skeleton->fireQueuedEvents();
+            queued.skeleton->release();
+        }
+    }
+
+}
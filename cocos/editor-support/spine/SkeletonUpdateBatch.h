@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Spine Runtimes Software License v2.5
+ *
+ * Copyright (c) 2013-2016, Esoteric Software
+ * All rights reserved.
+ *
+ * You are granted a perpetual, non-exclusive, non-sublicensable, and
+ * non-transferable license to use, install, execute, and perform the Spine
+ * Runtimes software and derivative works solely for personal or internal
+ * use. Without the written permission of Esoteric Software (see Section 2 of
+ * the Spine Software License Agreement), you may not (a) modify, translate,
+ * adapt, or develop new applications using the Spine Runtimes or otherwise
+ * create derivative works or improvements of the Spine Runtimes or (b) remove,
+ * delete, alter, or obscure any trademarks or any copyright, trademark, patent,
+ * or other intellectual property or proprietary rights notices on or in the
+ * Software, including any copy thereof. Redistributions in binary or source
+ * form must include this license and terms.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ESOTERIC SOFTWARE "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO
+ * EVENT SHALL ESOTERIC SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES, BUSINESS INTERRUPTION, OR LOSS OF
+ * USE, DATA, OR PROFITS) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+ * IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONUPDATEBATCH_H_
+#define SPINE_SKELETONUPDATEBATCH_H_
+
+#include <spine/spine.h>
+#include "cocos2d.h"
+#include <vector>
+
+namespace spine {
+
+    class SkeletonAnimation;
+
+    /* Evaluates the poses of the skeleton animations of a frame together, on the worker threads.
+     *
+     * When the batch is enabled, SkeletonAnimation::update() only queues the skeleton. The batch is updated by the
+     * Director after all the other updates: the animation states are updated and applied, and the world transforms
+     * computed, in parallel. Then the listeners are called on the main thread, skeleton after skeleton in the order
+     * the skeletons were updated, so the events of a frame are fired in the same order whatever the number of threads.
+     * The listeners are called after the pose of their skeleton has been applied, a change of animation made in a
+     * listener is applied the next frame.
+     *
+     * A skeleton is queued once per frame: the time of the updates made by hand, e.g. update(0) right after
+     * setAnimation(), is added to its queued update. So a manual update() doesn't apply the pose right away,
+     * the pose and the events come with the update of the batch.
+     *
+     * The batch is disabled by default. */
+    class SkeletonUpdateBatch : public cocos2d::Ref {
+    public:
+        /* The priority of the batch in the Scheduler, after the updates of the nodes. */
+        static const int UPDATE_PRIORITY;
+
+        static SkeletonUpdateBatch* getInstance ();
+
+        static void destroyInstance ();
+
+        /* Sets whether the skeleton animations are updated by the batch. Defaults to false. */
+        void setEnabled (bool enabled) { _enabled = enabled; }
+        bool isEnabled () const { return _enabled; }
+
+        /* Queues a skeleton until the next update of the batch, it is retained until then.
+         * The time of a skeleton already queued is added to its queued update. */
+        void addSkeleton (SkeletonAnimation* skeleton, float deltaTime);
+
+        /* Updates the queued skeletons, then fires their events. */
+        void update (float deltaTime);
+
+    CC_CONSTRUCTOR_ACCESS:
+        SkeletonUpdateBatch ();
+        virtual ~SkeletonUpdateBatch ();
+
+    protected:
+        struct QueuedSkeleton {
+            SkeletonAnimation* skeleton;
+            float deltaTime;
+        };
+
+        std::vector<QueuedSkeleton> _skeletons;
+        bool _enabled;
+    };
+
+}
+
+#endif // SPINE_SKELETONUPDATEBATCH_H_
@@ -33,6 +33,7 @@
 
 static void* (*mallocFunc) (size_t size) = malloc;
 static void* (*debugMallocFunc) (size_t size, const char* file, int line) = NULL;
+static void* (*reallocFunc) (void* ptr, size_t size) = realloc;
 static void (*freeFunc) (void* ptr) = free;
 
 void* _malloc (size_t size, const char* file, int line) {
@@ -46,6 +47,9 @@ void* _calloc (size_t num, size_t size, const char* file, int line) {
 	if (ptr) memset(ptr, 0, num * size);
 	return ptr;
 }
+void* _realloc (void* ptr, size_t size) {
+	return reallocFunc(ptr, size);
+}
 void _free (void* ptr) {
 	freeFunc(ptr);
 }
@@ -57,10 +61,26 @@ void _setDebugMalloc(void* (*malloc) (size_t size, const char* file, int line))
 void _setMalloc (void* (*malloc) (size_t size)) {
 	mallocFunc = malloc;
 }
+void _setRealloc (void* (*realloc) (void* ptr, size_t size)) {
+	reallocFunc = realloc;
+}
 void _setFree (void (*free) (void* ptr)) {
 	freeFunc = free;
 }
 
+void* (*_getMalloc (void)) (size_t size) {
+	return mallocFunc;
+}
+void* (*_getDebugMalloc (void)) (size_t size, const char* file, int line) {
+	return debugMallocFunc;
+}
+void* (*_getRealloc (void)) (void* ptr, size_t size) {
+	return reallocFunc;
+}
+void (*_getFree (void)) (void* ptr) {
+	return freeFunc;
+}
+
 char* _readFile (const char* path, int* length) {
 	char *data;
 	FILE *file = fopen(path, "rb");
@@ -65,6 +65,7 @@
 #define MALLOC(TYPE,COUNT) ((TYPE*)_malloc(sizeof(TYPE) * (COUNT), __FILE__, __LINE__))
 #define CALLOC(TYPE,COUNT) ((TYPE*)_calloc(COUNT, sizeof(TYPE), __FILE__, __LINE__))
 #define NEW(TYPE) CALLOC(TYPE,1)
+#define REALLOC(PTR,TYPE,COUNT) ((TYPE*)_realloc(PTR, sizeof(TYPE) * (COUNT)))
 
 /* Gets the direct super class. Type safe. */
 #define SUPER(VALUE) (&VALUE->super)
@@ -161,12 +162,20 @@ char* _spUtil_readFile (const char* path, int* length);
 
 void* _malloc (size_t size, const char* file, int line);
 void* _calloc (size_t num, size_t size, const char* file, int line);
+void* _realloc (void* ptr, size_t size);
 void _free (void* ptr);
 
 void _setMalloc (void* (*_malloc) (size_t size));
 void _setDebugMalloc (void* (*_malloc) (size_t size, const char* file, int line));
+void _setRealloc (void* (*_realloc) (void* ptr, size_t size));
 void _setFree (void (*_free) (void* ptr));
 
+/* The functions set by the above, e.g. to restore them. */
+void* (*_getMalloc (void)) (size_t size);
+void* (*_getDebugMalloc (void)) (size_t size, const char* file, int line);
+void* (*_getRealloc (void)) (void* ptr, size_t size);
+void (*_getFree (void)) (void* ptr);
+
 char* _readFile (const char* path, int* length);
 
 /**/
@@ -225,6 +234,9 @@ struct _spAnimationState {
 #endif
 };
 
+/* Fires the queued events and disposes the ended track entries, unless draining is disabled. */
+void _spEventQueue_drain (_spEventQueue* self);
+
 
 /**/
 
@@ -37,5 +37,7 @@
 #include <spine/SkeletonRenderer.h>
 #include <spine/SkeletonAnimation.h>
 #include <spine/SkeletonBatch.h>
+#include <spine/SkeletonDataCache.h>
+#include <spine/SkeletonUpdateBatch.h>
 
 #endif /* SPINE_COCOS2DX_H_ */
@@ -0,0 +1,203 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CC_SIMD_H__
+#define __CC_SIMD_H__
+
+#include "math/CCMathBase.h"
+
+/**
+ * Thin wrappers over the SSE2 and NEON vectors of 4 floats, so that a kernel is written once for both.
+ * CC_SIMD_ENABLED is 0 when neither is available, e.g. on armeabi-v7a files not built with NEON:
+ * kernels then only run their scalar code.
+ *
+ * The typical kernel processes 4 elements at a time, and the remaining ones with the scalar code:
+ * @code
+ * int i = 0;
+ * #if CC_SIMD_ENABLED
+ * for (; i + 4 <= count; i += 4)
+ *     simd4::store(x + i, simd4::add(simd4::load(x + i), simd4::mul(simd4::load(dx + i), dt4)));
+ * #endif
+ * for (; i < count; ++i)
+ *     x[i] += dx[i] * dt;
+ * @endcode
+ */
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CC_SIMD_SSE 1
+    #define CC_SIMD_ENABLED 1
+    #include <emmintrin.h>
+#elif defined (__ARM_NEON__) || defined (__ARM_NEON) || defined (__aarch64__)
+    #define CC_SIMD_NEON 1
+    #define CC_SIMD_ENABLED 1
+    #include <arm_neon.h>
+#else
+    #define CC_SIMD_ENABLED 0
+#endif
+
+#if CC_SIMD_ENABLED
+
+NS_CC_MATH_BEGIN
+
+namespace simd4 {
+
+#if defined (CC_SIMD_SSE)
+typedef __m128 Float;
+typedef __m128 Mask;
+
+inline Float load(const float* p) { return _mm_loadu_ps(p); }
+inline void store(float* p, Float v) { _mm_storeu_ps(p, v); }
+inline Float set(float v) { return _mm_set1_ps(v); }
+inline Float add(Float a, Float b) { return _mm_add_ps(a, b); }
+inline Float sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+inline Float mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+inline Float min(Float a, Float b) { return _mm_min_ps(a, b); }
+inline Float max(Float a, Float b) { return _mm_max_ps(a, b); }
+inline Float neg(Float a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+/** 1 / sqrt(a), as precise as the scalar computation. */
+inline Float invSqrt(Float a) { return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(a)); }
+/** Rounds to the nearest integer, for |a| < 2^22. */
+inline Float round(Float a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+
+inline Mask greater(Float a, Float b) { return _mm_cmpgt_ps(a, b); }
+inline Mask less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+inline Mask equal(Float a, Float b) { return _mm_cmpeq_ps(a, b); }
+inline Mask maskOr(Mask a, Mask b) { return _mm_or_ps(a, b); }
+/** Picks `a` where the mask is set, `b` elsewhere. */
+inline Float select(Mask mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+/** Packs 4 colors whose components are in [0, 255] into RGBA8888, truncating them like a cast to GLubyte. */
+inline void storeColors(unsigned int* p, Float r, Float g, Float b, Float a)
+{
+    const Float zero = _mm_setzero_ps();
+    const Float full = _mm_set1_ps(255.0f);
+    __m128i ri = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(r, zero), full));
+    __m128i gi = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(g, zero), full));
+    __m128i bi = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(b, zero), full));
+    __m128i ai = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(a, zero), full));
+    __m128i rgba = _mm_or_si128(_mm_or_si128(ri, _mm_slli_epi32(gi, 8)),
+                                _mm_or_si128(_mm_slli_epi32(bi, 16), _mm_slli_epi32(ai, 24)));
+    _mm_storeu_si128((__m128i*)p, rgba);
+}
+#elif defined (CC_SIMD_NEON)
+typedef float32x4_t Float;
+typedef uint32x4_t Mask;
+
+inline Float load(const float* p) { return vld1q_f32(p); }
+inline void store(float* p, Float v) { vst1q_f32(p, v); }
+inline Float set(float v) { return vdupq_n_f32(v); }
+inline Float add(Float a, Float b) { return vaddq_f32(a, b); }
+inline Float sub(Float a, Float b) { return vsubq_f32(a, b); }
+inline Float mul(Float a, Float b) { return vmulq_f32(a, b); }
+inline Float min(Float a, Float b) { return vminq_f32(a, b); }
+inline Float max(Float a, Float b) { return vmaxq_f32(a, b); }
+inline Float neg(Float a) { return vnegq_f32(a); }
+inline Float invSqrt(Float a)
+{
+#if defined (__aarch64__)
+    return vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(a));
+#else
+    // estimate refined by two Newton-Raphson steps
+    Float e = vrsqrteq_f32(a);
+    e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a, e), e));
+    e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(a, e), e));
+    return e;
+#endif
+}
+inline Float round(Float a)
+{
+#if defined (__aarch64__)
+    return vrndnq_f32(a);
+#else
+    // adding and subtracting 1.5 * 2^23 drops the fractional bits, rounding to nearest
+    const Float magic = vdupq_n_f32(12582912.0f);
+    return vsubq_f32(vaddq_f32(a, magic), magic);
+#endif
+}
+
+inline Mask greater(Float a, Float b) { return vcgtq_f32(a, b); }
+inline Mask less(Float a, Float b) { return vcltq_f32(a, b); }
+inline Mask equal(Float a, Float b) { return vceqq_f32(a, b); }
+inline Mask maskOr(Mask a, Mask b) { return vorrq_u32(a, b); }
+inline Float select(Mask mask, Float a, Float b) { return vbslq_f32(mask, a, b); }
+
+inline void storeColors(unsigned int* p, Float r, Float g, Float b, Float a)
+{
+    const Float zero = vdupq_n_f32(0.0f);
+    const Float full = vdupq_n_f32(255.0f);
+    uint32x4_t ri = vcvtq_u32_f32(vminq_f32(vmaxq_f32(r, zero), full));
+    uint32x4_t gi = vcvtq_u32_f32(vminq_f32(vmaxq_f32(g, zero), full));
+    uint32x4_t bi = vcvtq_u32_f32(vminq_f32(vmaxq_f32(b, zero), full));
+    uint32x4_t ai = vcvtq_u32_f32(vminq_f32(vmaxq_f32(a, zero), full));
+    uint32x4_t rgba = vorrq_u32(vorrq_u32(ri, vshlq_n_u32(gi, 8)),
+                                vorrq_u32(vshlq_n_u32(bi, 16), vshlq_n_u32(ai, 24)));
+    vst1q_u32(p, rgba);
+}
+#endif
+
+/**
+ * Computes the sine and the cosine of angles in radians.
+ * The angle is reduced to [-pi/2, pi/2] and fed to Taylor polynomials, the error is below 1e-6 for |a| < 1e4.
+ */
+inline void sinCos(Float angle, Float* sine, Float* cosine)
+{
+    // a - k * 2pi, with 2pi split in two parts so that the reduction stays exact
+    Float k = round(mul(angle, set(0.15915494309189535f)));
+    Float a = sub(sub(angle, mul(k, set(6.28125f))), mul(k, set(0.0019353071795864769f)));
+
+    // sin(a) = sin(pi - a) and cos(a) = -cos(pi - a)
+    const Float pi = set(3.14159265358979323846f);
+    Mask above = greater(a, set(MATH_PIOVER2));
+    Mask below = less(a, set(-MATH_PIOVER2));
+    a = select(above, sub(pi, a), a);
+    a = select(below, sub(neg(pi), a), a);
+    Mask flipCosine = maskOr(above, below);
+
+    Float a2 = mul(a, a);
+    Float s = add(set(-2.5052108385441720e-8f), mul(a2, set(1.6059043836821614e-10f)));
+    s = add(set(2.7557319223985893e-6f), mul(a2, s));
+    s = add(set(-1.9841269841269841e-4f), mul(a2, s));
+    s = add(set(8.3333333333333333e-3f), mul(a2, s));
+    s = add(set(-1.6666666666666667e-1f), mul(a2, s));
+    s = add(a, mul(mul(a, a2), s));
+
+    Float c = add(set(-2.7557319223985888e-7f), mul(a2, set(2.0876756987868099e-9f)));
+    c = add(set(2.4801587301587302e-5f), mul(a2, c));
+    c = add(set(-1.3888888888888889e-3f), mul(a2, c));
+    c = add(set(4.1666666666666667e-2f), mul(a2, c));
+    c = add(set(-0.5f), mul(a2, c));
+    c = add(set(1.0f), mul(a2, c));
+
+    *sine = s;
+    *cosine = select(flipCosine, neg(c), c);
+}
+
+} // namespace simd4
+
+NS_CC_MATH_END
+
+#endif // CC_SIMD_ENABLED
+
+#endif // __CC_SIMD_H__
@@ -275,4 +275,21 @@ void MathUtil::crossVec3(const float* v1, const float* v2, float* dst)
 #endif
 }
 
+void MathUtil::transformPoints(const float* m, float* points, size_t count, size_t stride)
+{
+#ifdef USE_NEON32
+    MathUtilNeon::transformPoints(m, points, count, stride);
+#elif defined (USE_NEON64)
+    MathUtilNeon64::transformPoints(m, points, count, stride);
+#elif defined (INCLUDE_NEON32)
+    if(isNeon32Enabled()) MathUtilNeon::transformPoints(m, points, count, stride);
+    else MathUtilC::transformPoints(m, points, count, stride);
+#elif defined (USE_SSE)
+    __m128 col[4] = { _mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12) };
+    MathUtil::transformPoints(col, points, count, stride);
+#else
+    MathUtilC::transformPoints(m, points, count, stride);
+#endif
+}
+
 NS_CC_MATH_END
@@ -87,6 +87,19 @@ public:
      * @return interpolated float value
      */
     static float lerp(float from, float to, float alpha);
+
+    /**
+     * Transforms a stream of points by the given matrix, in place (w is assumed to be 1).
+     * The points may be interleaved with other data, e.g. the `vertices` of an array of V3F_C4B_T2F,
+     * which makes it the batched version of Mat4::transformPoint.
+     * Uses SSE or NEON when available.
+     *
+     * @param m the column-major matrix.
+     * @param points pointer to the x coordinate of the first point, followed by y and z.
+     * @param count the number of points.
+     * @param stride the distance in bytes between two consecutive points.
+     */
+    static void transformPoints(const float* m, float* points, size_t count, size_t stride);
 private:
     //Indicates that if neon is enabled
     static bool isNeon32Enabled();
@@ -108,6 +121,8 @@ private:
     static void transposeMatrix(const __m128 m[4], __m128 dst[4]);
 
     static void transformVec4(const __m128 m[4], const __m128& v, __m128& dst);
+
+    static void transformPoints(const __m128 m[4], float* points, size_t count, size_t stride);
 #endif
     static void addMatrix(const float* m, float scalar, float* dst);
 
@@ -42,6 +42,8 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+    
+    inline static void transformPoints(const float* m, float* points, size_t count, size_t stride);
 };
 
 inline void MathUtilC::addMatrix(const float* m, float scalar, float* dst)
@@ -215,4 +217,20 @@ inline void MathUtilC::crossVec3(const float* v1, const float* v2, float* dst)
     dst[2] = z;
 }
 
+inline void MathUtilC::transformPoints(const float* m, float* points, size_t count, size_t stride)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        float x = points[0];
+        float y = points[1];
+        float z = points[2];
+        
+        points[0] = x * m[0] + y * m[4] + z * m[8] + m[12];
+        points[1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+        points[2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+        
+        points = (float*)((char*)points + stride);
+    }
+}
+
 NS_CC_MATH_END
@@ -17,6 +17,8 @@
 
  This file was modified to fit the cocos2d-x project
  */
+#include <arm_neon.h>
+
 NS_CC_MATH_BEGIN
 
 class MathUtilNeon
@@ -41,6 +43,8 @@ public:
     inline static void transformVec4(const float* m, const float* v, float* dst);
     
     inline static void crossVec3(const float* v1, const float* v2, float* dst);
+    
+    inline static void transformPoints(const float* m, float* points, size_t count, size_t stride);
 };
 
 inline void MathUtilNeon::addMatrix(const float* m, float scalar, float* dst)
@@ -268,4 +272,26 @@ inline void MathUtilNeon::crossVec3(const float* v1, const float* v2, float* dst
                  );
 }
 
+inline void MathUtilNeon::transformPoints(const float* m, float* points, size_t count, size_t stride)
+{
+    float32x4_t m0 = vld1q_f32(m);      // M[m0-m3]
+    float32x4_t m1 = vld1q_f32(m + 4);  // M[m4-m7]
+    float32x4_t m2 = vld1q_f32(m + 8);  // M[m8-m11]
+    float32x4_t m3 = vld1q_f32(m + 12); // M[m12-m15]
+    
+    for (size_t i = 0; i < count; ++i)
+    {
+        float32x2_t xy = vld1_f32(points);                  // V[x, y]
+        
+        float32x4_t dst = vmlaq_lane_f32(m3, m0, xy, 0);    // DST->V = M[m12-m15] + M[m0-m3] * V[x]
+        dst = vmlaq_lane_f32(dst, m1, xy, 1);               // DST->V += M[m4-m7] * V[y]
+        dst = vmlaq_n_f32(dst, m2, points[2]);              // DST->V += M[m8-m11] * V[z]
+        
+        vst1_f32(points, vget_low_f32(dst));                // DST->V[x, y]
+        vst1q_lane_f32(points + 2, dst, 2);                 // DST->V[z]
+        
+        points = (float*)((char*)points + stride);
+    }
+}
+
 NS_CC_MATH_END
@@ -151,6 +151,28 @@ void MathUtil::transformVec4(const __m128 m[4], const __m128& v, __m128& dst)
                      );
 }
 
+void MathUtil::transformPoints(const __m128 m[4], float* points, size_t count, size_t stride)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        // points are neither 16 bytes aligned nor padded, so load and store x,y and z separately
+        __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)points);
+        __m128 x = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 y = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 z = _mm_load1_ps(points + 2);
+        
+        __m128 dst = _mm_add_ps(
+                                _mm_add_ps(_mm_mul_ps(m[0], x), _mm_mul_ps(m[1], y)),
+                                _mm_add_ps(_mm_mul_ps(m[2], z), m[3])
+                                );
+        
+        _mm_storel_pi((__m64*)points, dst);
+        _mm_store_ss(points + 2, _mm_shuffle_ps(dst, dst, _MM_SHUFFLE(2, 2, 2, 2)));
+        
+        points = (float*)((char*)points + stride);
+    }
+}
+
 #endif
 
 
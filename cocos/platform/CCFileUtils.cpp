@@ -25,12 +25,10 @@ THE SOFTWARE.
 
 #include "platform/CCFileUtils.h"
 
-#include <stack>
-
 #include "base/CCData.h"
 #include "base/ccMacros.h"
 #include "base/CCDirector.h"
-#include "platform/CCSAXParser.h"
+#include "platform/CCPlistParser.h"
 
 #include "tinyxml2/tinyxml2.h"
 #include "tinydir/tinydir.h"
@@ -44,313 +42,41 @@ THE SOFTWARE.
 
 NS_CC_BEGIN
 
-// Implement DictMaker
-
 #if (CC_TARGET_PLATFORM != CC_PLATFORM_IOS) && (CC_TARGET_PLATFORM != CC_PLATFORM_MAC)
 
-typedef enum
-{
-    SAX_NONE = 0,
-    SAX_KEY,
-    SAX_DICT,
-    SAX_INT,
-    SAX_REAL,
-    SAX_STRING,
-    SAX_ARRAY
-}SAXState;
-
-typedef enum
-{
-    SAX_RESULT_NONE = 0,
-    SAX_RESULT_DICT,
-    SAX_RESULT_ARRAY
-}SAXResult;
-
-class DictMaker : public SAXDelegator
-{
-public:
-    SAXResult _resultType;
-    ValueMap _rootDict;
-    ValueVector _rootArray;
-
-    std::string _curKey;   ///< parsed key
-    std::string _curValue; // parsed value
-    SAXState _state;
-
-    ValueMap*  _curDict;
-    ValueVector* _curArray;
-
-    std::stack<ValueMap*> _dictStack;
-    std::stack<ValueVector*> _arrayStack;
-    std::stack<SAXState>  _stateStack;
-
-public:
-    DictMaker()
-        : _resultType(SAX_RESULT_NONE)
-    {
-    }
-
-    ~DictMaker()
-    {
-    }
-
-    ValueMap dictionaryWithContentsOfFile(const std::string& fileName)
-    {
-        _resultType = SAX_RESULT_DICT;
-        SAXParser parser;
-
-        CCASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
-        parser.setDelegator(this);
-
-        parser.parse(fileName);
-        return _rootDict;
-    }
-
-    ValueMap dictionaryWithDataOfFile(const char* filedata, int filesize)
-    {
-        _resultType = SAX_RESULT_DICT;
-        SAXParser parser;
-
-        CCASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
-        parser.setDelegator(this);
-
-        parser.parse(filedata, filesize);
-        return _rootDict;
-    }
-
-    ValueVector arrayWithContentsOfFile(const std::string& fileName)
-    {
-        _resultType = SAX_RESULT_ARRAY;
-        SAXParser parser;
-
-        CCASSERT(parser.init("UTF-8"), "The file format isn't UTF-8");
-        parser.setDelegator(this);
-
-        parser.parse(fileName);
-        return _rootArray;
-    }
-
-    void startElement(void *ctx, const char *name, const char **atts)
-    {
-        CC_UNUSED_PARAM(ctx);
-        CC_UNUSED_PARAM(atts);
-        const std::string sName(name);
-        if( sName == "dict" )
-        {
-            if(_resultType == SAX_RESULT_DICT && _rootDict.empty())
-            {
-                _curDict = &_rootDict;
-            }
-
-            _state = SAX_DICT;
-
-            SAXState preState = SAX_NONE;
-            if (! _stateStack.empty())
-            {
-                preState = _stateStack.top();
-            }
-
-            if (SAX_ARRAY == preState)
-            {
-                // add a new dictionary into the array
-                _curArray->push_back(Value(ValueMap()));
-                _curDict = &(_curArray->rbegin())->asValueMap();
-            }
-            else if (SAX_DICT == preState)
-            {
-                // add a new dictionary into the pre dictionary
-                CCASSERT(! _dictStack.empty(), "The state is wrong!");
-                ValueMap* preDict = _dictStack.top();
-                (*preDict)[_curKey] = Value(ValueMap());
-                _curDict = &(*preDict)[_curKey].asValueMap();
-            }
-
-            // record the dict state
-            _stateStack.push(_state);
-            _dictStack.push(_curDict);
-        }
-        else if(sName == "key")
-        {
-            _state = SAX_KEY;
-        }
-        else if(sName == "integer")
-        {
-            _state = SAX_INT;
-        }
-        else if(sName == "real")
-        {
-            _state = SAX_REAL;
-        }
-        else if(sName == "string")
-        {
-            _state = SAX_STRING;
-        }
-        else if (sName == "array")
-        {
-            _state = SAX_ARRAY;
-
-            if (_resultType == SAX_RESULT_ARRAY && _rootArray.empty())
-            {
-                _curArray = &_rootArray;
-            }
-            SAXState preState = SAX_NONE;
-            if (! _stateStack.empty())
-            {
-                preState = _stateStack.top();
-            }
-
-            if (preState == SAX_DICT)
-            {
-                (*_curDict)[_curKey] = Value(ValueVector());
-                _curArray = &(*_curDict)[_curKey].asValueVector();
-            }
-            else if (preState == SAX_ARRAY)
-            {
-                CCASSERT(! _arrayStack.empty(), "The state is wrong!");
-                ValueVector* preArray = _arrayStack.top();
-                preArray->push_back(Value(ValueVector()));
-                _curArray = &(_curArray->rbegin())->asValueVector();
-            }
-            // record the array state
-            _stateStack.push(_state);
-            _arrayStack.push(_curArray);
-        }
-        else
-        {
-            _state = SAX_NONE;
-        }
-    }
-
-    void endElement(void *ctx, const char *name)
-    {
-        CC_UNUSED_PARAM(ctx);
-        SAXState curState = _stateStack.empty() ? SAX_DICT : _stateStack.top();
-        const std::string sName((char*)name);
-        if( sName == "dict" )
-        {
-            _stateStack.pop();
-            _dictStack.pop();
-            if ( !_dictStack.empty())
-            {
-                _curDict = _dictStack.top();
-            }
-        }
-        else if (sName == "array")
-        {
-            _stateStack.pop();
-            _arrayStack.pop();
-            if (! _arrayStack.empty())
-            {
-                _curArray = _arrayStack.top();
-            }
-        }
-        else if (sName == "true")
-        {
-            if (SAX_ARRAY == curState)
-            {
-                _curArray->push_back(Value(true));
-            }
-            else if (SAX_DICT == curState)
-            {
-                (*_curDict)[_curKey] = Value(true);
-            }
-        }
-        else if (sName == "false")
-        {
-            if (SAX_ARRAY == curState)
-            {
-                _curArray->push_back(Value(false));
-            }
-            else if (SAX_DICT == curState)
-            {
-                (*_curDict)[_curKey] = Value(false);
-            }
-        }
-        else if (sName == "string" || sName == "integer" || sName == "real")
-        {
-            if (SAX_ARRAY == curState)
-            {
-                if (sName == "string")
-                    _curArray->push_back(Value(_curValue));
-                else if (sName == "integer")
-                    _curArray->push_back(Value(atoi(_curValue.c_str())));
-                else
-                    _curArray->push_back(Value(std::atof(_curValue.c_str())));
-            }
-            else if (SAX_DICT == curState)
-            {
-                if (sName == "string")
-                    (*_curDict)[_curKey] = Value(_curValue);
-                else if (sName == "integer")
-                    (*_curDict)[_curKey] = Value(atoi(_curValue.c_str()));
-                else
-                    (*_curDict)[_curKey] = Value(std::atof(_curValue.c_str()));
-            }
-
-            _curValue.clear();
-        }
-
-        _state = SAX_NONE;
-    }
-
-    void textHandler(void *ctx, const char *ch, int len)
-    {
-        CC_UNUSED_PARAM(ctx);
-        if (_state == SAX_NONE)
-        {
-            return;
-        }
-
-        SAXState curState = _stateStack.empty() ? SAX_DICT : _stateStack.top();
-        const std::string text = std::string((char*)ch,len);
-
-        switch(_state)
-        {
-        case SAX_KEY:
-            _curKey = text;
-            break;
-        case SAX_INT:
-        case SAX_REAL:
-        case SAX_STRING:
-            {
-                if (curState == SAX_DICT)
-                {
-                    CCASSERT(!_curKey.empty(), "key not found : <integer/real>");
-                }
-
-                _curValue.append(text);
-            }
-            break;
-        default:
-            break;
-        }
-    }
-};
-
 ValueMap FileUtils::getValueMapFromFile(const std::string& filename)
 {
+    ValueMap ret;
     const std::string fullPath = fullPathForFilename(filename);
     if (fullPath.empty())
     {
-        ValueMap ret;
         return ret;
     }
 
-    DictMaker tMaker;
-    return tMaker.dictionaryWithContentsOfFile(fullPath);
+    Data data = getDataFromFile(fullPath);
+    PlistParser::parse(reinterpret_cast<const char*>(data.getBytes()), data.getSize(), &ret);
+    return ret;
 }
 
 ValueMap FileUtils::getValueMapFromData(const char* filedata, int filesize)
 {
-    DictMaker tMaker;
-    return tMaker.dictionaryWithDataOfFile(filedata, filesize);
+    ValueMap ret;
+    PlistParser::parse(filedata, filesize, &ret);
+    return ret;
 }
 
 ValueVector FileUtils::getValueVectorFromFile(const std::string& filename)
 {
+    ValueVector ret;
     const std::string fullPath = fullPathForFilename(filename);
-    DictMaker tMaker;
-    return tMaker.arrayWithContentsOfFile(fullPath);
+    if (fullPath.empty())
+    {
+        return ret;
+    }
+
+    Data data = getDataFromFile(fullPath);
+    PlistParser::parse(reinterpret_cast<const char*>(data.getBytes()), data.getSize(), &ret);
+    return ret;
 }
 
 
@@ -85,6 +85,8 @@ extern "C"
 #include "base/CCConfiguration.h"
 #include "base/ccUtils.h"
 #include "base/ZipUtils.h"
+#include "renderer/CCTextureContainer.h"
+#include "renderer/CCPixelConverter.h"
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
 #include "platform/android/CCFileUtils-android.h"
 #endif
@@ -437,6 +439,9 @@ bool Image::initWithImageData(const unsigned char * data, ssize_t dataLen)
         case Format::ETC:
             ret = initWithETCData(unpackedData, unpackedLen);
             break;
+        case Format::CTEX:
+            ret = initWithTextureContainerData(unpackedData, unpackedLen);
+            break;
         default:
             {
                 // load and detect image format
@@ -561,6 +566,10 @@ Image::Format Image::detectFormat(const unsigned char * data, ssize_t dataLen)
     {
         return Format::ETC;
     }
+    else if (TextureContainer::isTextureContainer(data, dataLen))
+    {
+        return Format::CTEX;
+    }
     else
     {
         return Format::UNKNOWN;
@@ -1442,6 +1451,40 @@ bool Image::initWithPVRv3Data(const unsigned char * data, ssize_t dataLen)
     return true;
 }
 
+bool Image::initWithTextureContainerData(const unsigned char * data, ssize_t dataLen)
+{
+    TextureContainer::Info info;
+    if (!TextureContainer::parse(data, dataLen, &info) || info.numberOfMipmaps > MIPMAP_MAX)
+    {
+        return false;
+    }
+
+    // copy the pixels, TextureCache uploads them straight from the mapped file instead
+    _dataLen = 0;
+    for (int i = 0; i < info.numberOfMipmaps; ++i)
+    {
+        _dataLen += info.mipmaps[i].len;
+    }
+    _data = static_cast<unsigned char*>(malloc(_dataLen * sizeof(unsigned char)));
+
+    unsigned char* address = _data;
+    for (int i = 0; i < info.numberOfMipmaps; ++i)
+    {
+        memcpy(address, info.mipmaps[i].address, info.mipmaps[i].len);
+        _mipmaps[i].address = address;
+        _mipmaps[i].len = info.mipmaps[i].len;
+        address += info.mipmaps[i].len;
+    }
+
+    _width = info.width;
+    _height = info.height;
+    _renderFormat = info.pixelFormat;
+    _numberOfMipmaps = info.numberOfMipmaps;
+    _hasPremultipliedAlpha = info.hasPremultipliedAlpha;
+
+    return true;
+}
+
 bool Image::initWithETCData(const unsigned char * data, ssize_t dataLen)
 {
     const etc1_byte* header = static_cast<const etc1_byte*>(data);
@@ -1926,7 +1969,8 @@ void Image::premultipliedAlpha()
     if (PNG_PREMULTIPLIED_ALPHA_ENABLED && _renderFormat == Texture2D::PixelFormat::RGBA8888)
     {
         unsigned int* fourBytes = (unsigned int*)_data;
-        for(int i = 0; i < _width * _height; i++)
+        // the SSE2/NEON kernel premultiplies most of the pixels, the loop the remaining ones
+        for(int i = (int)PixelConverter::premultiplyAlpha(_data, _width * _height); i < _width * _height; i++)
         {
             unsigned char* p = _data + i * 4;
             fourBytes[i] = CC_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
@@ -92,6 +92,8 @@ public:
         TGA,
         //! Raw Data
         RAW_DATA,
+        //! Pre-baked texture container, see TextureContainer
+        CTEX,
         //! Unknown format
         UNKNOWN
     };
@@ -163,6 +165,7 @@ protected:
     bool initWithPVRv2Data(const unsigned char * data, ssize_t dataLen);
     bool initWithPVRv3Data(const unsigned char * data, ssize_t dataLen);
     bool initWithETCData(const unsigned char * data, ssize_t dataLen);
+    bool initWithTextureContainerData(const unsigned char * data, ssize_t dataLen);
 
     typedef struct sImageTGA tImageTGA;
     bool initWithTGAData(tImageTGA* tgaData);
@@ -0,0 +1,661 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "platform/CCPlistParser.h"
+
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#include "base/ccMacros.h"
+#include "base/ccUTF8.h"
+
+NS_CC_BEGIN
+
+// deeper plists are rejected, it also stops the cycles of malformed binary plists
+static const int MAX_DEPTH = 512;
+
+static const char BINARY_PLIST_MAGIC[8] = { 'b', 'p', 'l', 'i', 's', 't', '0', '0' };
+static const ssize_t BINARY_PLIST_TRAILER_SIZE = 32;
+
+// appends a code point to an UTF-8 string
+static void appendUTF8(std::string& out, unsigned long codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        out.push_back((char)codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+        out.push_back((char)(0xC0 | (codePoint >> 6)));
+        out.push_back((char)(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000)
+    {
+        out.push_back((char)(0xE0 | (codePoint >> 12)));
+        out.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back((char)(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x110000)
+    {
+        out.push_back((char)(0xF0 | (codePoint >> 18)));
+        out.push_back((char)(0x80 | ((codePoint >> 12) & 0x3F)));
+        out.push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+        out.push_back((char)(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+//
+// XmlPlistReader
+//
+
+// Reads the elements of an XML plist. Only what plists use is supported: elements, text, entities, CDATA,
+// comments and the prolog. The attributes are skipped.
+class XmlPlistReader
+{
+public:
+    XmlPlistReader(const char* data, ssize_t dataLen)
+    : _p(data)
+    , _end(data + dataLen)
+    {
+    }
+
+    bool readRoot(Value* root)
+    {
+        // UTF-8 BOM
+        if (_end - _p >= 3 && (unsigned char)_p[0] == 0xEF && (unsigned char)_p[1] == 0xBB && (unsigned char)_p[2] == 0xBF)
+        {
+            _p += 3;
+        }
+
+        Tag tag;
+        if (!readTag(&tag) || tag.isClosing)
+            return false;
+
+        // like SAXParser, the root element doesn't have to be <plist>
+        if (tag.is("plist"))
+        {
+            if (tag.isEmpty || !readTag(&tag) || tag.isClosing)
+                return false;
+        }
+        return readElement(tag, root, 0);
+    }
+
+private:
+    struct Tag
+    {
+        const char* name;
+        size_t nameLength;
+        bool isClosing;
+        bool isEmpty;
+
+        bool is(const char* other) const
+        {
+            return strlen(other) == nameLength && memcmp(name, other, nameLength) == 0;
+        }
+    };
+
+    bool startsWith(const char* p, const char* prefix) const
+    {
+        size_t length = strlen(prefix);
+        return (size_t)(_end - p) >= length && memcmp(p, prefix, length) == 0;
+    }
+
+    // moves _p past `terminator`
+    bool skipPast(const char* terminator)
+    {
+        size_t length = strlen(terminator);
+        for (; _end - _p >= (ssize_t)length; ++_p)
+        {
+            if (memcmp(_p, terminator, length) == 0)
+            {
+                _p += length;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // reads the next element tag, skipping the text, comments, declarations and doctype before it
+    bool readTag(Tag* tag)
+    {
+        for (;;)
+        {
+            _p = static_cast<const char*>(memchr(_p, '<', _end - _p));
+            if (_p == nullptr)
+                return false;
+
+            if (startsWith(_p, "<?"))
+            {
+                if (!skipPast("?>"))
+                    return false;
+            }
+            else if (startsWith(_p, "<!--"))
+            {
+                if (!skipPast("-->"))
+                    return false;
+            }
+            else if (startsWith(_p, "<!"))
+            {
+                // doctype, with its internal subset if any
+                int brackets = 0;
+                for (++_p; _p < _end && (*_p != '>' || brackets > 0); ++_p)
+                {
+                    if (*_p == '[')
+                        ++brackets;
+                    else if (*_p == ']')
+                        --brackets;
+                }
+                if (_p == _end)
+                    return false;
+                ++_p;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        ++_p;
+        tag->isClosing = _p < _end && *_p == '/';
+        if (tag->isClosing)
+            ++_p;
+
+        tag->name = _p;
+        while (_p < _end && *_p != '>' && *_p != '/' && !isspace((unsigned char)*_p))
+            ++_p;
+        tag->nameLength = _p - tag->name;
+
+        // attributes
+        char quote = 0;
+        for (; _p < _end && (quote != 0 || *_p != '>'); ++_p)
+        {
+            if (quote != 0)
+            {
+                if (*_p == quote)
+                    quote = 0;
+            }
+            else if (*_p == '"' || *_p == '\'')
+            {
+                quote = *_p;
+            }
+        }
+        if (_p == _end || tag->nameLength == 0)
+            return false;
+
+        tag->isEmpty = !tag->isClosing && *(_p - 1) == '/';
+        ++_p;
+        return true;
+    }
+
+    void appendText(const char* begin, const char* end, std::string& out)
+    {
+        for (const char* p = begin; p < end; ++p)
+        {
+            if (*p == '\r')
+            {
+                // like tinyxml2, new lines are normalized
+                out.push_back('\n');
+                if (p + 1 < end && p[1] == '\n')
+                    ++p;
+            }
+            else if (*p == '&')
+            {
+                const char* semicolon = static_cast<const char*>(memchr(p, ';', end - p));
+                if (semicolon == nullptr)
+                {
+                    out.push_back('&');
+                    continue;
+                }
+
+                std::string entity(p + 1, semicolon);
+                if (entity == "lt")
+                    out.push_back('<');
+                else if (entity == "gt")
+                    out.push_back('>');
+                else if (entity == "amp")
+                    out.push_back('&');
+                else if (entity == "quot")
+                    out.push_back('"');
+                else if (entity == "apos")
+                    out.push_back('\'');
+                else if (entity.size() > 1 && entity[0] == '#')
+                {
+                    bool isHex = entity[1] == 'x' || entity[1] == 'X';
+                    appendUTF8(out, strtoul(entity.c_str() + (isHex ? 2 : 1), nullptr, isHex ? 16 : 10));
+                }
+                else
+                {
+                    // unknown entities are kept as they are
+                    out.push_back('&');
+                    continue;
+                }
+                p = semicolon;
+            }
+            else
+            {
+                out.push_back(*p);
+            }
+        }
+    }
+
+    // reads the text of an element, up to its closing tag
+    bool readText(std::string& out)
+    {
+        out.clear();
+        for (;;)
+        {
+            const char* lt = static_cast<const char*>(memchr(_p, '<', _end - _p));
+            if (lt == nullptr)
+                return false;
+
+            appendText(_p, lt, out);
+            _p = lt;
+
+            if (startsWith(_p, "<![CDATA["))
+            {
+                const char* begin = _p + 9;
+                if (!skipPast("]]>"))
+                    return false;
+                out.append(begin, _p - 3);
+            }
+            else if (startsWith(_p, "<!--"))
+            {
+                if (!skipPast("-->"))
+                    return false;
+            }
+            else
+            {
+                Tag tag;
+                return readTag(&tag) && tag.isClosing;
+            }
+        }
+    }
+
+    // reads an element whose start tag has been read, `out` is left unset for the skipped elements
+    bool readElement(const Tag& tag, Value* out, int depth)
+    {
+        if (tag.isClosing || depth > MAX_DEPTH)
+            return false;
+
+        if (tag.is("dict"))
+        {
+            ValueMap dict;
+            if (!tag.isEmpty)
+            {
+                std::string key;
+                Tag child;
+                for (;;)
+                {
+                    if (!readTag(&child))
+                        return false;
+                    if (child.isClosing)
+                        break;
+
+                    if (child.is("key"))
+                    {
+                        if (!child.isEmpty && !readText(key))
+                            return false;
+                        if (child.isEmpty)
+                            key.clear();
+                        continue;
+                    }
+
+                    Value value;
+                    if (!readElement(child, &value, depth + 1))
+                        return false;
+                    if (!value.isNull())
+                        dict[key] = std::move(value);
+                }
+            }
+            *out = std::move(dict);
+        }
+        else if (tag.is("array"))
+        {
+            ValueVector array;
+            if (!tag.isEmpty)
+            {
+                Tag child;
+                for (;;)
+                {
+                    if (!readTag(&child))
+                        return false;
+                    if (child.isClosing)
+                        break;
+
+                    Value value;
+                    if (!readElement(child, &value, depth + 1))
+                        return false;
+                    if (!value.isNull())
+                        array.push_back(std::move(value));
+                }
+            }
+            *out = std::move(array);
+        }
+        else if (tag.is("string") || tag.is("integer") || tag.is("real"))
+        {
+            if (!tag.isEmpty && !readText(_text))
+                return false;
+            if (tag.isEmpty)
+                _text.clear();
+
+            if (tag.is("string"))
+                *out = _text;
+            else if (tag.is("integer"))
+                *out = atoi(_text.c_str());
+            else
+                *out = atof(_text.c_str());
+        }
+        else if (tag.is("true") || tag.is("false"))
+        {
+            if (!tag.isEmpty && !readText(_text))
+                return false;
+            *out = tag.is("true");
+        }
+        else if (!tag.isEmpty)
+        {
+            // <key> out of a dictionary, <date>, <data>... are skipped with their content
+            Tag child;
+            for (;;)
+            {
+                if (!readTag(&child))
+                    return false;
+                if (child.isClosing)
+                    break;
+
+                Value ignored;
+                if (!readElement(child, &ignored, depth + 1))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    const char* _p;
+    const char* _end;
+    // the text of the last value, reused from a value to the next
+    std::string _text;
+};
+
+//
+// BinaryPlistReader
+//
+
+// Reads the objects of a binary plist (bplist00), from the offset table at the end of the file.
+class BinaryPlistReader
+{
+public:
+    BinaryPlistReader(const char* data, ssize_t dataLen)
+    : _data(reinterpret_cast<const unsigned char*>(data))
+    , _objectsEnd(reinterpret_cast<const unsigned char*>(data) + dataLen - BINARY_PLIST_TRAILER_SIZE)
+    , _offsetTable(nullptr)
+    , _offsetSize(0)
+    , _objectRefSize(0)
+    , _objectCount(0)
+    {
+    }
+
+    bool readRoot(Value* root)
+    {
+        const unsigned char* trailer = _objectsEnd;
+        _offsetSize = trailer[6];
+        _objectRefSize = trailer[7];
+        _objectCount = readBigEndian(trailer + 8, 8);
+        uint64_t topObject = readBigEndian(trailer + 16, 8);
+        uint64_t offsetTableOffset = readBigEndian(trailer + 24, 8);
+
+        uint64_t objectsSize = _objectsEnd - _data;
+        if (_offsetSize < 1 || _offsetSize > 8 || _objectRefSize < 1 || _objectRefSize > 8
+            || offsetTableOffset > objectsSize || _objectCount > (objectsSize - offsetTableOffset) / _offsetSize
+            || topObject >= _objectCount)
+        {
+            CCLOG("cocos2d: PlistParser: invalid binary plist trailer");
+            return false;
+        }
+
+        _offsetTable = _data + offsetTableOffset;
+        return readObject(topObject, root, 0);
+    }
+
+private:
+    static uint64_t readBigEndian(const unsigned char* p, int size)
+    {
+        uint64_t value = 0;
+        for (int i = 0; i < size; ++i)
+        {
+            value = (value << 8) | p[i];
+        }
+        return value;
+    }
+
+    // reads the number of elements of an object, which follows its marker when it doesn't fit in the marker
+    bool readCount(unsigned char info, const unsigned char*& p, uint64_t* count)
+    {
+        if (info != 0x0F)
+        {
+            *count = info;
+            return true;
+        }
+
+        if (p >= _objectsEnd || (*p >> 4) != 0x1)
+            return false;
+        int size = 1 << (*p & 0x0F);
+        ++p;
+        if (size > 8 || _objectsEnd - p < size)
+            return false;
+        *count = readBigEndian(p, size);
+        p += size;
+        return true;
+    }
+
+    bool readObject(uint64_t index, Value* out, int depth)
+    {
+        if (index >= _objectCount || depth > MAX_DEPTH)
+            return false;
+
+        uint64_t offset = readBigEndian(_offsetTable + index * _offsetSize, _offsetSize);
+        if (offset >= (uint64_t)(_objectsEnd - _data))
+            return false;
+
+        const unsigned char* p = _data + offset;
+        const unsigned char type = *p >> 4;
+        const unsigned char info = *p & 0x0F;
+        ++p;
+
+        uint64_t count = 0;
+        switch (type)
+        {
+            case 0x0:
+                // null, false, true, fill
+                if (info == 0x8 || info == 0x9)
+                    *out = (info == 0x9);
+                return true;
+
+            case 0x1:
+            {
+                int size = 1 << info;
+                if (size > 16 || _objectsEnd - p < size)
+                    return false;
+                // 16 bytes integers are only used for the values which don't fit in 8 bytes
+                *out = (int)(int64_t)readBigEndian(p + (size > 8 ? size - 8 : 0), size > 8 ? 8 : size);
+                return true;
+            }
+
+            case 0x2:
+            {
+                int size = 1 << info;
+                if ((size != 4 && size != 8) || _objectsEnd - p < size)
+                    return false;
+                uint64_t bits = readBigEndian(p, size);
+                if (size == 4)
+                {
+                    uint32_t bits32 = (uint32_t)bits;
+                    float value;
+                    memcpy(&value, &bits32, sizeof(value));
+                    *out = (double)value;
+                }
+                else
+                {
+                    double value;
+                    memcpy(&value, &bits, sizeof(value));
+                    *out = value;
+                }
+                return true;
+            }
+
+            case 0x5:
+            case 0x7:
+                // ASCII and UTF-8 strings
+                if (!readCount(info, p, &count) || (uint64_t)(_objectsEnd - p) < count)
+                    return false;
+                *out = std::string(reinterpret_cast<const char*>(p), (size_t)count);
+                return true;
+
+            case 0x6:
+            {
+                // UTF-16 big endian strings
+                if (!readCount(info, p, &count) || (uint64_t)(_objectsEnd - p) / 2 < count)
+                    return false;
+                std::u16string utf16((size_t)count, 0);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    utf16[i] = (char16_t)((p[i * 2] << 8) | p[i * 2 + 1]);
+                }
+                std::string utf8;
+                StringUtils::UTF16ToUTF8(utf16, utf8);
+                *out = utf8;
+                return true;
+            }
+
+            case 0xA:
+            case 0xC:
+            {
+                // arrays and sets
+                if (!readCount(info, p, &count) || (uint64_t)(_objectsEnd - p) / _objectRefSize < count)
+                    return false;
+
+                ValueVector array;
+                array.reserve((size_t)count);
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    Value value;
+                    if (!readObject(readBigEndian(p + i * _objectRefSize, _objectRefSize), &value, depth + 1))
+                        return false;
+                    if (!value.isNull())
+                        array.push_back(std::move(value));
+                }
+                *out = std::move(array);
+                return true;
+            }
+
+            case 0xD:
+            {
+                // the references of the keys, then the ones of the values
+                if (!readCount(info, p, &count) || (uint64_t)(_objectsEnd - p) / _objectRefSize / 2 < count)
+                    return false;
+
+                ValueMap dict;
+                dict.reserve((size_t)count);
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    Value key;
+                    Value value;
+                    if (!readObject(readBigEndian(p + i * _objectRefSize, _objectRefSize), &key, depth + 1)
+                        || !readObject(readBigEndian(p + (count + i) * _objectRefSize, _objectRefSize), &value, depth + 1))
+                        return false;
+                    if (key.getType() != Value::Type::STRING)
+                        return false;
+                    if (!value.isNull())
+                        dict[key.asString()] = std::move(value);
+                }
+                *out = std::move(dict);
+                return true;
+            }
+
+            default:
+                // dates, data and UIDs
+                return true;
+        }
+    }
+
+    const unsigned char* _data;
+    const unsigned char* _objectsEnd;
+    const unsigned char* _offsetTable;
+    int _offsetSize;
+    int _objectRefSize;
+    uint64_t _objectCount;
+};
+
+//
+// PlistParser
+//
+
+bool PlistParser::isBinaryPlist(const char* data, ssize_t dataLen)
+{
+    return dataLen >= (ssize_t)sizeof(BINARY_PLIST_MAGIC) + BINARY_PLIST_TRAILER_SIZE
+        && memcmp(data, BINARY_PLIST_MAGIC, sizeof(BINARY_PLIST_MAGIC)) == 0;
+}
+
+bool PlistParser::parseRoot(const char* data, ssize_t dataLen, Value* root)
+{
+    if (data == nullptr || dataLen <= 0)
+        return false;
+
+    if (isBinaryPlist(data, dataLen))
+    {
+        BinaryPlistReader reader(data, dataLen);
+        return reader.readRoot(root);
+    }
+
+    XmlPlistReader reader(data, dataLen);
+    if (!reader.readRoot(root))
+    {
+        CCLOG("cocos2d: PlistParser: invalid plist");
+        return false;
+    }
+    return true;
+}
+
+bool PlistParser::parse(const char* data, ssize_t dataLen, ValueMap* dict)
+{
+    Value root;
+    if (!parseRoot(data, dataLen, &root) || root.getType() != Value::Type::MAP)
+        return false;
+
+    *dict = std::move(root.asValueMap());
+    return true;
+}
+
+bool PlistParser::parse(const char* data, ssize_t dataLen, ValueVector* array)
+{
+    Value root;
+    if (!parseRoot(data, dataLen, &root) || root.getType() != Value::Type::VECTOR)
+        return false;
+
+    *array = std::move(root.asValueVector());
+    return true;
+}
+
+NS_CC_END
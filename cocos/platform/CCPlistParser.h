@@ -0,0 +1,71 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CC_PLIST_PARSER_H__
+#define __CC_PLIST_PARSER_H__
+
+#include "base/CCValue.h"
+
+/**
+ * @addtogroup platform
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class PlistParser
+ * @brief Reads property lists into Values in a single pass over the data.
+ *
+ * Unlike SAXParser, no XML document is built first: the Values are created as the elements are read.
+ * Both the XML and the binary ("bplist00") formats are read. The values are typed as FileUtils always did:
+ * integers are Value::Type::INTEGER, reals Value::Type::DOUBLE. Dates, data and UIDs are skipped.
+ * @js NA
+ */
+class CC_DLL PlistParser
+{
+public:
+    /** Returns whether the data is a binary plist. */
+    static bool isBinaryPlist(const char* data, ssize_t dataLen);
+
+    /**
+     * Parses a plist whose root is a dictionary.
+     * @return false if the data isn't a valid plist, or its root isn't a dictionary.
+     */
+    static bool parse(const char* data, ssize_t dataLen, ValueMap* dict);
+
+    /**
+     * Parses a plist whose root is an array.
+     * @return false if the data isn't a valid plist, or its root isn't an array.
+     */
+    static bool parse(const char* data, ssize_t dataLen, ValueVector* array);
+
+private:
+    static bool parseRoot(const char* data, ssize_t dataLen, Value* root);
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_PLIST_PARSER_H__
@@ -50,6 +50,8 @@ public class Cocos2dxLocalStorage {
             TABLE_NAME = tableName;
             mDatabaseOpenHelper = new DBOpenHelper(Cocos2dxActivity.getContext());
             mDatabase = mDatabaseOpenHelper.getWritableDatabase();
+            // commits append to a log instead of rewriting the database
+            mDatabase.enableWriteAheadLogging();
             return true;
         }
         return false;
@@ -109,6 +111,24 @@ public class Cocos2dxLocalStorage {
         }
     }
 
+    public static void beginTransaction() {
+        try {
+            // SQLiteDatabase nests the transactions, only the outermost one is committed
+            mDatabase.beginTransaction();
+        } catch (Exception e) {
+            e.printStackTrace();
+        }
+    }
+
+    public static void commitTransaction() {
+        try {
+            mDatabase.setTransactionSuccessful();
+            mDatabase.endTransaction();
+        } catch (Exception e) {
+            e.printStackTrace();
+        }
+    }
+
     /**
      * This creates/opens the database.
      */
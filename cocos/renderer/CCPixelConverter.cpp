@@ -0,0 +1,402 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#include "renderer/CCPixelConverter.h"
+
+//#define PIXEL_USE_SSE2     : SSE2 code used, every x86-64 CPU has it
+//#define PIXEL_USE_NEON     : NEON code used
+//#define PIXEL_CHECK_NEON   : NEON code used if the CPU supports it, on armeabi-v7a
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PIXEL_USE_SSE2
+    #include <emmintrin.h>
+#elif defined (__aarch64__) || defined (__arm64__)
+    #define PIXEL_USE_NEON
+    #include <arm_neon.h>
+#elif defined (__ARM_NEON__)
+    #define PIXEL_USE_NEON
+    #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+    #define PIXEL_CHECK_NEON
+    #include <cpu-features.h>
+    #endif
+    #include <arm_neon.h>
+#endif
+
+NS_CC_BEGIN
+
+static bool s_enabled = true;
+
+PixelConverter::InstructionSet PixelConverter::getInstructionSet()
+{
+#if defined (PIXEL_USE_SSE2)
+    return InstructionSet::SSE2;
+#elif defined (PIXEL_CHECK_NEON)
+    static const bool hasNeon = android_getCpuFamily() == ANDROID_CPU_FAMILY_ARM
+        && (android_getCpuFeatures() & ANDROID_CPU_ARM_FEATURE_NEON) != 0;
+    return hasNeon ? InstructionSet::NEON : InstructionSet::NONE;
+#elif defined (PIXEL_USE_NEON)
+    return InstructionSet::NEON;
+#else
+    return InstructionSet::NONE;
+#endif
+}
+
+void PixelConverter::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+bool PixelConverter::isEnabled()
+{
+    return s_enabled;
+}
+
+static bool useKernels()
+{
+    return s_enabled && PixelConverter::getInstructionSet() != PixelConverter::InstructionSet::NONE;
+}
+
+#if defined (PIXEL_USE_SSE2)
+// packs the low 16 bits of the 32 bit lanes of two vectors, _mm_packs_epi32 alone would saturate them
+static inline __m128i packLow16(__m128i v0, __m128i v1)
+{
+    return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(v0, 16), 16),
+                           _mm_srai_epi32(_mm_slli_epi32(v1, 16), 16));
+}
+#endif
+
+ssize_t PixelConverter::convertI8ToRGBA8888(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_SSE2)
+    const __m128i alpha = _mm_set1_epi32(0xFF000000);
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        __m128i in = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i lo = _mm_unpacklo_epi8(in, in);
+        __m128i hi = _mm_unpackhi_epi8(in, in);
+        __m128i* out = (__m128i*)(outData + i * 4);
+        _mm_storeu_si128(out, _mm_or_si128(_mm_unpacklo_epi16(lo, lo), alpha));
+        _mm_storeu_si128(out + 1, _mm_or_si128(_mm_unpackhi_epi16(lo, lo), alpha));
+        _mm_storeu_si128(out + 2, _mm_or_si128(_mm_unpacklo_epi16(hi, hi), alpha));
+        _mm_storeu_si128(out + 3, _mm_or_si128(_mm_unpackhi_epi16(hi, hi), alpha));
+    }
+#elif defined (PIXEL_USE_NEON)
+    uint8x16x4_t out;
+    out.val[3] = vdupq_n_u8(0xFF);
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        uint8x16_t in = vld1q_u8(data + i);
+        out.val[0] = in;
+        out.val[1] = in;
+        out.val[2] = in;
+        vst4q_u8(outData + i * 4, out);
+    }
+#endif
+    return i;
+}
+
+ssize_t PixelConverter::convertAI88ToRGBA8888(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_SSE2)
+    const __m128i maskI = _mm_set1_epi16(0x00FF);
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m128i in = _mm_loadu_si128((const __m128i*)(data + i * 2));
+        __m128i intensity = _mm_and_si128(in, maskI);
+        // IIII in the low 16 bits, IA in the high ones
+        __m128i ii = _mm_or_si128(intensity, _mm_slli_epi16(intensity, 8));
+        __m128i* out = (__m128i*)(outData + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(ii, in));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(ii, in));
+    }
+#elif defined (PIXEL_USE_NEON)
+    uint8x16x4_t out;
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        uint8x16x2_t in = vld2q_u8(data + i * 2);
+        out.val[0] = in.val[0];
+        out.val[1] = in.val[0];
+        out.val[2] = in.val[0];
+        out.val[3] = in.val[1];
+        vst4q_u8(outData + i * 4, out);
+    }
+#endif
+    return i;
+}
+
+ssize_t PixelConverter::convertRGB888ToRGBA8888(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_NEON)
+    uint8x16x4_t out;
+    out.val[3] = vdupq_n_u8(0xFF);
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        uint8x16x3_t in = vld3q_u8(data + i * 3);
+        out.val[0] = in.val[0];
+        out.val[1] = in.val[1];
+        out.val[2] = in.val[2];
+        vst4q_u8(outData + i * 4, out);
+    }
+#endif
+    // SSE2 has no byte shuffle, the scalar code is as fast
+    return i;
+}
+
+ssize_t PixelConverter::convertRGBA8888ToRGB888(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_NEON)
+    uint8x16x3_t out;
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        uint8x16x4_t in = vld4q_u8(data + i * 4);
+        out.val[0] = in.val[0];
+        out.val[1] = in.val[1];
+        out.val[2] = in.val[2];
+        vst3q_u8(outData + i * 3, out);
+    }
+#endif
+    return i;
+}
+
+ssize_t PixelConverter::convertRGB888ToRGB565(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_NEON)
+    const uint8x8_t mask5 = vdup_n_u8(0xF8);
+    const uint8x8_t mask6 = vdup_n_u8(0xFC);
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        uint8x8x3_t in = vld3_u8(data + i * 3);
+        uint16x8_t r = vshlq_n_u16(vmovl_u8(vand_u8(in.val[0], mask5)), 8);
+        uint16x8_t g = vshlq_n_u16(vmovl_u8(vand_u8(in.val[1], mask6)), 3);
+        uint16x8_t b = vmovl_u8(vshr_n_u8(in.val[2], 3));
+        vst1q_u8(outData + i * 2, vreinterpretq_u8_u16(vorrq_u16(r, vorrq_u16(g, b))));
+    }
+#endif
+    return i;
+}
+
+ssize_t PixelConverter::convertRGBA8888ToRGB565(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_SSE2)
+    const __m128i maskR = _mm_set1_epi32(0xF8);
+    const __m128i maskG = _mm_set1_epi32(0x7E0);
+    const __m128i maskB = _mm_set1_epi32(0x1F);
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m128i out[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            __m128i in = _mm_loadu_si128((const __m128i*)(data + (i + j * 4) * 4));
+            __m128i r = _mm_slli_epi32(_mm_and_si128(in, maskR), 8);
+            __m128i g = _mm_and_si128(_mm_srli_epi32(in, 5), maskG);
+            __m128i b = _mm_and_si128(_mm_srli_epi32(in, 19), maskB);
+            out[j] = _mm_or_si128(r, _mm_or_si128(g, b));
+        }
+        _mm_storeu_si128((__m128i*)(outData + i * 2), packLow16(out[0], out[1]));
+    }
+#elif defined (PIXEL_USE_NEON)
+    const uint8x8_t mask5 = vdup_n_u8(0xF8);
+    const uint8x8_t mask6 = vdup_n_u8(0xFC);
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        uint8x8x4_t in = vld4_u8(data + i * 4);
+        uint16x8_t r = vshlq_n_u16(vmovl_u8(vand_u8(in.val[0], mask5)), 8);
+        uint16x8_t g = vshlq_n_u16(vmovl_u8(vand_u8(in.val[1], mask6)), 3);
+        uint16x8_t b = vmovl_u8(vshr_n_u8(in.val[2], 3));
+        vst1q_u8(outData + i * 2, vreinterpretq_u8_u16(vorrq_u16(r, vorrq_u16(g, b))));
+    }
+#endif
+    return i;
+}
+
+ssize_t PixelConverter::convertRGBA8888ToRGBA4444(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_SSE2)
+    const __m128i maskR = _mm_set1_epi32(0xF0);
+    const __m128i maskG = _mm_set1_epi32(0xF00);
+    const __m128i maskB = _mm_set1_epi32(0xF0);
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m128i out[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            __m128i in = _mm_loadu_si128((const __m128i*)(data + (i + j * 4) * 4));
+            __m128i r = _mm_slli_epi32(_mm_and_si128(in, maskR), 8);
+            __m128i g = _mm_and_si128(_mm_srli_epi32(in, 4), maskG);
+            __m128i b = _mm_and_si128(_mm_srli_epi32(in, 16), maskB);
+            __m128i a = _mm_srli_epi32(in, 28);
+            out[j] = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+        }
+        _mm_storeu_si128((__m128i*)(outData + i * 2), packLow16(out[0], out[1]));
+    }
+#elif defined (PIXEL_USE_NEON)
+    const uint8x8_t mask4 = vdup_n_u8(0xF0);
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        uint8x8x4_t in = vld4_u8(data + i * 4);
+        uint16x8_t r = vshlq_n_u16(vmovl_u8(vand_u8(in.val[0], mask4)), 8);
+        uint16x8_t g = vshlq_n_u16(vmovl_u8(vand_u8(in.val[1], mask4)), 4);
+        uint16x8_t b = vmovl_u8(vand_u8(in.val[2], mask4));
+        uint16x8_t a = vmovl_u8(vshr_n_u8(in.val[3], 4));
+        vst1q_u8(outData + i * 2, vreinterpretq_u8_u16(vorrq_u16(vorrq_u16(r, g), vorrq_u16(b, a))));
+    }
+#endif
+    return i;
+}
+
+ssize_t PixelConverter::convertRGBA8888ToRGB5A1(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_SSE2)
+    const __m128i maskR = _mm_set1_epi32(0xF8);
+    const __m128i maskG = _mm_set1_epi32(0x7C0);
+    const __m128i maskB = _mm_set1_epi32(0x3E);
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        __m128i out[2];
+        for (int j = 0; j < 2; ++j)
+        {
+            __m128i in = _mm_loadu_si128((const __m128i*)(data + (i + j * 4) * 4));
+            __m128i r = _mm_slli_epi32(_mm_and_si128(in, maskR), 8);
+            __m128i g = _mm_and_si128(_mm_srli_epi32(in, 5), maskG);
+            __m128i b = _mm_and_si128(_mm_srli_epi32(in, 18), maskB);
+            __m128i a = _mm_srli_epi32(in, 31);
+            out[j] = _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+        }
+        _mm_storeu_si128((__m128i*)(outData + i * 2), packLow16(out[0], out[1]));
+    }
+#elif defined (PIXEL_USE_NEON)
+    const uint8x8_t mask5 = vdup_n_u8(0xF8);
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        uint8x8x4_t in = vld4_u8(data + i * 4);
+        uint16x8_t r = vshlq_n_u16(vmovl_u8(vand_u8(in.val[0], mask5)), 8);
+        uint16x8_t g = vshlq_n_u16(vmovl_u8(vand_u8(in.val[1], mask5)), 3);
+        uint16x8_t b = vshlq_n_u16(vmovl_u8(vshr_n_u8(in.val[2], 3)), 1);
+        uint16x8_t a = vmovl_u8(vshr_n_u8(in.val[3], 7));
+        vst1q_u8(outData + i * 2, vreinterpretq_u8_u16(vorrq_u16(vorrq_u16(r, g), vorrq_u16(b, a))));
+    }
+#endif
+    return i;
+}
+
+ssize_t PixelConverter::convertRGBA8888ToA8(const unsigned char* data, ssize_t pixelCount, unsigned char* outData)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_SSE2)
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        const __m128i* in = (const __m128i*)(data + i * 4);
+        __m128i a0 = _mm_srli_epi32(_mm_loadu_si128(in), 24);
+        __m128i a1 = _mm_srli_epi32(_mm_loadu_si128(in + 1), 24);
+        __m128i a2 = _mm_srli_epi32(_mm_loadu_si128(in + 2), 24);
+        __m128i a3 = _mm_srli_epi32(_mm_loadu_si128(in + 3), 24);
+        __m128i out = _mm_packus_epi16(_mm_packs_epi32(a0, a1), _mm_packs_epi32(a2, a3));
+        _mm_storeu_si128((__m128i*)(outData + i), out);
+    }
+#elif defined (PIXEL_USE_NEON)
+    for (; i + 16 <= pixelCount; i += 16)
+    {
+        uint8x16x4_t in = vld4q_u8(data + i * 4);
+        vst1q_u8(outData + i, in.val[3]);
+    }
+#endif
+    return i;
+}
+
+ssize_t PixelConverter::premultiplyAlpha(unsigned char* data, ssize_t pixelCount)
+{
+    if (!useKernels())
+        return 0;
+
+    ssize_t i = 0;
+#if defined (PIXEL_USE_SSE2)
+    // c * (a + 1) >> 8 for the colors, a * 256 >> 8 for the alpha, it fits in 16 bits
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i maskRGB = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alphaFactor = _mm_set_epi16(256, 0, 0, 0, 256, 0, 0, 0);
+    for (; i + 4 <= pixelCount; i += 4)
+    {
+        __m128i* p = (__m128i*)(data + i * 4);
+        __m128i in = _mm_loadu_si128(p);
+        __m128i half[2] = { _mm_unpacklo_epi8(in, zero), _mm_unpackhi_epi8(in, zero) };
+        for (int j = 0; j < 2; ++j)
+        {
+            __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(half[j], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            __m128i factor = _mm_or_si128(_mm_and_si128(_mm_add_epi16(a, one), maskRGB), alphaFactor);
+            half[j] = _mm_srli_epi16(_mm_mullo_epi16(half[j], factor), 8);
+        }
+        _mm_storeu_si128(p, _mm_packus_epi16(half[0], half[1]));
+    }
+#elif defined (PIXEL_USE_NEON)
+    for (; i + 8 <= pixelCount; i += 8)
+    {
+        uint8x8x4_t p = vld4_u8(data + i * 4);
+        uint16x8_t factor = vaddw_u8(vdupq_n_u16(1), p.val[3]);
+        p.val[0] = vshrn_n_u16(vmulq_u16(vmovl_u8(p.val[0]), factor), 8);
+        p.val[1] = vshrn_n_u16(vmulq_u16(vmovl_u8(p.val[1]), factor), 8);
+        p.val[2] = vshrn_n_u16(vmulq_u16(vmovl_u8(p.val[2]), factor), 8);
+        vst4_u8(data + i * 4, p);
+    }
+#endif
+    return i;
+}
+
+NS_CC_END
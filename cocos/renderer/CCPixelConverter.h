@@ -0,0 +1,97 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+#ifndef __CC_PIXEL_CONVERTER_H__
+#define __CC_PIXEL_CONVERTER_H__
+
+#include "platform/CCPlatformMacros.h"
+#include "platform/CCStdC.h" // for ssize_t on window
+#include <stdint.h> // for ssize_t on android
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class PixelConverter
+ * @brief SSE2/NEON kernels of the pixel format conversions of Texture2D, and of the alpha premultiplication of Image.
+ *
+ * The instruction set is chosen when the program runs (NEON is optional on 32 bit ARM devices).
+ * The kernels convert the pixels by blocks, and return how many pixels they converted: the caller
+ * converts the remaining ones with the scalar code, which stays the reference implementation.
+ * When no instruction set is available, or when the kernels are disabled, they return 0.
+ * @js NA
+ */
+class CC_DLL PixelConverter
+{
+public:
+    enum class InstructionSet
+    {
+        NONE,
+        SSE2,
+        NEON,
+    };
+
+    /** Returns the instruction set supported by the CPU, whether the kernels are enabled or not. */
+    static InstructionSet getInstructionSet();
+
+    /**
+     * Enables or disables the kernels, they are enabled by default.
+     * Disabling them makes every conversion run the scalar code, e.g. to compare them.
+     */
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    /** IIIIIIII -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA */
+    static ssize_t convertI8ToRGBA8888(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+    /** IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA */
+    static ssize_t convertAI88ToRGBA8888(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+    /** RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA, NEON only. */
+    static ssize_t convertRGB888ToRGBA8888(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+    /** RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB, NEON only. */
+    static ssize_t convertRGBA8888ToRGB888(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+    /** RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGGBBBBB, NEON only. */
+    static ssize_t convertRGB888ToRGB565(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+    /** RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGGGGGBBBBB */
+    static ssize_t convertRGBA8888ToRGB565(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+    /** RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRGGGGBBBBAAAA */
+    static ssize_t convertRGBA8888ToRGBA4444(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+    /** RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGGGGBBBBBA */
+    static ssize_t convertRGBA8888ToRGB5A1(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+    /** RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> AAAAAAAA */
+    static ssize_t convertRGBA8888ToA8(const unsigned char* data, ssize_t pixelCount, unsigned char* outData);
+
+    /**
+     * Premultiplies RGBA8888 pixels in place, with the same rounding as CC_RGB_PREMULTIPLY_ALPHA.
+     */
+    static ssize_t premultiplyAlpha(unsigned char* data, ssize_t pixelCount);
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_PIXEL_CONVERTER_H__
@@ -68,6 +68,7 @@ void QuadCommand::init(float globalOrder, GLuint textureID, GLProgramState* glPr
     triangles.indices = __indices;
     triangles.indexCount = (int)quadCount * 6;
     TrianglesCommand::init(globalOrder, textureID, glProgramState, blendType, triangles, mv, flags);
+    _isQuads = true;
 }
 
 void QuadCommand::reIndex(int indicesCount)
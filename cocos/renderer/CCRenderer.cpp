@@ -44,7 +44,9 @@
 #include "base/CCEventDispatcher.h"
 #include "base/CCEventListenerCustom.h"
 #include "base/CCEventType.h"
+#include "base/CCWorkerPool.h"
 #include "2d/CCScene.h"
+#include "math/MathUtil.h"
 
 NS_CC_BEGIN
 
@@ -54,6 +56,31 @@ static bool compareRenderCommand(RenderCommand* a, RenderCommand* b)
     return a->getGlobalOrder() < b->getGlobalOrder();
 }
 
+// below this size a stable comparison sort is faster than the radix passes
+static const size_t RADIX_SORT_MIN_SIZE = 64;
+
+// maps a float to an unsigned integer with the same ordering
+static inline uint32_t sortableFloatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    // negative numbers: flip all bits; positive numbers: flip the sign bit
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+static inline uint32_t commandMaterialID(RenderCommand* command)
+{
+    switch (command->getType())
+    {
+        case RenderCommand::Type::TRIANGLES_COMMAND:
+            return static_cast<TrianglesCommand*>(command)->getMaterialID();
+        case RenderCommand::Type::MESH_COMMAND:
+            return static_cast<MeshCommand*>(command)->getMaterialID();
+        default:
+            return 0;
+    }
+}
+
 // queue
 RenderQueue::RenderQueue()
 {
@@ -88,11 +115,72 @@ ssize_t RenderQueue::size() const
     return result;
 }
 
-void RenderQueue::sort()
+void RenderQueue::sort(bool byMaterial)
 {
     // Don't sort _queue0, it already comes sorted
-    std::sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_NEG]), std::end(_commands[QUEUE_GROUP::GLOBALZ_NEG]), compareRenderCommand);
-    std::sort(std::begin(_commands[QUEUE_GROUP::GLOBALZ_POS]), std::end(_commands[QUEUE_GROUP::GLOBALZ_POS]), compareRenderCommand);
+    sortCommands(_commands[QUEUE_GROUP::GLOBALZ_NEG], byMaterial);
+    sortCommands(_commands[QUEUE_GROUP::GLOBALZ_POS], byMaterial);
+}
+
+void RenderQueue::sortCommands(std::vector<RenderCommand*>& commands, bool byMaterial)
+{
+    const size_t count = commands.size();
+    if (count < 2)
+        return;
+
+    if (!byMaterial && count < RADIX_SORT_MIN_SIZE)
+    {
+        std::stable_sort(std::begin(commands), std::end(commands), compareRenderCommand);
+        return;
+    }
+
+    // key: globalZ in the high 32 bits, material ID (if any) in the low 32 bits
+    _sortEntries.resize(count);
+    _sortScratch.resize(count);
+    uint64_t allBitsOr = 0;
+    uint64_t allBitsAnd = ~(uint64_t)0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        RenderCommand* command = commands[i];
+        uint64_t key = (uint64_t)sortableFloatBits(command->getGlobalOrder()) << 32;
+        if (byMaterial)
+            key |= commandMaterialID(command);
+
+        _sortEntries[i].key = key;
+        _sortEntries[i].command = command;
+        allBitsOr |= key;
+        allBitsAnd &= key;
+    }
+
+    // LSD radix sort, 8 bits per pass. Every pass is stable, so the whole sort is.
+    SortEntry* src = _sortEntries.data();
+    SortEntry* dst = _sortScratch.data();
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        // skip the digits that are the same for all the keys, e.g. the material ID bytes when not used
+        if ((((allBitsOr ^ allBitsAnd) >> shift) & 0xff) == 0)
+            continue;
+
+        size_t offsets[256] = { 0 };
+        for (size_t i = 0; i < count; ++i)
+            ++offsets[(src[i].key >> shift) & 0xff];
+
+        size_t total = 0;
+        for (int digit = 0; digit < 256; ++digit)
+        {
+            size_t digitCount = offsets[digit];
+            offsets[digit] = total;
+            total += digitCount;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+
+        std::swap(src, dst);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+        commands[i] = src[i].command;
 }
 
 RenderCommand* RenderQueue::operator[](ssize_t index) const
@@ -185,6 +273,19 @@ Renderer::Renderer()
 ,_glViewAssigned(false)
 ,_isRendering(false)
 ,_isDepthTestFor2D(false)
+,_isMultithreadedFill(false)
+,_isSortByMaterial(false)
+,_isReorderByMaterial(false)
+,_quadIndicesVBO(0)
+,_isQuadsOnlyBatch(false)
+,_isRingBufferEnabled(false)
+,_ringVertexOffset(0)
+,_ringIndexOffset(0)
+,_drawnBatches(0)
+,_drawnVertices(0)
+,_savedBatches(0)
+,_uploadedBytes(0)
+,_ringBufferWraps(0)
 ,_triBatchesToDraw(nullptr)
 ,_triBatchesToDrawCapacity(-1)
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -198,6 +299,7 @@ Renderer::Renderer()
     RenderQueue defaultRenderQueue;
     _renderGroups.push_back(defaultRenderQueue);
     _queuedTriangleCommands.reserve(BATCH_TRIAGCOMMAND_RESERVED_SIZE);
+    _queuedTriangleOffsets.reserve(BATCH_TRIAGCOMMAND_RESERVED_SIZE);
 
     // default clear color
     _clearColor = Color4F::BLACK;
@@ -212,15 +314,10 @@ Renderer::~Renderer()
     _renderGroups.clear();
     _groupCommandManager->release();
 
-    glDeleteBuffers(2, _buffersVBO);
+    deleteBuffers();
 
     free(_triBatchesToDraw);
 
-    if (Configuration::getInstance()->supportsShareableVAO())
-    {
-        glDeleteVertexArrays(1, &_buffersVAO);
-        GL::bindVAO(0);
-    }
 #if CC_ENABLE_CACHE_TEXTURE_DATA
     Director::getInstance()->getEventDispatcher()->removeEventListener(_cacheTextureListener);
 #endif
@@ -244,6 +341,9 @@ void Renderer::initGLView()
 
 void Renderer::setupBuffer()
 {
+    _ringVertexOffset = 0;
+    _ringIndexOffset = 0;
+
     if(Configuration::getInstance()->supportsShareableVAO())
     {
         setupVBOAndVAO();
@@ -252,6 +352,60 @@ void Renderer::setupBuffer()
     {
         setupVBO();
     }
+
+    setupQuadIndices();
+}
+
+void Renderer::setupQuadIndices()
+{
+    // _indices is only used as scratch memory here
+    for (int i = 0; i < INDEX_VBO_SIZE / 6; i++)
+    {
+        _indices[i*6+0] = (GLushort) (i*4+0);
+        _indices[i*6+1] = (GLushort) (i*4+1);
+        _indices[i*6+2] = (GLushort) (i*4+2);
+        _indices[i*6+3] = (GLushort) (i*4+3);
+        _indices[i*6+4] = (GLushort) (i*4+2);
+        _indices[i*6+5] = (GLushort) (i*4+1);
+    }
+
+    // Avoid changing the element buffer for whatever VAO might be bound.
+    GL::bindVAO(0);
+
+    glGenBuffers(1, &_quadIndicesVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadIndicesVBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    CHECK_GL_ERROR_DEBUG();
+}
+
+void Renderer::deleteBuffers()
+{
+    glDeleteBuffers(2, _buffersVBO);
+    glDeleteBuffers(1, &_quadIndicesVBO);
+
+    if (Configuration::getInstance()->supportsShareableVAO())
+    {
+        glDeleteVertexArrays(1, &_buffersVAO);
+        GL::bindVAO(0);
+    }
+}
+
+void Renderer::setRingBufferEnabled(bool enabled)
+{
+    CCASSERT(!_isRendering, "Cannot change the vertex buffers while rendering");
+    if (_isRingBufferEnabled == enabled)
+        return;
+
+    _isRingBufferEnabled = enabled;
+
+    // the buffers are sized (and the VAO is set up) for a given mode
+    if (_glViewAssigned)
+    {
+        deleteBuffers();
+        setupBuffer();
+    }
 }
 
 void Renderer::setupVBOAndVAO()
@@ -263,7 +417,10 @@ void Renderer::setupVBOAndVAO()
     glGenBuffers(2, &_buffersVBO[0]);
 
     glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
+    if (_isRingBufferEnabled)
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * RING_VBO_SIZE, nullptr, GL_DYNAMIC_DRAW);
+    else
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * VBO_SIZE, _verts, GL_DYNAMIC_DRAW);
 
     // vertices
     glEnableVertexAttribArray(GLProgram::VERTEX_ATTRIB_POSITION);
@@ -278,7 +435,10 @@ void Renderer::setupVBOAndVAO()
     glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) offsetof( V3F_C4B_T2F, texCoords));
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
+    if (_isRingBufferEnabled)
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * RING_INDEX_VBO_SIZE, nullptr, GL_DYNAMIC_DRAW);
+    else
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * INDEX_VBO_SIZE, _indices, GL_STATIC_DRAW);
 
     // Must unbind the VAO before changing the element buffer.
     GL::bindVAO(0);
@@ -299,6 +459,22 @@ void Renderer::setupVBO()
     // once glBufferData/glBufferSubData is invoked.
     // For more discussion, please refer to https://github.com/cocos2d/cocos2d-x/issues/15652
 //    mapBuffers();
+
+    // The ring buffers are written with glBufferSubData(), so they must have their storage
+    if (_isRingBufferEnabled)
+    {
+        GL::bindVAO(0);
+
+        glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * RING_VBO_SIZE, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * RING_INDEX_VBO_SIZE, nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+        CHECK_GL_ERROR_DEBUG();
+    }
 }
 
 void Renderer::mapBuffers()
@@ -538,6 +714,10 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     //
     //Process Global-Z = 0 Queue
     //
+    if (_isReorderByMaterial)
+    {
+        reorderByMaterial(queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_ZERO));
+    }
     const auto& zZeroQueue = queue.getSubQueue(RenderQueue::QUEUE_GROUP::GLOBALZ_ZERO);
     if (zZeroQueue.size() > 0)
     {
@@ -610,6 +790,126 @@ void Renderer::visitRenderQueue(RenderQueue& queue)
     queue.restoreRenderState();
 }
 
+// how many batches a command may be moved across when looking for its material
+static const int REORDER_MAX_LOOKBACK = 16;
+
+static inline bool isReorderableCommand(RenderCommand* command)
+{
+    return command->getType() == RenderCommand::Type::TRIANGLES_COMMAND && !command->isSkipBatching() && !command->is3D();
+}
+
+void Renderer::reorderByMaterial(std::vector<RenderCommand*>& commands)
+{
+    // only consecutive triangles can be moved, the other commands keep their place
+    const size_t count = commands.size();
+    size_t first = 0;
+    while (first < count)
+    {
+        if (!isReorderableCommand(commands[first]))
+        {
+            ++first;
+            continue;
+        }
+
+        size_t last = first + 1;
+        while (last < count && isReorderableCommand(commands[last]))
+            ++last;
+
+        if (last - first > 2)
+            reorderTrianglesRun(commands, first, last);
+
+        first = last;
+    }
+}
+
+void Renderer::reorderTrianglesRun(std::vector<RenderCommand*>& commands, size_t first, size_t last)
+{
+    const int count = (int)(last - first);
+    _reorderBatches.clear();
+    _reorderNext.assign(count, -1);
+
+    int batchesBefore = 0;
+    uint32_t prevMaterialID = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        auto cmd = static_cast<TrianglesCommand*>(commands[first + i]);
+        const uint32_t materialID = cmd->getMaterialID();
+        if (i == 0 || materialID != prevMaterialID)
+            ++batchesBefore;
+        prevMaterialID = materialID;
+
+        // screen-space bounds: transform the corners of the bounding box of the vertices
+        const V3F_C4B_T2F* verts = cmd->getVertices();
+        const ssize_t vertexCount = cmd->getVertexCount();
+        float lminX = FLT_MAX, lminY = FLT_MAX, lmaxX = -FLT_MAX, lmaxY = -FLT_MAX;
+        for (ssize_t v = 0; v < vertexCount; ++v)
+        {
+            lminX = std::min(lminX, verts[v].vertices.x);
+            lminY = std::min(lminY, verts[v].vertices.y);
+            lmaxX = std::max(lmaxX, verts[v].vertices.x);
+            lmaxY = std::max(lmaxY, verts[v].vertices.y);
+        }
+        const Mat4& mv = cmd->getModelView();
+        Vec3 corners[4] = { Vec3(lminX, lminY, 0), Vec3(lmaxX, lminY, 0), Vec3(lminX, lmaxY, 0), Vec3(lmaxX, lmaxY, 0) };
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+        for (auto& corner : corners)
+        {
+            mv.transformPoint(&corner);
+            minX = std::min(minX, corner.x);
+            minY = std::min(minY, corner.y);
+            maxX = std::max(maxX, corner.x);
+            maxY = std::max(maxY, corner.y);
+        }
+
+        // Walk back over the last batches: the command can join a batch with its material
+        // as long as it doesn't overlap anything drawn after that batch.
+        int target = -1;
+        const int batchCount = (int)_reorderBatches.size();
+        for (int b = batchCount - 1; b >= 0 && b >= batchCount - REORDER_MAX_LOOKBACK; --b)
+        {
+            const auto& batch = _reorderBatches[b];
+            if (batch.materialID == materialID)
+            {
+                target = b;
+                break;
+            }
+            if (minX < batch.maxX && batch.minX < maxX && minY < batch.maxY && batch.minY < maxY)
+                break;
+        }
+
+        if (target == -1)
+        {
+            MaterialBatch batch = { materialID, minX, minY, maxX, maxY, i, i };
+            _reorderBatches.push_back(batch);
+        }
+        else
+        {
+            auto& batch = _reorderBatches[target];
+            batch.minX = std::min(batch.minX, minX);
+            batch.minY = std::min(batch.minY, minY);
+            batch.maxX = std::max(batch.maxX, maxX);
+            batch.maxY = std::max(batch.maxY, maxY);
+            _reorderNext[batch.lastCommand] = i;
+            batch.lastCommand = i;
+        }
+    }
+
+    const int batchesAfter = (int)_reorderBatches.size();
+    if (batchesAfter == batchesBefore)
+        return;
+
+    _reorderCommands.assign(commands.begin() + first, commands.begin() + last);
+    size_t index = first;
+    for (const auto& batch : _reorderBatches)
+    {
+        for (int i = batch.firstCommand; i != -1; i = _reorderNext[i])
+            commands[index++] = _reorderCommands[i];
+    }
+
+    _savedBatches += batchesBefore - batchesAfter;
+}
+
 void Renderer::render()
 {
     //Uncomment this once everything is rendered by new renderer
@@ -624,7 +924,7 @@ void Renderer::render()
         //1. Sort render commands based on ID
         for (auto &renderqueue : _renderGroups)
         {
-            renderqueue.sort();
+            renderqueue.sort(_isSortByMaterial);
         }
         visitRenderQueue(_renderGroups[0]);
     }
@@ -687,26 +987,67 @@ void Renderer::setDepthTest(bool enable)
     CHECK_GL_ERROR_DEBUG();
 }
 
-void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd)
+void Renderer::fillVerticesAndIndices(const TrianglesCommand* cmd, int vertexOffset, int indexOffset)
 {
-    memcpy(&_verts[_filledVertex], cmd->getVertices(), sizeof(V3F_C4B_T2F) * cmd->getVertexCount());
+    memcpy(&_verts[vertexOffset], cmd->getVertices(), sizeof(V3F_C4B_T2F) * cmd->getVertexCount());
 
     // fill vertex, and convert them to world coordinates
     const Mat4& modelView = cmd->getModelView();
-    for(ssize_t i=0; i < cmd->getVertexCount(); ++i)
-    {
-        modelView.transformPoint(&(_verts[i + _filledVertex].vertices));
-    }
+    MathUtil::transformPoints(modelView.m, &_verts[vertexOffset].vertices.x, cmd->getVertexCount(), sizeof(V3F_C4B_T2F));
+
+    // quads are drawn with _quadIndicesVBO
+    if (_isQuadsOnlyBatch)
+        return;
 
     // fill index
     const unsigned short* indices = cmd->getIndices();
     for(ssize_t i=0; i< cmd->getIndexCount(); ++i)
     {
-        _indices[_filledIndex + i] = _filledVertex + indices[i];
+        _indices[indexOffset + i] = vertexOffset + indices[i];
     }
+}
 
-    _filledVertex += cmd->getVertexCount();
-    _filledIndex += cmd->getIndexCount();
+GLintptr Renderer::streamToRingBuffer()
+{
+    const GLsizeiptr vertexBytes = sizeof(_verts[0]) * _filledVertex;
+    // quads don't stream their indices
+    const GLsizeiptr indexBytes = _isQuadsOnlyBatch ? 0 : sizeof(_indices[0]) * _filledIndex;
+
+    glBindBuffer(GL_ARRAY_BUFFER, _buffersVBO[0]);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+
+    // Orphan the buffers only when they wrap around, with the exact same size and usage hints,
+    // so the driver can hand out new storage instead of waiting for the pending draws.
+    //  source: https://www.opengl.org/wiki/Buffer_Object_Streaming#Buffer_re-specification
+    if (_ringVertexOffset + vertexBytes > (GLintptr)(sizeof(_verts[0]) * RING_VBO_SIZE)
+        || _ringIndexOffset + indexBytes > (GLintptr)(sizeof(_indices[0]) * RING_INDEX_VBO_SIZE))
+    {
+        glBufferData(GL_ARRAY_BUFFER, sizeof(_verts[0]) * RING_VBO_SIZE, nullptr, GL_DYNAMIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * RING_INDEX_VBO_SIZE, nullptr, GL_DYNAMIC_DRAW);
+        _ringVertexOffset = 0;
+        _ringIndexOffset = 0;
+        _ringBufferWraps++;
+    }
+
+    // the regions written here have not been used by any draw since the last orphaning
+    glBufferSubData(GL_ARRAY_BUFFER, _ringVertexOffset, vertexBytes, _verts);
+    if (_isQuadsOnlyBatch)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadIndicesVBO);
+    else
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, _ringIndexOffset, indexBytes, _indices);
+
+    // the indices are relative to the first vertex of this flush
+    const GLintptr base = _ringVertexOffset;
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) (base + offsetof(V3F_C4B_T2F, vertices)));
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(V3F_C4B_T2F), (GLvoid*) (base + offsetof(V3F_C4B_T2F, colors)));
+    glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(V3F_C4B_T2F), (GLvoid*) (base + offsetof(V3F_C4B_T2F, texCoords)));
+
+    const GLintptr indexBufferOffset = _isQuadsOnlyBatch ? 0 : _ringIndexOffset;
+    _ringVertexOffset += vertexBytes;
+    _ringIndexOffset += indexBytes;
+    _uploadedBytes += vertexBytes + indexBytes;
+
+    return indexBufferOffset;
 }
 
 void Renderer::drawBatchedTriangles()
@@ -719,7 +1060,7 @@ void Renderer::drawBatchedTriangles()
     _filledVertex = 0;
     _filledIndex = 0;
 
-    /************** 1: Setup up vertices/indices *************/
+    /************** 1: Setup up batches and vertices/indices offsets *************/
 
     _triBatchesToDraw[0].offset = 0;
     _triBatchesToDraw[0].indicesToDraw = 0;
@@ -729,13 +1070,22 @@ void Renderer::drawBatchedTriangles()
     int prevMaterialID = -1;
     bool firstCommand = true;
 
-    for(auto it = std::begin(_queuedTriangleCommands); it != std::end(_queuedTriangleCommands); ++it)
+    _queuedTriangleOffsets.resize(_queuedTriangleCommands.size());
+    auto offsetIt = std::begin(_queuedTriangleOffsets);
+    _isQuadsOnlyBatch = true;
+
+    for(auto it = std::begin(_queuedTriangleCommands); it != std::end(_queuedTriangleCommands); ++it, ++offsetIt)
     {
         const auto& cmd = *it;
         auto currentMaterialID = cmd->getMaterialID();
         const bool batchable = !cmd->isSkipBatching();
 
-        fillVerticesAndIndices(cmd);
+        // prefix sums of the vertex and index counts
+        offsetIt->vertexOffset = _filledVertex;
+        offsetIt->indexOffset = _filledIndex;
+        _filledVertex += cmd->getVertexCount();
+        _filledIndex += cmd->getIndexCount();
+        _isQuadsOnlyBatch = _isQuadsOnlyBatch && cmd->isQuads();
 
         // in the same batch ?
         if (batchable && (prevMaterialID == currentMaterialID || firstCommand))
@@ -771,9 +1121,42 @@ void Renderer::drawBatchedTriangles()
     }
     batchesTotal++;
 
-    /************** 2: Copy vertices/indices to GL objects *************/
+    /************** 2: Fill vertices/indices *************/
+    if (_isMultithreadedFill && _filledVertex >= MULTITHREADED_FILL_MIN_VERTICES)
+    {
+        // every command writes to its own range of _verts and _indices, so they can be filled concurrently
+        WorkerPool::getInstance()->parallelFor((ssize_t)_queuedTriangleCommands.size(), 16, [this](ssize_t begin, ssize_t end){
+            for (ssize_t i = begin; i < end; ++i)
+            {
+                const auto& offset = _queuedTriangleOffsets[i];
+                fillVerticesAndIndices(_queuedTriangleCommands[i], offset.vertexOffset, offset.indexOffset);
+            }
+        });
+    }
+    else
+    {
+        for (size_t i = 0, count = _queuedTriangleCommands.size(); i < count; ++i)
+        {
+            const auto& offset = _queuedTriangleOffsets[i];
+            fillVerticesAndIndices(_queuedTriangleCommands[i], offset.vertexOffset, offset.indexOffset);
+        }
+    }
+
+    /************** 3: Copy vertices/indices to GL objects *************/
+    // offset of the first index of this flush in the index buffer, in bytes
+    GLintptr indexBufferOffset = 0;
+
     auto conf = Configuration::getInstance();
-    if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
+    if (_isRingBufferEnabled)
+    {
+        if (conf->supportsShareableVAO())
+            GL::bindVAO(_buffersVAO);
+        else
+            GL::enableVertexAttribs(GL::VERTEX_ATTRIB_FLAG_POS_COLOR_TEX);
+
+        indexBufferOffset = streamToRingBuffer();
+    }
+    else if (conf->supportsShareableVAO() && conf->supportsMapBuffer())
     {
         //Bind VAO
         GL::bindVAO(_buffersVAO);
@@ -797,8 +1180,15 @@ void Renderer::drawBatchedTriangles()
 
         glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
+        if (_isQuadsOnlyBatch)
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadIndicesVBO);
+        }
+        else
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
+        }
     }
     else
     {
@@ -819,21 +1209,35 @@ void Renderer::drawBatchedTriangles()
         // tex coords
         glVertexAttribPointer(GLProgram::VERTEX_ATTRIB_TEX_COORD, 2, GL_FLOAT, GL_FALSE, kQuadSize, (GLvoid*) offsetof(V3F_C4B_T2F, texCoords));
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
+        if (_isQuadsOnlyBatch)
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _quadIndicesVBO);
+        }
+        else
+        {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _buffersVBO[1]);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(_indices[0]) * _filledIndex, _indices, GL_STATIC_DRAW);
+        }
+    }
+
+    if (!_isRingBufferEnabled)
+    {
+        _uploadedBytes += sizeof(_verts[0]) * _filledVertex;
+        if (!_isQuadsOnlyBatch)
+            _uploadedBytes += sizeof(_indices[0]) * _filledIndex;
     }
 
-    /************** 3: Draw *************/
+    /************** 4: Draw *************/
     for (int i=0; i<batchesTotal; ++i)
     {
         CC_ASSERT(_triBatchesToDraw[i].cmd && "Invalid batch");
         _triBatchesToDraw[i].cmd->useMaterial();
-        glDrawElements(GL_TRIANGLES, (GLsizei) _triBatchesToDraw[i].indicesToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (_triBatchesToDraw[i].offset*sizeof(_indices[0])) );
+        glDrawElements(GL_TRIANGLES, (GLsizei) _triBatchesToDraw[i].indicesToDraw, GL_UNSIGNED_SHORT, (GLvoid*) (indexBufferOffset + _triBatchesToDraw[i].offset*sizeof(_indices[0])) );
         _drawnBatches++;
         _drawnVertices += _triBatchesToDraw[i].indicesToDraw;
     }
 
-    /************** 4: Cleanup *************/
+    /************** 5: Cleanup *************/
     if (Configuration::getInstance()->supportsShareableVAO())
     {
         //Unbind VAO
@@ -94,8 +94,11 @@ public:
     void push_back(RenderCommand* command);
     /**Return the number of render commands.*/
     ssize_t size() const;
-    /**Sort the render commands.*/
-    void sort();
+    /**Sort the render commands with globalZ != 0.
+     The sort is stable: commands with the same globalZ keep the order they were pushed in.
+     @param byMaterial Also group the commands with the same globalZ by material ID, to batch them.
+     */
+    void sort(bool byMaterial = false);
     /**Treat sorted commands as an array, access them one by one.*/
     RenderCommand* operator[](ssize_t index) const;
     /**Clear all rendered commands.*/
@@ -113,9 +116,21 @@ public:
     void restoreRenderState();
 
 protected:
+    /**Radix sort the commands of a queue group by (globalZ, material ID) keys.*/
+    void sortCommands(std::vector<RenderCommand*>& commands, bool byMaterial);
+
     /**The commands in the render queue.*/
     std::vector<RenderCommand*> _commands[QUEUE_COUNT];
 
+    /**Scratch buffers of the sort.*/
+    struct SortEntry
+    {
+        uint64_t key;
+        RenderCommand* command;
+    };
+    std::vector<SortEntry> _sortEntries;
+    std::vector<SortEntry> _sortScratch;
+
     /**Cull state.*/
     bool _isCullEnabled;
     /**Depth test enable state.*/
@@ -148,6 +163,12 @@ public:
     static const int BATCH_TRIAGCOMMAND_RESERVED_SIZE = 64;
     /**Reserved for material id, which means that the command could not be batched.*/
     static const int MATERIAL_ID_DO_NOT_BATCH = 0;
+    /**The minimum number of queued vertices before the batch is filled by the worker threads.*/
+    static const int MULTITHREADED_FILL_MIN_VERTICES = 4096;
+    /**The number of vertices of the streaming ring buffer, it holds several full batches.*/
+    static const int RING_VBO_SIZE = VBO_SIZE * 4;
+    /**The number of indices of the streaming ring buffer.*/
+    static const int RING_INDEX_VBO_SIZE = INDEX_VBO_SIZE * 4;
     /**Constructor.*/
     Renderer();
     /**Destructor.*/
@@ -174,6 +195,25 @@ public:
     /** Renders into the GLView all the queued `RenderCommand` objects */
     void render();
 
+    /**
+     * Enable/Disable grouping the commands with the same non-zero globalZ by material ID when sorting them,
+     * so they can be batched. Only use it when commands sharing a globalZ don't overlap.
+     * Disabled by default.
+     */
+    void setSortByMaterialEnabled(bool enabled) { _isSortByMaterial = enabled; }
+    /** Returns whether commands with the same globalZ are grouped by material ID. */
+    bool isSortByMaterialEnabled() const { return _isSortByMaterial; }
+
+    /**
+     * Enable/Disable reordering the `TrianglesCommand` objects with globalZ == 0 by material ID.
+     * A command is only moved in front of commands whose screen-space bounds it doesn't overlap,
+     * so the rendered image doesn't change while interleaved atlases get batched.
+     * Disabled by default.
+     */
+    void setReorderByMaterialEnabled(bool enabled) { _isReorderByMaterial = enabled; }
+    /** Returns whether the globalZ == 0 triangles are reordered by material ID. */
+    bool isReorderByMaterialEnabled() const { return _isReorderByMaterial; }
+
     /** Cleans all `RenderCommand`s in the queue */
     void clean();
 
@@ -186,12 +226,38 @@ public:
     ssize_t getDrawnBatches() const { return _drawnBatches; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnBatches(ssize_t number) { _drawnBatches += number; };
+    /* returns the number of batches saved by reordering the commands by material in the last frame */
+    ssize_t getSavedBatches() const { return _savedBatches; }
     /* returns the number of drawn triangles in the last frame */
     ssize_t getDrawnVertices() const { return _drawnVertices; }
     /* RenderCommands (except) TrianglesCommand should update this value */
     void addDrawnVertices(ssize_t number) { _drawnVertices += number; };
+    /* returns the number of bytes of vertices and indices uploaded by the batcher in the last frame */
+    ssize_t getUploadedBytes() const { return _uploadedBytes; }
+    /* returns how many times the streaming ring buffer wrapped (and was orphaned) in the last frame */
+    ssize_t getRingBufferWraps() const { return _ringBufferWraps; }
     /* clear draw stats */
-    void clearDrawStats() { _drawnBatches = _drawnVertices = 0; }
+    void clearDrawStats() { _drawnBatches = _drawnVertices = _uploadedBytes = _ringBufferWraps = _savedBatches = 0; }
+
+    /**
+     * Enable/Disable filling the batched vertices and indices on the worker threads.
+     * When enabled, big batches of `TrianglesCommand` are transformed and copied by `WorkerPool`,
+     * and the GL thread only uploads the buffers and issues the draw calls.
+     * Disabled by default.
+     */
+    void setMultithreadedFillEnabled(bool enabled) { _isMultithreadedFill = enabled; }
+    /** Returns whether the batched vertices and indices are filled on the worker threads. */
+    bool isMultithreadedFillEnabled() const { return _isMultithreadedFill; }
+
+    /**
+     * Enable/Disable the streaming ring buffer for the batched triangles.
+     * When enabled, each flush appends its vertices and indices to fixed-size buffers at a moving offset,
+     * and the buffers are only orphaned when they wrap around, so several flushes per frame don't stall the driver.
+     * Disabled by default.
+     */
+    void setRingBufferEnabled(bool enabled);
+    /** Returns whether the streaming ring buffer is used for the batched triangles. */
+    bool isRingBufferEnabled() const { return _isRingBufferEnabled; }
 
     /**
      * Enable/Disable depth test
@@ -213,6 +279,9 @@ protected:
     void setupVBOAndVAO();
     void setupVBO();
     void mapBuffers();
+    void setupQuadIndices();
+    void deleteBuffers();
+    GLintptr streamToRingBuffer();
     void drawBatchedTriangles();
 
     //Draw the previews queued triangles and flush previous context
@@ -226,8 +295,10 @@ protected:
 
     void processRenderCommand(RenderCommand* command);
     void visitRenderQueue(RenderQueue& queue);
+    void reorderByMaterial(std::vector<RenderCommand*>& commands);
+    void reorderTrianglesRun(std::vector<RenderCommand*>& commands, size_t first, size_t last);
 
-    void fillVerticesAndIndices(const TrianglesCommand* cmd);
+    void fillVerticesAndIndices(const TrianglesCommand* cmd, int vertexOffset, int indexOffset);
 
 
     /* clear color set outside be used in setGLDefaultValues() */
@@ -245,6 +316,9 @@ protected:
     GLushort _indices[INDEX_VBO_SIZE];
     GLuint _buffersVAO;
     GLuint _buffersVBO[2]; //0: vertex  1: indices
+    // indices of VBO_SIZE / 4 quads, built once, used when only quads are batched
+    GLuint _quadIndicesVBO;
+    bool _isQuadsOnlyBatch;
 
     // Internal structure that has the information for the batches
     struct TriBatchToDraw {
@@ -257,6 +331,13 @@ protected:
     // the TriBatches
     TriBatchToDraw* _triBatchesToDraw;
 
+    // where each queued TrianglesCommand starts in _verts and _indices
+    struct TriCommandOffset {
+        int vertexOffset;
+        int indexOffset;
+    };
+    std::vector<TriCommandOffset> _queuedTriangleOffsets;
+
     int _filledVertex;
     int _filledIndex;
 
@@ -265,11 +346,38 @@ protected:
     // stats
     ssize_t _drawnBatches;
     ssize_t _drawnVertices;
+    ssize_t _savedBatches;
+    ssize_t _uploadedBytes;
+    ssize_t _ringBufferWraps;
     //the flag for checking whether renderer is rendering
     bool _isRendering;
 
     bool _isDepthTestFor2D;
 
+    bool _isMultithreadedFill;
+
+    bool _isSortByMaterial;
+
+    // for the reordering of the triangles by material
+    struct MaterialBatch
+    {
+        uint32_t materialID;
+        // union of the screen-space bounds of the commands
+        float minX, minY, maxX, maxY;
+        // the commands of the batch are linked through _reorderNext
+        int firstCommand;
+        int lastCommand;
+    };
+    bool _isReorderByMaterial;
+    std::vector<MaterialBatch> _reorderBatches;
+    std::vector<int> _reorderNext;
+    std::vector<RenderCommand*> _reorderCommands;
+
+    bool _isRingBufferEnabled;
+    // where the next flush is written in the ring buffers, in bytes
+    GLintptr _ringVertexOffset;
+    GLintptr _ringIndexOffset;
+
     GroupCommandManager* _groupCommandManager;
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
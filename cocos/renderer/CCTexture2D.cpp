@@ -46,6 +46,7 @@ THE SOFTWARE.
 #include "renderer/CCGLProgram.h"
 #include "renderer/ccGLStateCache.h"
 #include "renderer/CCGLProgramCache.h"
+#include "renderer/CCPixelConverter.h"
 #include "base/CCNinePatchImageParser.h"
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -122,6 +123,7 @@ static Texture2D::PixelFormat g_defaultAlphaPixelFormat = Texture2D::PixelFormat
 
 //////////////////////////////////////////////////////////////////////////
 //convertor function
+// The SSE2/NEON kernels of PixelConverter convert most of the pixels, the loops convert the remaining ones.
 
 // IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBB
 void Texture2D::convertI8ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
@@ -148,7 +150,9 @@ void Texture2D::convertAI88ToRGB888(const unsigned char* data, ssize_t dataLen,
 // IIIIIIII -> RRRRRRRRGGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertI8ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0; i < dataLen; ++i)
+    ssize_t converted = PixelConverter::convertI8ToRGBA8888(data, dataLen, outData);
+    outData += converted * 4;
+    for (ssize_t i = converted; i < dataLen; ++i)
     {
         *outData++ = data[i];     //R
         *outData++ = data[i];     //G
@@ -160,7 +164,9 @@ void Texture2D::convertI8ToRGBA8888(const unsigned char* data, ssize_t dataLen,
 // IIIIIIIIAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertAI88ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 1; i < l; i += 2)
+    ssize_t converted = PixelConverter::convertAI88ToRGBA8888(data, dataLen / 2, outData);
+    outData += converted * 4;
+    for (ssize_t i = converted * 2, l = dataLen - 1; i < l; i += 2)
     {
         *outData++ = data[i];     //R
         *outData++ = data[i];     //G
@@ -277,7 +283,9 @@ void Texture2D::convertAI88ToI8(const unsigned char* data, ssize_t dataLen, unsi
 // RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA
 void Texture2D::convertRGB888ToRGBA8888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t converted = PixelConverter::convertRGB888ToRGBA8888(data, dataLen / 3, outData);
+    outData += converted * 4;
+    for (ssize_t i = converted * 3, l = dataLen - 2; i < l; i += 3)
     {
         *outData++ = data[i];         //R
         *outData++ = data[i + 1];     //G
@@ -289,7 +297,9 @@ void Texture2D::convertRGB888ToRGBA8888(const unsigned char* data, ssize_t dataL
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRRRRGGGGGGGGBBBBBBBB
 void Texture2D::convertRGBA8888ToRGB888(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t converted = PixelConverter::convertRGBA8888ToRGB888(data, dataLen / 4, outData);
+    outData += converted * 3;
+    for (ssize_t i = converted * 4, l = dataLen - 3; i < l; i += 4)
     {
         *outData++ = data[i];         //R
         *outData++ = data[i + 1];     //G
@@ -300,8 +310,9 @@ void Texture2D::convertRGBA8888ToRGB888(const unsigned char* data, ssize_t dataL
 // RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGGBBBBB
 void Texture2D::convertRGB888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 3)
+    ssize_t converted = PixelConverter::convertRGB888ToRGB565(data, dataLen / 3, outData);
+    unsigned short* out16 = (unsigned short*)outData + converted;
+    for (ssize_t i = converted * 3, l = dataLen - 2; i < l; i += 3)
     {
         *out16++ = (data[i] & 0x00F8) << 8    //R
             | (data[i + 1] & 0x00FC) << 3     //G
@@ -312,8 +323,9 @@ void Texture2D::convertRGB888ToRGB565(const unsigned char* data, ssize_t dataLen
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRRGGGGGGBBBBB
 void Texture2D::convertRGBA8888ToRGB565(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t converted = PixelConverter::convertRGBA8888ToRGB565(data, dataLen / 4, outData);
+    unsigned short* out16 = (unsigned short*)outData + converted;
+    for (ssize_t i = converted * 4, l = dataLen - 3; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F8) << 8    //R
             | (data[i + 1] & 0x00FC) << 3     //G
@@ -351,7 +363,9 @@ void Texture2D::convertRGBA8888ToI8(const unsigned char* data, ssize_t dataLen,
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> AAAAAAAA
 void Texture2D::convertRGBA8888ToA8(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    for (ssize_t i = 0, l = dataLen -3; i < l; i += 4)
+    ssize_t converted = PixelConverter::convertRGBA8888ToA8(data, dataLen / 4, outData);
+    outData += converted;
+    for (ssize_t i = converted * 4, l = dataLen -3; i < l; i += 4)
     {
         *outData++ = data[i + 3]; //A
     }
@@ -394,8 +408,9 @@ void Texture2D::convertRGB888ToRGBA4444(const unsigned char* data, ssize_t dataL
 // RRRRRRRRGGGGGGGGBBBBBBBBAAAAAAAA -> RRRRGGGGBBBBAAAA
 void Texture2D::convertRGBA8888ToRGBA4444(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 3; i < l; i += 4)
+    ssize_t converted = PixelConverter::convertRGBA8888ToRGBA4444(data, dataLen / 4, outData);
+    unsigned short* out16 = (unsigned short*)outData + converted;
+    for (ssize_t i = converted * 4, l = dataLen - 3; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F0) << 8    //R
         | (data[i + 1] & 0x00F0) << 4         //G
@@ -420,8 +435,9 @@ void Texture2D::convertRGB888ToRGB5A1(const unsigned char* data, ssize_t dataLen
 // RRRRRRRRGGGGGGGGBBBBBBBB -> RRRRRGGGGGBBBBBA
 void Texture2D::convertRGBA8888ToRGB5A1(const unsigned char* data, ssize_t dataLen, unsigned char* outData)
 {
-    unsigned short* out16 = (unsigned short*)outData;
-    for (ssize_t i = 0, l = dataLen - 2; i < l; i += 4)
+    ssize_t converted = PixelConverter::convertRGBA8888ToRGB5A1(data, dataLen / 4, outData);
+    unsigned short* out16 = (unsigned short*)outData + converted;
+    for (ssize_t i = converted * 4, l = dataLen - 2; i < l; i += 4)
     {
         *out16++ = (data[i] & 0x00F8) << 8    //R
             | (data[i + 1] & 0x00F8) << 3     //G
@@ -522,6 +522,7 @@ protected:
     NinePatchInfo* _ninePatchInfo;
     friend class SpriteFrameCache;
     friend class TextureCache;
+    friend class TextureContainer;
     friend class ui::Scale9Sprite;
 
     bool _valid;
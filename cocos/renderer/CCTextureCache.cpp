@@ -31,6 +31,8 @@ THE SOFTWARE.
 #include <stack>
 #include <cctype>
 #include <list>
+#include <algorithm>
+#include <chrono>
 
 #include "renderer/CCTexture2D.h"
 #include "base/ccMacros.h"
@@ -47,6 +49,15 @@ using namespace std;
 
 NS_CC_BEGIN
 
+// more loading threads than this are limited by the storage, not by the decoding
+static const int MAX_LOADING_THREAD_COUNT = 4;
+
+// default time spent uploading the async loaded textures per frame, in milliseconds
+static const float DEFAULT_ASYNC_UPLOAD_TIME_BUDGET = 5.0f;
+
+// pre-baked texture containers are uploaded straight from the mapped file
+static const char* TEXTURE_CONTAINER_EXTENSION = ".ctex";
+
 // implementation TextureCache
 
 TextureCache* TextureCache::getInstance()
@@ -55,10 +66,13 @@ TextureCache* TextureCache::getInstance()
 }
 
 TextureCache::TextureCache()
-: _loadingThread(nullptr)
+: _loadingThreadCount(0)
 , _needQuit(false)
 , _asyncRefCount(0)
+, _asyncUploadTimeBudget(DEFAULT_ASYNC_UPLOAD_TIME_BUDGET)
+, _asyncUploadByteBudget(0)
 {
+    resetAsyncLoadingStats();
 }
 
 TextureCache::~TextureCache()
@@ -68,7 +82,8 @@ TextureCache::~TextureCache()
     for( auto it=_textures.begin(); it!=_textures.end(); ++it)
         (it->second)->release();
 
-    CC_SAFE_DELETE(_loadingThread);
+    for (auto thread : _loadingThreads)
+        delete thread;
 }
 
 void TextureCache::destroyInstance()
@@ -83,7 +98,7 @@ std::string TextureCache::getDescription() const
 struct TextureCache::AsyncStruct
 {
 public:
-    AsyncStruct(const std::string& fn, std::function<void(Texture2D*)> f) : filename(fn), callback(f), pixelFormat(Texture2D::getDefaultAlphaPixelFormat()), loadSuccess(false) {}
+    AsyncStruct(const std::string& fn, std::function<void(Texture2D*)> f) : filename(fn), callback(f), pixelFormat(Texture2D::getDefaultAlphaPixelFormat()), loadSuccess(false), isContainer(false) {}
 
     std::string filename;
     std::function<void(Texture2D*)> callback;
@@ -91,16 +106,22 @@ public:
     Image imageAlpha;
     Texture2D::PixelFormat pixelFormat;
     bool loadSuccess;
+
+    // texture containers are mapped instead of being decoded into image
+    bool isContainer;
+    TextureContainer::MappedFile container;
+    TextureContainer::Info containerInfo;
 };
 
 /**
  The addImageAsync logic follow the steps:
- - find the image has been add or not, if not add an AsyncStruct to _requestQueue  (GL thread)
- - get AsyncStruct from _requestQueue, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load thread)
- - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread)
+ - find the image has been add or not, if not add an AsyncStruct to the _requestQueues of its priority  (GL thread)
+ - get the AsyncStruct of highest priority from _requestQueues, load res and fill image data to AsyncStruct.image, then add AsyncStruct to _responseQueue (Load threads)
+ - on schedule callback, get AsyncStruct from _responseQueue, convert image to texture, then delete AsyncStruct (GL thread).
+   The conversions of a frame stop once the upload budget is spent, the rest is converted in the next frames.
 
  the Critical Area include these members:
- - _requestQueue: locked by _requestMutex
+ - _requestQueues: locked by _requestMutex
  - _responseQueue: locked by _responseMutex
 
  the object's life time:
@@ -117,9 +138,15 @@ public:
  - In addImageAsyncCallback, will deduplicate the request to ensure only create one texture.
 
  Does process all response in addImageAsyncCallback consume more time?
- - Convert image to texture faster than load image from disk, so this isn't a problem.
+ - Uploading many large textures at once causes a hitch, so the uploads of a frame are limited
+   by _asyncUploadTimeBudget and _asyncUploadByteBudget.
  */
 void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback)
+{
+    addImageAsync(path, callback, AsyncPriority::NORMAL);
+}
+
+void TextureCache::addImageAsync(const std::string &path, const std::function<void(Texture2D*)>& callback, AsyncPriority priority)
 {
     Texture2D *texture = nullptr;
 
@@ -142,11 +169,22 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
     }
 
     // lazy init
-    if (_loadingThread == nullptr)
+    if (_loadingThreads.empty())
     {
-        // create a new thread to load images
-        _loadingThread = new (std::nothrow) std::thread(&TextureCache::loadImage, this);
+        int threadCount = _loadingThreadCount;
+        if (threadCount <= 0)
+        {
+            // leave a core to the main thread
+            int cores = (int)std::thread::hardware_concurrency();
+            threadCount = std::min(std::max(cores - 1, 1), MAX_LOADING_THREAD_COUNT);
+        }
+
+        // create the threads to load images
         _needQuit = false;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            _loadingThreads.push_back(new (std::nothrow) std::thread(&TextureCache::loadImage, this));
+        }
     }
 
     if (0 == _asyncRefCount)
@@ -162,7 +200,16 @@ void TextureCache::addImageAsync(const std::string &path, const std::function<vo
     // add async struct into queue
     _asyncStructQueue.push_back(data);
     _requestMutex.lock();
-    _requestQueue.push_back(data);
+    _requestQueues[(int)priority].push_back(data);
+
+    // move up the pending requests of the same file, so that they don't wait behind it
+    for (int i = 0; i < (int)priority; ++i)
+    {
+        auto& queue = _requestQueues[i];
+        auto newEnd = std::stable_partition(queue.begin(), queue.end(), [&fullpath](AsyncStruct* request){ return request->filename != fullpath; });
+        _requestQueues[(int)priority].insert(_requestQueues[(int)priority].end() - 1, newEnd, queue.end());
+        queue.erase(newEnd, queue.end());
+    }
     _requestMutex.unlock();
 
     _sleepCondition.notify_one();
@@ -200,30 +247,46 @@ void TextureCache::unbindAllImageAsync()
 void TextureCache::loadImage()
 {
     AsyncStruct *asyncStruct = nullptr;
-    std::mutex signalMutex;
-    std::unique_lock<std::mutex> signal(signalMutex);
-    while (!_needQuit)
+    for (;;)
     {
-        // pop an AsyncStruct from request queue
-        _requestMutex.lock();
-        if(_requestQueue.empty())
-        {
-            asyncStruct = nullptr;
-        }
-        else
+        // pop the AsyncStruct of highest priority from the request queues
         {
-            asyncStruct = _requestQueue.front();
-            _requestQueue.pop_front();
-        }
-        _requestMutex.unlock();
+            std::unique_lock<std::mutex> lock(_requestMutex);
+            _sleepCondition.wait(lock, [this]{
+                if (_needQuit)
+                    return true;
+                for (const auto& queue : _requestQueues)
+                {
+                    if (!queue.empty())
+                        return true;
+                }
+                return false;
+            });
+            if (_needQuit)
+                break;
 
-        if (nullptr == asyncStruct) {
-            _sleepCondition.wait(signal);
-            continue;
+            for (int i = ASYNC_PRIORITY_COUNT - 1; i >= 0; --i)
+            {
+                if (!_requestQueues[i].empty())
+                {
+                    asyncStruct = _requestQueues[i].front();
+                    _requestQueues[i].pop_front();
+                    break;
+                }
+            }
         }
 
         // load image
-        asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
+        if (FileUtils::getInstance()->getFileExtension(asyncStruct->filename) == TEXTURE_CONTAINER_EXTENSION)
+        {
+            asyncStruct->isContainer = true;
+            asyncStruct->loadSuccess = asyncStruct->container.open(asyncStruct->filename)
+                && TextureContainer::parse(asyncStruct->container.getBytes(), asyncStruct->container.getSize(), &asyncStruct->containerInfo);
+        }
+        else
+        {
+            asyncStruct->loadSuccess = asyncStruct->image.initWithImageFileThreadSafe(asyncStruct->filename);
+        }
 
         // push the asyncStruct to response queue
         _responseMutex.lock();
@@ -236,6 +299,12 @@ void TextureCache::addImageAsyncCallBack(float dt)
 {
     Texture2D *texture = nullptr;
     AsyncStruct *asyncStruct = nullptr;
+
+    auto startTime = std::chrono::steady_clock::now();
+    float uploadTime = 0;
+    size_t uploadedBytes = 0;
+    int uploadCount = 0;
+
     while (true)
     {
         // pop an AsyncStruct from response queue
@@ -247,11 +316,25 @@ void TextureCache::addImageAsyncCallBack(float dt)
         else
         {
             asyncStruct = _responseQueue.front();
-            _responseQueue.pop_front();
 
-            // the asyncStruct's sequence order in _asyncStructQueue must equal to the order in _responseQueue
-            CC_ASSERT(asyncStruct == _asyncStructQueue.front());
-            _asyncStructQueue.pop_front();
+            // keep the texture for the next frame when it doesn't fit in the budget of this one
+            bool needsUpload = asyncStruct->loadSuccess && _textures.find(asyncStruct->filename) == _textures.end();
+            size_t dataLen = asyncStruct->isContainer ? asyncStruct->container.getSize() : asyncStruct->image.getDataLen();
+            if (needsUpload && uploadCount > 0
+                && ((_asyncUploadTimeBudget > 0 && uploadTime >= _asyncUploadTimeBudget)
+                    || (_asyncUploadByteBudget > 0 && uploadedBytes + dataLen > _asyncUploadByteBudget)))
+            {
+                asyncStruct = nullptr;
+            }
+            else
+            {
+                _responseQueue.pop_front();
+
+                // the loading threads finish the requests in any order
+                auto iter = std::find(_asyncStructQueue.begin(), _asyncStructQueue.end(), asyncStruct);
+                CC_ASSERT(iter != _asyncStructQueue.end());
+                _asyncStructQueue.erase(iter);
+            }
         }
         _responseMutex.unlock();
 
@@ -268,9 +351,21 @@ void TextureCache::addImageAsyncCallBack(float dt)
         else
         {
             // convert image to texture
-            if (asyncStruct->loadSuccess)
+            if (asyncStruct->loadSuccess && asyncStruct->isContainer)
+            {
+                uploadedBytes += asyncStruct->container.getSize();
+                ++uploadCount;
+
+                texture = createTextureFromContainer(asyncStruct->containerInfo, asyncStruct->filename);
+                asyncStruct->container.close();
+
+                uploadTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+            }
+            else if (asyncStruct->loadSuccess)
             {
                 Image* image = &(asyncStruct->image);
+                uploadedBytes += image->getDataLen();
+                ++uploadCount;
                 // generate texture in render thread
                 texture = new (std::nothrow) Texture2D();
 
@@ -286,6 +381,8 @@ void TextureCache::addImageAsyncCallBack(float dt)
                 texture->retain();
 
                 texture->autorelease();
+
+                uploadTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
             } else {
                 texture = nullptr;
                 CCLOG("cocos2d: failed to call TextureCache::addImageAsync(%s)", asyncStruct->filename.c_str());
@@ -303,12 +400,53 @@ void TextureCache::addImageAsyncCallBack(float dt)
         --_asyncRefCount;
     }
 
+    if (uploadCount > 0)
+    {
+        _asyncLoadingStats.uploadedTextures += uploadCount;
+        _asyncLoadingStats.uploadedBytes += uploadedBytes;
+        _asyncLoadingStats.lastFrameUploadTime = uploadTime;
+        _asyncLoadingStats.maxFrameUploadTime = std::max(_asyncLoadingStats.maxFrameUploadTime, uploadTime);
+        _asyncLoadingStats.totalUploadTime += uploadTime;
+    }
+
     if (0 == _asyncRefCount)
     {
         Director::getInstance()->getScheduler()->unschedule(CC_SCHEDULE_SELECTOR(TextureCache::addImageAsyncCallBack), this);
     }
 }
 
+void TextureCache::setAsyncLoadingThreadCount(int count)
+{
+    _loadingThreadCount = count;
+}
+
+TextureCache::AsyncLoadingStats TextureCache::getAsyncLoadingStats() const
+{
+    AsyncLoadingStats stats = _asyncLoadingStats;
+    {
+        std::unique_lock<std::mutex> lock(_requestMutex);
+        stats.pendingRequests = 0;
+        for (const auto& queue : _requestQueues)
+            stats.pendingRequests += (int)queue.size();
+    }
+    {
+        std::unique_lock<std::mutex> lock(_responseMutex);
+        stats.pendingUploads = (int)_responseQueue.size();
+    }
+    return stats;
+}
+
+void TextureCache::resetAsyncLoadingStats()
+{
+    _asyncLoadingStats.pendingRequests = 0;
+    _asyncLoadingStats.pendingUploads = 0;
+    _asyncLoadingStats.uploadedTextures = 0;
+    _asyncLoadingStats.uploadedBytes = 0;
+    _asyncLoadingStats.lastFrameUploadTime = 0;
+    _asyncLoadingStats.maxFrameUploadTime = 0;
+    _asyncLoadingStats.totalUploadTime = 0;
+}
+
 Texture2D * TextureCache::addImage(const std::string &path)
 {
     Texture2D * texture = nullptr;
@@ -326,7 +464,20 @@ Texture2D * TextureCache::addImage(const std::string &path)
     if( it != _textures.end() )
         texture = it->second;
 
-    if (! texture)
+    if (! texture && FileUtils::getInstance()->getFileExtension(fullpath) == TEXTURE_CONTAINER_EXTENSION)
+    {
+        TextureContainer::MappedFile container;
+        TextureContainer::Info info;
+        if (container.open(fullpath) && TextureContainer::parse(container.getBytes(), container.getSize(), &info))
+        {
+            texture = createTextureFromContainer(info, fullpath);
+        }
+        else
+        {
+            CCLOG("cocos2d: Couldn't load texture container:%s in TextureCache", path.c_str());
+        }
+    }
+    else if (! texture)
     {
         // all images are handled by UIImage except PVR extension that is handled by our own handler
         do
@@ -365,6 +516,31 @@ Texture2D * TextureCache::addImage(const std::string &path)
     return texture;
 }
 
+Texture2D* TextureCache::createTextureFromContainer(const TextureContainer::Info& info, const std::string& fullpath)
+{
+    // the pixels are uploaded as they are, without any conversion
+    Texture2D* texture = new (std::nothrow) Texture2D();
+    if (texture && texture->initWithMipmaps(const_cast<MipmapInfo*>(info.mipmaps), info.numberOfMipmaps, info.pixelFormat, info.width, info.height))
+    {
+        texture->_hasPremultipliedAlpha = info.hasPremultipliedAlpha;
+        texture->_filePath = fullpath;
+#if CC_ENABLE_CACHE_TEXTURE_DATA
+        // cache the texture file name
+        VolatileTextureMgr::addImageTexture(texture, fullpath);
+#endif
+        // cache the texture. retain it, since it is added in the map
+        _textures.insert( std::make_pair(fullpath, texture) );
+        texture->retain();
+
+        texture->autorelease();
+        return texture;
+    }
+
+    CCLOG("cocos2d: Couldn't create texture for file:%s in TextureCache", fullpath.c_str());
+    CC_SAFE_RELEASE(texture);
+    return nullptr;
+}
+
 void TextureCache::parseNinePatchImage(cocos2d::Image *image, cocos2d::Texture2D *texture,const std::string& path)
 {
     if(NinePatchImageParser::isNinePatchImage(path))
@@ -568,10 +744,18 @@ std::string TextureCache::getTextureFilePath( cocos2d::Texture2D *texture )const
 
 void TextureCache::waitForQuit()
 {
-    // notify sub thread to quick
+    // notify sub threads to quit
+    _requestMutex.lock();
     _needQuit = true;
-    _sleepCondition.notify_one();
-    if (_loadingThread) _loadingThread->join();
+    _requestMutex.unlock();
+    _sleepCondition.notify_all();
+
+    for (auto thread : _loadingThreads)
+    {
+        thread->join();
+        delete thread;
+    }
+    _loadingThreads.clear();
 }
 
 std::string TextureCache::getCachedTextureInfo() const
@@ -32,6 +32,7 @@ THE SOFTWARE.
 #include <thread>
 #include <condition_variable>
 #include <queue>
+#include <vector>
 #include <string>
 #include <unordered_map>
 #include <functional>
@@ -39,6 +40,7 @@ THE SOFTWARE.
 #include "base/CCRef.h"
 #include "base/CCVector.h"
 #include "renderer/CCTexture2D.h"
+#include "renderer/CCTextureContainer.h"
 #include "platform/CCImage.h"
 
 #if CC_ENABLE_CACHE_TEXTURE_DATA
@@ -63,6 +65,35 @@ NS_CC_BEGIN
 class CC_DLL TextureCache : public Ref
 {
 public:
+    /** Priority of an asynchronous load. Requests with a higher priority are decoded first. */
+    enum class AsyncPriority
+    {
+        /** Textures which will be needed later. */
+        PREFETCH,
+        NORMAL,
+        /** Textures which are needed to draw the current scene. */
+        VISIBLE,
+    };
+
+    /** Counters of the asynchronous loads, used to tune the upload budget and the number of loading threads. */
+    struct AsyncLoadingStats
+    {
+        /** Requests waiting for a loading thread. */
+        int pendingRequests;
+        /** Images decoded, waiting to be uploaded to the GPU. */
+        int pendingUploads;
+        /** Number of textures uploaded since the last reset. */
+        unsigned int uploadedTextures;
+        /** Number of bytes of image data uploaded since the last reset. */
+        size_t uploadedBytes;
+        /** Time spent uploading textures during the last frame which uploaded any, in milliseconds. */
+        float lastFrameUploadTime;
+        /** Longest time spent uploading textures in a single frame since the last reset, in milliseconds. */
+        float maxFrameUploadTime;
+        /** Time spent uploading textures since the last reset, in milliseconds. */
+        float totalUploadTime;
+    };
+
     /** Returns the shared instance of the cache. */
     CC_DEPRECATED_ATTRIBUTE static TextureCache * getInstance();
 
@@ -115,6 +146,14 @@ public:
     */
     virtual void addImageAsync(const std::string &filepath, const std::function<void(Texture2D*)>& callback);
 
+    /** Same as addImageAsync(filepath, callback), with the priority of the request.
+     * A request still waiting to be decoded is moved up when the same file is requested again with a higher priority.
+     @param filepath A null terminated string.
+     @param callback A callback function would be invoked after the image is loaded.
+     @param priority The priority of the request.
+    */
+    virtual void addImageAsync(const std::string &filepath, const std::function<void(Texture2D*)>& callback, AsyncPriority priority);
+
     /** Unbind a specified bound image asynchronous callback.
      * In the case an object who was bound to an image asynchronous callback was destroyed before the callback is invoked,
      * the object always need to unbind this callback manually.
@@ -202,6 +241,32 @@ public:
      */
      std::string getTextureFilePath(Texture2D* texture)const;
 
+    /** Sets the number of threads decoding the images of addImageAsync().
+     * It takes effect the next time the loading threads are started.
+     * @param count Number of threads, 0 to choose it from the number of CPU cores.
+     */
+    void setAsyncLoadingThreadCount(int count);
+
+    /** Sets how long a frame may spend uploading the asynchronously loaded textures to the GPU.
+     * Textures exceeding the budget are uploaded during the next frames. At least one texture is uploaded per frame.
+     * @param milliseconds Upload time per frame, 0 for no limit. The default is 5 milliseconds.
+     */
+    void setAsyncUploadTimeBudget(float milliseconds) { _asyncUploadTimeBudget = milliseconds; }
+    float getAsyncUploadTimeBudget() const { return _asyncUploadTimeBudget; }
+
+    /** Sets how many bytes of image data a frame may upload to the GPU for the asynchronously loaded textures.
+     * At least one texture is uploaded per frame.
+     * @param bytes Image data uploaded per frame, 0 for no limit, which is the default.
+     */
+    void setAsyncUploadByteBudget(size_t bytes) { _asyncUploadByteBudget = bytes; }
+    size_t getAsyncUploadByteBudget() const { return _asyncUploadByteBudget; }
+
+    /** Returns the counters of the asynchronous loads. */
+    AsyncLoadingStats getAsyncLoadingStats() const;
+
+    /** Resets the counters of the asynchronous loads. */
+    void resetAsyncLoadingStats();
+
     /** Reload texture from a new file.
     * This function is mainly for editor, won't suggest use it in game for performance reason.
     *
@@ -217,18 +282,23 @@ private:
     void addImageAsyncCallBack(float dt);
     void loadImage();
     void parseNinePatchImage(Image* image, Texture2D* texture, const std::string& path);
+    Texture2D* createTextureFromContainer(const TextureContainer::Info& info, const std::string& fullpath);
 public:
 protected:
     struct AsyncStruct;
 
-    std::thread* _loadingThread;
+    static const int ASYNC_PRIORITY_COUNT = (int)AsyncPriority::VISIBLE + 1;
+
+    std::vector<std::thread*> _loadingThreads;
+    int _loadingThreadCount;
 
     std::deque<AsyncStruct*> _asyncStructQueue;
-    std::deque<AsyncStruct*> _requestQueue;
+    // one request queue per priority
+    std::deque<AsyncStruct*> _requestQueues[ASYNC_PRIORITY_COUNT];
     std::deque<AsyncStruct*> _responseQueue;
 
-    std::mutex _requestMutex;
-    std::mutex _responseMutex;
+    mutable std::mutex _requestMutex;
+    mutable std::mutex _responseMutex;
 
     std::condition_variable _sleepCondition;
 
@@ -236,6 +306,10 @@ protected:
 
     int _asyncRefCount;
 
+    float _asyncUploadTimeBudget;
+    size_t _asyncUploadByteBudget;
+    AsyncLoadingStats _asyncLoadingStats;
+
     std::unordered_map<std::string, Texture2D*> _textures;
 };
 
@@ -0,0 +1,451 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#include "renderer/CCTextureContainer.h"
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "base/ccMacros.h"
+#include "platform/CCFileUtils.h"
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+#include "platform/android/CCFileUtils-android.h"
+#include <android/asset_manager.h>
+#endif
+
+#if (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32 && CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
+#define CC_TEXTURE_CONTAINER_USE_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+NS_CC_BEGIN
+
+static const char CONTAINER_MAGIC[4] = { 'C', 'T', 'E', 'X' };
+
+// magic, version, pixel format, width, height, flags, number of mipmaps
+static const int HEADER_VALUE_COUNT = 7;
+static const ssize_t HEADER_SIZE = HEADER_VALUE_COUNT * 4;
+
+// the mipmaps start on this alignment in the file
+static const size_t MIPMAP_ALIGNMENT = 16;
+
+static uint32_t readUInt32(const unsigned char* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void writeUInt32(std::vector<unsigned char>& out, uint32_t value)
+{
+    out.push_back((unsigned char)(value & 0xff));
+    out.push_back((unsigned char)((value >> 8) & 0xff));
+    out.push_back((unsigned char)((value >> 16) & 0xff));
+    out.push_back((unsigned char)((value >> 24) & 0xff));
+}
+
+// the number of bytes of a mipmap level, 0 if the pixel format is unknown
+static uint64_t getMipmapSize(Texture2D::PixelFormat pixelFormat, uint32_t width, uint32_t height)
+{
+    uint64_t w = width;
+    uint64_t h = height;
+    switch (pixelFormat)
+    {
+        // PVRTC levels are at least 2x2 blocks
+        case Texture2D::PixelFormat::PVRTC4:
+        case Texture2D::PixelFormat::PVRTC4A:
+            return std::max(w / 4, (uint64_t)2) * std::max(h / 4, (uint64_t)2) * 8;
+        case Texture2D::PixelFormat::PVRTC2:
+        case Texture2D::PixelFormat::PVRTC2A:
+            return std::max(w / 8, (uint64_t)2) * std::max(h / 4, (uint64_t)2) * 8;
+        // 4x4 blocks of 8 bytes
+        case Texture2D::PixelFormat::ETC:
+        case Texture2D::PixelFormat::S3TC_DXT1:
+        case Texture2D::PixelFormat::ATC_RGB:
+            return ((w + 3) / 4) * ((h + 3) / 4) * 8;
+        // 4x4 blocks of 16 bytes
+        case Texture2D::PixelFormat::S3TC_DXT3:
+        case Texture2D::PixelFormat::S3TC_DXT5:
+        case Texture2D::PixelFormat::ATC_EXPLICIT_ALPHA:
+        case Texture2D::PixelFormat::ATC_INTERPOLATED_ALPHA:
+            return ((w + 3) / 4) * ((h + 3) / 4) * 16;
+        default:
+        {
+            const auto& pixelFormatInfos = Texture2D::getPixelFormatInfoMap();
+            auto infoIter = pixelFormatInfos.find(pixelFormat);
+            if (infoIter == pixelFormatInfos.end() || infoIter->second.compressed)
+                return 0;
+            return w * h * (uint64_t)infoIter->second.bpp / 8;
+        }
+    }
+}
+
+// implementation TextureContainer::MappedFile
+
+TextureContainer::MappedFile::MappedFile()
+: _bytes(nullptr)
+, _size(0)
+, _mapping(Mapping::NONE)
+, _handle(nullptr)
+{
+}
+
+TextureContainer::MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool TextureContainer::MappedFile::open(const std::string& fullpath)
+{
+    close();
+
+    if (fullpath.empty())
+        return false;
+
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+    // files of the apk, the asset manager maps them when they are stored uncompressed
+    if (fullpath[0] != '/' && FileUtilsAndroid::getAssetManager())
+    {
+        static const std::string apkprefix("assets/");
+        std::string relativePath = fullpath.compare(0, apkprefix.size(), apkprefix) == 0 ? fullpath.substr(apkprefix.size()) : fullpath;
+
+        AAsset* asset = AAssetManager_open(FileUtilsAndroid::getAssetManager(), relativePath.c_str(), AASSET_MODE_BUFFER);
+        if (asset)
+        {
+            const void* buffer = AAsset_getBuffer(asset);
+            if (buffer)
+            {
+                _bytes = static_cast<const unsigned char*>(buffer);
+                _size = (ssize_t)AAsset_getLength(asset);
+                _handle = asset;
+                _mapping = Mapping::ASSET;
+                return true;
+            }
+            AAsset_close(asset);
+        }
+    }
+#endif
+
+#if CC_TEXTURE_CONTAINER_USE_MMAP
+    int fd = ::open(FileUtils::getInstance()->getSuitableFOpen(fullpath).c_str(), O_RDONLY);
+    if (fd >= 0)
+    {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED)
+            {
+                _bytes = static_cast<const unsigned char*>(mapped);
+                _size = (ssize_t)st.st_size;
+                _handle = mapped;
+                _mapping = Mapping::MMAP;
+            }
+        }
+        ::close(fd);
+
+        if (_mapping == Mapping::MMAP)
+            return true;
+    }
+#endif
+
+    // zip and obb files, or platforms without mmap()
+    _data = FileUtils::getInstance()->getDataFromFile(fullpath);
+    if (_data.isNull())
+        return false;
+
+    _bytes = _data.getBytes();
+    _size = _data.getSize();
+    _mapping = Mapping::DATA;
+    return true;
+}
+
+void TextureContainer::MappedFile::close()
+{
+    switch (_mapping)
+    {
+#if CC_TEXTURE_CONTAINER_USE_MMAP
+    case Mapping::MMAP:
+        munmap(_handle, (size_t)_size);
+        break;
+#endif
+#if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
+    case Mapping::ASSET:
+        AAsset_close(static_cast<AAsset*>(_handle));
+        break;
+#endif
+    case Mapping::DATA:
+        _data.clear();
+        break;
+    default:
+        break;
+    }
+
+    _bytes = nullptr;
+    _size = 0;
+    _handle = nullptr;
+    _mapping = Mapping::NONE;
+}
+
+// implementation TextureContainer
+
+bool TextureContainer::isTextureContainer(const unsigned char* data, ssize_t dataLen)
+{
+    return data && dataLen >= HEADER_SIZE && memcmp(data, CONTAINER_MAGIC, sizeof(CONTAINER_MAGIC)) == 0;
+}
+
+bool TextureContainer::parse(const unsigned char* data, ssize_t dataLen, Info* info)
+{
+    CCASSERT(info != nullptr, "info can't be nullptr");
+
+    if (!isTextureContainer(data, dataLen))
+        return false;
+
+    uint32_t version = readUInt32(data + 4);
+    if (version != VERSION)
+    {
+        CCLOG("cocos2d: TextureContainer: unsupported version %u", version);
+        return false;
+    }
+
+    uint32_t pixelFormat = readUInt32(data + 8);
+    uint32_t width = readUInt32(data + 12);
+    uint32_t height = readUInt32(data + 16);
+    uint32_t flags = readUInt32(data + 20);
+    uint32_t mipmapCount = readUInt32(data + 24);
+
+    if (pixelFormat == (uint32_t)Texture2D::PixelFormat::AUTO
+        || pixelFormat > (uint32_t)Texture2D::PixelFormat::ATC_INTERPOLATED_ALPHA
+        || width == 0 || height == 0
+        || mipmapCount == 0 || mipmapCount > MIPMAP_MAX
+        || dataLen < HEADER_SIZE + (ssize_t)mipmapCount * 8)
+    {
+        CCLOG("cocos2d: TextureContainer: invalid header");
+        return false;
+    }
+
+    info->pixelFormat = (Texture2D::PixelFormat)pixelFormat;
+    info->width = (int)width;
+    info->height = (int)height;
+    info->hasPremultipliedAlpha = (flags & FLAG_PREMULTIPLIED_ALPHA) != 0;
+    info->numberOfMipmaps = (int)mipmapCount;
+
+    const unsigned char* mipmapTable = data + HEADER_SIZE;
+    for (uint32_t i = 0; i < mipmapCount; ++i)
+    {
+        uint32_t offset = readUInt32(mipmapTable + i * 8);
+        uint32_t size = readUInt32(mipmapTable + i * 8 + 4);
+        if ((uint64_t)offset + size > (uint64_t)dataLen)
+        {
+            CCLOG("cocos2d: TextureContainer: mipmap %u is out of the data", i);
+            return false;
+        }
+
+        // the level is uploaded with the size of the texture, GL would read past a short level
+        uint32_t levelWidth = std::max(width >> i, (uint32_t)1);
+        uint32_t levelHeight = std::max(height >> i, (uint32_t)1);
+        uint64_t levelSize = getMipmapSize((Texture2D::PixelFormat)pixelFormat, levelWidth, levelHeight);
+        if (levelSize == 0 || size < levelSize)
+        {
+            CCLOG("cocos2d: TextureContainer: mipmap %u is smaller than its %ux%u pixels", i, levelWidth, levelHeight);
+            return false;
+        }
+
+        info->mipmaps[i].address = const_cast<unsigned char*>(data) + offset;
+        info->mipmaps[i].len = (int)size;
+    }
+
+    return true;
+}
+
+// halves an RGBA8888 image, averaging 2x2 blocks
+static void downsampleRGBA8888(const unsigned char* src, int width, int height, std::vector<unsigned char>& dst)
+{
+    int dstWidth = std::max(width / 2, 1);
+    int dstHeight = std::max(height / 2, 1);
+    dst.resize(dstWidth * dstHeight * 4);
+
+    for (int y = 0; y < dstHeight; ++y)
+    {
+        int y0 = std::min(y * 2, height - 1);
+        int y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < dstWidth; ++x)
+        {
+            int x0 = std::min(x * 2, width - 1);
+            int x1 = std::min(x * 2 + 1, width - 1);
+            for (int c = 0; c < 4; ++c)
+            {
+                int sum = src[(y0 * width + x0) * 4 + c] + src[(y0 * width + x1) * 4 + c]
+                        + src[(y1 * width + x0) * 4 + c] + src[(y1 * width + x1) * 4 + c];
+                dst[(y * dstWidth + x) * 4 + c] = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+bool TextureContainer::saveToFile(Image* image, const std::string& fullpath, Texture2D::PixelFormat format, bool generateMipmaps)
+{
+    CCASSERT(image != nullptr, "image can't be nullptr");
+
+    const auto& pixelFormatInfos = Texture2D::getPixelFormatInfoMap();
+
+    Texture2D::PixelFormat pixelFormat = image->getRenderFormat();
+    bool hasPremultipliedAlpha = image->hasPremultipliedAlpha();
+    std::vector<std::vector<unsigned char>> levels;
+
+    if (image->isCompressed() || image->getNumberOfMipmaps() > 1)
+    {
+        if (format != Texture2D::PixelFormat::AUTO && format != pixelFormat)
+        {
+            CCLOG("cocos2d: TextureContainer: %s is compressed or has mipmaps, its pixel format is kept", image->getFilePath().c_str());
+        }
+
+        if (image->getNumberOfMipmaps() > 1)
+        {
+            MipmapInfo* mipmaps = image->getMipmaps();
+            for (int i = 0; i < std::min(image->getNumberOfMipmaps(), (int)MIPMAP_MAX); ++i)
+            {
+                levels.push_back(std::vector<unsigned char>(mipmaps[i].address, mipmaps[i].address + mipmaps[i].len));
+            }
+        }
+        else
+        {
+            levels.push_back(std::vector<unsigned char>(image->getData(), image->getData() + image->getDataLen()));
+        }
+    }
+    else
+    {
+        if (format != Texture2D::PixelFormat::AUTO)
+        {
+            pixelFormat = format;
+        }
+
+        auto infoIter = pixelFormatInfos.find(pixelFormat);
+        if (infoIter == pixelFormatInfos.end() || infoIter->second.compressed)
+        {
+            CCLOG("cocos2d: TextureContainer: can't convert %s to pixel format %d", image->getFilePath().c_str(), (int)pixelFormat);
+            return false;
+        }
+
+        // work on RGBA8888, then convert every level to the final format
+        unsigned char* rgbaData = nullptr;
+        ssize_t rgbaDataLen = 0;
+        Texture2D::PixelFormat rgbaFormat = Texture2D::convertDataToFormat(image->getData(), image->getDataLen(), image->getRenderFormat(), Texture2D::PixelFormat::RGBA8888, &rgbaData, &rgbaDataLen);
+        if (rgbaFormat != Texture2D::PixelFormat::RGBA8888)
+        {
+            CCLOG("cocos2d: TextureContainer: can't convert %s to RGBA8888", image->getFilePath().c_str());
+            return false;
+        }
+
+        std::vector<unsigned char> level(rgbaData, rgbaData + rgbaDataLen);
+        if (rgbaData != image->getData())
+        {
+            free(rgbaData);
+        }
+
+        // premultiply the alpha now, so that it isn't done when loading
+        if (infoIter->second.alpha)
+        {
+            if (!hasPremultipliedAlpha)
+            {
+                unsigned int* fourBytes = (unsigned int*)level.data();
+                for (size_t i = 0; i < level.size() / 4; ++i)
+                {
+                    unsigned char* p = level.data() + i * 4;
+                    fourBytes[i] = CC_RGB_PREMULTIPLY_ALPHA(p[0], p[1], p[2], p[3]);
+                }
+            }
+            hasPremultipliedAlpha = true;
+        }
+
+        int width = image->getWidth();
+        int height = image->getHeight();
+        bool isPOT = (width & (width - 1)) == 0 && (height & (height - 1)) == 0;
+        if (generateMipmaps && !isPOT)
+        {
+            CCLOG("cocos2d: TextureContainer: %s is not a power of two, no mipmaps are generated", image->getFilePath().c_str());
+        }
+
+        std::vector<std::vector<unsigned char>> rgbaLevels;
+        rgbaLevels.push_back(std::move(level));
+        if (generateMipmaps && isPOT)
+        {
+            while ((width > 1 || height > 1) && rgbaLevels.size() < MIPMAP_MAX)
+            {
+                std::vector<unsigned char> smaller;
+                downsampleRGBA8888(rgbaLevels.back().data(), width, height, smaller);
+                rgbaLevels.push_back(std::move(smaller));
+                width = std::max(width / 2, 1);
+                height = std::max(height / 2, 1);
+            }
+        }
+
+        for (const auto& rgbaLevel : rgbaLevels)
+        {
+            unsigned char* outData = nullptr;
+            ssize_t outDataLen = 0;
+            Texture2D::convertDataToFormat(rgbaLevel.data(), rgbaLevel.size(), Texture2D::PixelFormat::RGBA8888, pixelFormat, &outData, &outDataLen);
+
+            levels.push_back(std::vector<unsigned char>(outData, outData + outDataLen));
+            if (outData != rgbaLevel.data())
+            {
+                free(outData);
+            }
+        }
+    }
+
+    // header and mipmap table
+    std::vector<unsigned char> file(CONTAINER_MAGIC, CONTAINER_MAGIC + sizeof(CONTAINER_MAGIC));
+    writeUInt32(file, VERSION);
+    writeUInt32(file, (uint32_t)pixelFormat);
+    writeUInt32(file, (uint32_t)image->getWidth());
+    writeUInt32(file, (uint32_t)image->getHeight());
+    writeUInt32(file, hasPremultipliedAlpha ? FLAG_PREMULTIPLIED_ALPHA : 0);
+    writeUInt32(file, (uint32_t)levels.size());
+
+    size_t offset = HEADER_SIZE + levels.size() * 8;
+    for (const auto& level : levels)
+    {
+        offset = (offset + MIPMAP_ALIGNMENT - 1) & ~(MIPMAP_ALIGNMENT - 1);
+        writeUInt32(file, (uint32_t)offset);
+        writeUInt32(file, (uint32_t)level.size());
+        offset += level.size();
+    }
+
+    // mipmaps
+    for (const auto& level : levels)
+    {
+        file.resize((file.size() + MIPMAP_ALIGNMENT - 1) & ~(MIPMAP_ALIGNMENT - 1), 0);
+        file.insert(file.end(), level.begin(), level.end());
+    }
+
+    Data data;
+    data.copy(file.data(), file.size());
+    return FileUtils::getInstance()->writeDataToFile(data, fullpath);
+}
+
+NS_CC_END
@@ -0,0 +1,137 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef __CC_TEXTURE_CONTAINER_H__
+#define __CC_TEXTURE_CONTAINER_H__
+
+#include "renderer/CCTexture2D.h"
+#include "platform/CCImage.h"
+#include "base/CCData.h"
+#include <string>
+
+/**
+ * @addtogroup _2d
+ * @{
+ */
+NS_CC_BEGIN
+
+/**
+ * @class TextureContainer
+ * @brief Pre-baked texture files (.ctex), whose pixels can be uploaded without any decoding or conversion.
+ *
+ * A texture container is a header followed by the mipmap levels, already in their final pixel format
+ * and with the alpha already premultiplied. All the values of the header are 32 bit little endian integers:
+ * - "CTEX" magic, version
+ * - pixel format (the value of Texture2D::PixelFormat), width, height, flags, number of mipmaps
+ * - offset and size of each mipmap, from the beginning of the file
+ *
+ * The files are produced offline by saveToFile(), see tools/texture-converter.
+ * @js NA
+ */
+class CC_DLL TextureContainer
+{
+public:
+    static const int VERSION = 1;
+    static const int MIPMAP_MAX = 16;
+
+    /** The alpha of the pixels is premultiplied. */
+    static const unsigned int FLAG_PREMULTIPLIED_ALPHA = 1 << 0;
+
+    /** The description of a texture container, pointing into the container data. */
+    struct Info
+    {
+        Texture2D::PixelFormat pixelFormat;
+        int width;
+        int height;
+        bool hasPremultipliedAlpha;
+        int numberOfMipmaps;
+        MipmapInfo mipmaps[MIPMAP_MAX];
+    };
+
+    /**
+     * A read only view of a whole file. The file is memory mapped when the platform allows it,
+     * otherwise it is read into memory.
+     */
+    class CC_DLL MappedFile
+    {
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        /** Maps the file, unmapping the previous one. */
+        bool open(const std::string& fullpath);
+        void close();
+
+        const unsigned char* getBytes() const { return _bytes; }
+        ssize_t getSize() const { return _size; }
+
+    private:
+        MappedFile(const MappedFile&);
+        MappedFile& operator=(const MappedFile&);
+
+        enum class Mapping
+        {
+            NONE,
+            // a file mapped with mmap()
+            MMAP,
+            // an uncompressed asset of the apk, mapped by the asset manager
+            ASSET,
+            // the file couldn't be mapped, it was read into _data
+            DATA,
+        };
+
+        const unsigned char* _bytes;
+        ssize_t _size;
+        Mapping _mapping;
+        void* _handle;
+        Data _data;
+    };
+
+    /** Returns whether the data starts with the texture container magic. */
+    static bool isTextureContainer(const unsigned char* data, ssize_t dataLen);
+
+    /**
+     * Reads the header of a texture container.
+     * The mipmap addresses of `info` point into `data`, nothing is copied.
+     * @return false if the data is not a valid texture container.
+     */
+    static bool parse(const unsigned char* data, ssize_t dataLen, Info* info);
+
+    /**
+     * Bakes an image into a texture container file.
+     * Uncompressed images are converted to `format` and their alpha is premultiplied.
+     * Compressed images are stored as they are, with their mipmaps.
+     *
+     * @param image The decoded image.
+     * @param fullpath Path of the file to write.
+     * @param format Pixel format of the texture, AUTO keeps the format of the image.
+     * @param generateMipmaps Whether to generate the mipmaps of uncompressed, power of two images.
+     */
+    static bool saveToFile(Image* image, const std::string& fullpath, Texture2D::PixelFormat format = Texture2D::PixelFormat::AUTO, bool generateMipmaps = false);
+};
+
+NS_CC_END
+// end group
+/// @}
+#endif //__CC_TEXTURE_CONTAINER_H__
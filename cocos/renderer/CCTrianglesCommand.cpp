@@ -38,6 +38,7 @@ TrianglesCommand::TrianglesCommand()
 ,_glProgramState(nullptr)
 ,_glProgram(nullptr)
 ,_blendType(BlendFunc::DISABLE)
+,_isQuads(false)
 ,_alphaTextureID(0)
 {
     _type = RenderCommand::Type::TRIANGLES_COMMAND;
@@ -58,6 +59,12 @@ void TrianglesCommand::init(float globalOrder, GLuint textureID, GLProgramState*
         CCLOGERROR("Resize indexCount from %zd to %zd, size must be multiple times of 3", count, _triangles.indexCount);
     }
     _mv = mv;
+
+    // a single quad, e.g. a Sprite without polygon info
+    const unsigned short* indices = _triangles.indices;
+    _isQuads = _triangles.vertCount == 4 && _triangles.indexCount == 6 &&
+               indices[0] == 0 && indices[1] == 1 && indices[2] == 2 &&
+               indices[3] == 3 && indices[4] == 2 && indices[5] == 1;
     
     if( _textureID != textureID || _blendType.src != blendType.src || _blendType.dst != blendType.dst ||
        _glProgramState != glProgramState ||
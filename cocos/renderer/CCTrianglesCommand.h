@@ -93,6 +93,8 @@ public:
     inline BlendFunc getBlendType() const { return _blendType; }
     /**Get the model view matrix.*/
     inline const Mat4& getModelView() const { return _mv; }
+    /**Whether the triangles are quads indexed with the standard 0-1-2 / 3-2-1 pattern, like QuadCommand.*/
+    inline bool isQuads() const { return _isQuads; }
 
 protected:
     /**Generate the material ID by textureID, glProgramState, and blend function.*/
@@ -112,6 +114,8 @@ protected:
     Triangles _triangles;
     /**Model view matrix when rendering the triangles.*/
     Mat4 _mv;
+    /**Quads can be drawn with the renderer's shared quad index buffer.*/
+    bool _isQuads;
 
     GLuint _alphaTextureID; // ANDROID ETC1 ALPHA supports.
 };
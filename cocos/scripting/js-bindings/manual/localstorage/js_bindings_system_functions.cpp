@@ -84,4 +84,26 @@ bool JSB_localStorageClear(JSContext *cx, uint32_t argc, jsval *vp) {
     return true;
 }
 
+// Arguments:
+// Ret value: void
+bool JSB_localStorageBeginTransaction(JSContext *cx, uint32_t argc, jsval *vp) {
+    JSB_PRECONDITION2( argc == 0, cx, false, "Invalid number of arguments" );
+    JS::CallArgs args = JS::CallArgsFromVp(argc, vp);
+
+    localStorageBeginTransaction();
+    args.rval().setUndefined();
+    return true;
+}
+
+// Arguments:
+// Ret value: void
+bool JSB_localStorageCommitTransaction(JSContext *cx, uint32_t argc, jsval *vp) {
+    JSB_PRECONDITION2( argc == 0, cx, false, "Invalid number of arguments" );
+    JS::CallArgs args = JS::CallArgsFromVp(argc, vp);
+
+    localStorageCommitTransaction();
+    args.rval().setUndefined();
+    return true;
+}
+
 //#endif // JSB_INCLUDE_SYSTEM
@@ -13,6 +13,8 @@ bool JSB_localStorageGetItem(JSContext *cx, uint32_t argc, jsval *vp);
 bool JSB_localStorageRemoveItem(JSContext *cx, uint32_t argc, jsval *vp);
 bool JSB_localStorageSetItem(JSContext *cx, uint32_t argc, jsval *vp);
 bool JSB_localStorageClear(JSContext *cx, uint32_t argc, jsval *vp);
+bool JSB_localStorageBeginTransaction(JSContext *cx, uint32_t argc, jsval *vp);
+bool JSB_localStorageCommitTransaction(JSContext *cx, uint32_t argc, jsval *vp);
 
 #ifdef __cplusplus
 }
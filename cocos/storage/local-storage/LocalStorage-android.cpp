@@ -130,4 +130,18 @@ void localStorageClear()
     JniHelper::callStaticVoidMethod(className, "clear");
 }
 
+/** starts a transaction, nested ones are merged into the outermost one */
+void localStorageBeginTransaction()
+{
+    assert( _initialized );
+    JniHelper::callStaticVoidMethod(className, "beginTransaction");
+}
+
+/** commits the outermost transaction */
+void localStorageCommitTransaction()
+{
+    assert( _initialized );
+    JniHelper::callStaticVoidMethod(className, "commitTransaction");
+}
+
 #endif // #if (CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID)
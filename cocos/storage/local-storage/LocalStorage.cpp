@@ -35,6 +35,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <list>
+#include <unordered_map>
 #if (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32)
 #include <sqlite3/sqlite3.h>
 #else
@@ -47,6 +49,66 @@ static sqlite3_stmt *_stmt_select;
 static sqlite3_stmt *_stmt_remove;
 static sqlite3_stmt *_stmt_update;
 static sqlite3_stmt *_stmt_clear;
+static sqlite3_stmt *_stmt_begin;
+static sqlite3_stmt *_stmt_commit;
+static sqlite3_stmt *_stmt_rollback;
+static int _transactionDepth = 0;
+
+// recently read or written items, so that getItem() doesn't have to query the DB
+struct CachedItem
+{
+    std::string key;
+    std::string value;
+    bool exists;
+};
+
+static const size_t CACHE_CAPACITY = 512;
+static std::list<CachedItem> _cache;
+static std::unordered_map<std::string, std::list<CachedItem>::iterator> _cacheIndex;
+
+static void localStorageCacheItem(const std::string& key, const std::string* value)
+{
+    auto iter = _cacheIndex.find(key);
+    if (iter != _cacheIndex.end())
+    {
+        // move it to the front, as the most recently used
+        _cache.splice(_cache.begin(), _cache, iter->second);
+    }
+    else
+    {
+        if (_cache.size() >= CACHE_CAPACITY)
+        {
+            _cacheIndex.erase(_cache.back().key);
+            _cache.pop_back();
+        }
+        _cache.push_front(CachedItem());
+        _cache.front().key = key;
+        _cacheIndex[key] = _cache.begin();
+    }
+
+    CachedItem& item = _cache.front();
+    item.exists = (value != nullptr);
+    if (value)
+        item.value = *value;
+    else
+        item.value.clear();
+}
+
+static void localStorageUncacheItem(const std::string& key)
+{
+    auto iter = _cacheIndex.find(key);
+    if (iter != _cacheIndex.end())
+    {
+        _cache.erase(iter->second);
+        _cacheIndex.erase(iter);
+    }
+}
+
+static void localStorageClearCache()
+{
+    _cache.clear();
+    _cacheIndex.clear();
+}
 
 
 static void localStorageCreateTable()
@@ -72,23 +134,45 @@ void localStorageInit( const std::string& fullpath/* = "" */)
         else
             ret = sqlite3_open(fullpath.c_str(), &_db);
 
+        if (ret == SQLITE_OK && !fullpath.empty())
+        {
+            // with a write ahead log, a commit appends to the log instead of rewriting the DB,
+            // and only the checkpoints need to be synced to disk.
+            // The DB still works without it, only slower.
+            if (sqlite3_exec(_db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr) != SQLITE_OK
+                || sqlite3_exec(_db, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr) != SQLITE_OK)
+                printf("Error setting the journal mode of the DB\n");
+        }
+
         localStorageCreateTable();
 
         // SELECT
         const char *sql_select = "SELECT value FROM data WHERE key=?;";
-        ret |= sqlite3_prepare_v2(_db, sql_select, -1, &_stmt_select, nullptr);
+        if (ret == SQLITE_OK)
+            ret = sqlite3_prepare_v2(_db, sql_select, -1, &_stmt_select, nullptr);
 
         // REPLACE
         const char *sql_update = "REPLACE INTO data (key, value) VALUES (?,?);";
-        ret |= sqlite3_prepare_v2(_db, sql_update, -1, &_stmt_update, nullptr);
+        if (ret == SQLITE_OK)
+            ret = sqlite3_prepare_v2(_db, sql_update, -1, &_stmt_update, nullptr);
 
         // DELETE
         const char *sql_remove = "DELETE FROM data WHERE key=?;";
-        ret |= sqlite3_prepare_v2(_db, sql_remove, -1, &_stmt_remove, nullptr);
+        if (ret == SQLITE_OK)
+            ret = sqlite3_prepare_v2(_db, sql_remove, -1, &_stmt_remove, nullptr);
         
         // Clear
         const char *sql_clear = "DELETE FROM data;";
-        ret |= sqlite3_prepare_v2(_db, sql_clear, -1, &_stmt_clear, nullptr);
+        if (ret == SQLITE_OK)
+            ret = sqlite3_prepare_v2(_db, sql_clear, -1, &_stmt_clear, nullptr);
+
+        // Transactions
+        if (ret == SQLITE_OK)
+            ret = sqlite3_prepare_v2(_db, "BEGIN;", -1, &_stmt_begin, nullptr);
+        if (ret == SQLITE_OK)
+            ret = sqlite3_prepare_v2(_db, "COMMIT;", -1, &_stmt_commit, nullptr);
+        if (ret == SQLITE_OK)
+            ret = sqlite3_prepare_v2(_db, "ROLLBACK;", -1, &_stmt_rollback, nullptr);
 
         if( ret != SQLITE_OK ) {
             printf("Error initializing DB\n");
@@ -102,9 +186,21 @@ void localStorageInit( const std::string& fullpath/* = "" */)
 void localStorageFree()
 {
     if (_initialized) {
+        if (_transactionDepth > 0) {
+            // don't lose the items of an unfinished transaction
+            _transactionDepth = 1;
+            localStorageCommitTransaction();
+        }
+
         sqlite3_finalize(_stmt_select);
         sqlite3_finalize(_stmt_remove);
         sqlite3_finalize(_stmt_update);
+        sqlite3_finalize(_stmt_clear);
+        sqlite3_finalize(_stmt_begin);
+        sqlite3_finalize(_stmt_commit);
+        sqlite3_finalize(_stmt_rollback);
+
+        localStorageClearCache();
 
         sqlite3_close(_db);
 		
@@ -124,8 +220,13 @@ void localStorageSetItem( const std::string& key, const std::string& value)
 
     ok |= sqlite3_reset(_stmt_update);
 
-    if( ok != SQLITE_OK && ok != SQLITE_DONE)
+    if( ok != SQLITE_OK && ok != SQLITE_DONE) {
         printf("Error in localStorage.setItem()\n");
+        localStorageUncacheItem(key);
+    }
+    else {
+        localStorageCacheItem(key, &value);
+    }
 }
 
 /** gets an item from the LS */
@@ -133,6 +234,16 @@ bool localStorageGetItem( const std::string& key, std::string *outItem )
 {
     assert( _initialized );
 
+    auto iter = _cacheIndex.find(key);
+    if (iter != _cacheIndex.end())
+    {
+        _cache.splice(_cache.begin(), _cache, iter->second);
+        const CachedItem& item = _cache.front();
+        if (item.exists)
+            outItem->assign(item.value);
+        return item.exists;
+    }
+
     int ok = sqlite3_reset(_stmt_select);
 
     ok |= sqlite3_bind_text(_stmt_select, 1, key.c_str(), -1, SQLITE_TRANSIENT);
@@ -146,11 +257,13 @@ bool localStorageGetItem( const std::string& key, std::string *outItem )
     }
     else if (!text)
     {
+        localStorageCacheItem(key, nullptr);
         return false;
     }
     else
     {
         outItem->assign((const char*)text);
+        localStorageCacheItem(key, outItem);
         return true;
     }
 }
@@ -166,8 +279,13 @@ void localStorageRemoveItem( const std::string& key )
 
     ok |= sqlite3_reset(_stmt_remove);
 
-    if( ok != SQLITE_OK && ok != SQLITE_DONE)
+    if( ok != SQLITE_OK && ok != SQLITE_DONE) {
         printf("Error in localStorage.removeItem()\n");
+        localStorageUncacheItem(key);
+    }
+    else {
+        localStorageCacheItem(key, nullptr);
+    }
 }
 
 /** removes all items from the LS */
@@ -181,6 +299,51 @@ void localStorageClear()
 
     if( ok != SQLITE_OK && ok != SQLITE_DONE)
         printf("Error in localStorage.clear()\n");
+
+    localStorageClearCache();
+}
+
+/** starts a transaction, nested ones are merged into the outermost one */
+void localStorageBeginTransaction()
+{
+    assert( _initialized );
+
+    if (_transactionDepth++ > 0)
+        return;
+
+    int ok = sqlite3_step(_stmt_begin);
+
+    ok |= sqlite3_reset(_stmt_begin);
+
+    if( ok != SQLITE_OK && ok != SQLITE_DONE)
+        printf("Error in localStorage.beginTransaction()\n");
+}
+
+/** commits the outermost transaction */
+void localStorageCommitTransaction()
+{
+    assert( _initialized );
+
+    if (_transactionDepth == 0) {
+        printf("Error in localStorage.commitTransaction(): no transaction\n");
+        return;
+    }
+
+    if (--_transactionDepth > 0)
+        return;
+
+    int ok = sqlite3_step(_stmt_commit);
+
+    ok |= sqlite3_reset(_stmt_commit);
+
+    if( ok != SQLITE_OK && ok != SQLITE_DONE) {
+        printf("Error in localStorage.commitTransaction()\n");
+        // a failed COMMIT leaves the transaction open, which would make every later BEGIN fail
+        sqlite3_step(_stmt_rollback);
+        sqlite3_reset(_stmt_rollback);
+        // the cache may hold items which didn't make it to the DB
+        localStorageClearCache();
+    }
 }
 
 #endif // #if (CC_TARGET_PLATFORM != CC_PLATFORM_ANDROID)
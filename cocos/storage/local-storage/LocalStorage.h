@@ -54,6 +54,15 @@ void CC_DLL localStorageRemoveItem( const std::string& key );
 /** Removes all items from the JS. */
 void CC_DLL localStorageClear();
 
+/** Starts a transaction. The items set or removed until the matching localStorageCommitTransaction()
+ * are written to disk at once, instead of one write per item.
+ * Transactions can be nested, only the outermost one is committed.
+ */
+void CC_DLL localStorageBeginTransaction();
+
+/** Commits the transaction started by localStorageBeginTransaction(). */
+void CC_DLL localStorageCommitTransaction();
+
 // end group
 /// @}
 
@@ -0,0 +1,65 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+/*
+ Converts .plist sprite sheets into binary atlases (.catlas), see cocos2d::SpriteAtlas.
+ It is built against the engine of a desktop target (win32 or mac), and uses the .plist parser of the engine.
+
+ usage: atlas-converter input.plist output.catlas
+ */
+
+#include "cocos2d.h"
+#include "2d/CCSpriteAtlas.h"
+
+#include <stdio.h>
+
+USING_NS_CC;
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        printf("usage: atlas-converter input.plist output.catlas\n");
+        return 1;
+    }
+
+    const char* input = argv[1];
+    const char* output = argv[2];
+
+    ValueMap dict = FileUtils::getInstance()->getValueMapFromFile(FileUtils::getInstance()->fullPathForFilename(input));
+    if (dict.empty())
+    {
+        printf("can't load %s\n", input);
+        return 1;
+    }
+
+    bool ret = SpriteAtlas::saveToFile(dict, output);
+    if (!ret)
+    {
+        printf("can't convert %s to %s\n", input, output);
+    }
+
+    return ret ? 0 : 1;
+}
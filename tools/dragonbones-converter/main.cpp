@@ -0,0 +1,80 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+/*
+ Converts DragonBones data (_ske.json) into binary data (.dbbin), see dragonBones::BinaryDataParser.
+ It is built against the engine of a desktop target (win32 or mac), and uses the JSON parser of the DragonBones runtime.
+
+ usage: dragonbones-converter input_ske.json output.dbbin
+ */
+
+#include "cocos2d.h"
+#include "editor-support/dragonbones/DragonBonesHeaders.h"
+
+#include <stdio.h>
+
+USING_NS_CC;
+DRAGONBONES_USING_NAME_SPACE;
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        printf("usage: dragonbones-converter input_ske.json output.dbbin\n");
+        return 1;
+    }
+
+    const char* input = argv[1];
+    const char* output = argv[2];
+
+    const std::string rawData = FileUtils::getInstance()->getStringFromFile(FileUtils::getInstance()->fullPathForFilename(input));
+    if (rawData.empty())
+    {
+        printf("can't load %s\n", input);
+        return 1;
+    }
+
+    // the binary data is written with a scale of 1, the runtime scales it when it is loaded
+    JSONDataParser parser;
+    const auto data = parser.parseDragonBonesData(rawData.c_str(), 1.f);
+    if (!data)
+    {
+        printf("can't parse %s\n", input);
+        return 1;
+    }
+
+    std::vector<unsigned char> binaryData;
+    BinaryDataParser::writeDragonBonesData(*data, binaryData);
+    data->returnToPool();
+
+    Data fileData;
+    fileData.copy(binaryData.data(), (ssize_t)binaryData.size());
+    bool ret = FileUtils::getInstance()->writeDataToFile(fileData, output);
+    if (!ret)
+    {
+        printf("can't write %s\n", output);
+    }
+
+    return ret ? 0 : 1;
+}
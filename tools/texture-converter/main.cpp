@@ -0,0 +1,140 @@
+/****************************************************************************
+ Copyright (c) 2016 Chukong Technologies Inc.
+
+ http://www.cocos2d-x.org
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE.
+ ****************************************************************************/
+
+
+/*
+ Bakes images into texture containers (.ctex), see cocos2d::TextureContainer.
+ It is built against the engine of a desktop target (win32 or mac), and uses the Image decoders of the engine.
+
+ usage: texture-converter [-format FORMAT] [-mipmaps] input output.ctex
+ */
+
+#include "cocos2d.h"
+#include "renderer/CCTextureContainer.h"
+
+#include <stdio.h>
+#include <string.h>
+
+USING_NS_CC;
+
+static const struct
+{
+    const char* name;
+    Texture2D::PixelFormat format;
+} FORMATS[] = {
+    { "AUTO", Texture2D::PixelFormat::AUTO },
+    { "RGBA8888", Texture2D::PixelFormat::RGBA8888 },
+    { "RGB888", Texture2D::PixelFormat::RGB888 },
+    { "RGB565", Texture2D::PixelFormat::RGB565 },
+    { "RGBA4444", Texture2D::PixelFormat::RGBA4444 },
+    { "RGB5A1", Texture2D::PixelFormat::RGB5A1 },
+    { "A8", Texture2D::PixelFormat::A8 },
+    { "I8", Texture2D::PixelFormat::I8 },
+    { "AI88", Texture2D::PixelFormat::AI88 },
+};
+
+static void printUsage()
+{
+    printf("usage: texture-converter [-format FORMAT] [-mipmaps] input output.ctex\n");
+    printf("  -format   pixel format of the texture, AUTO keeps the format of the image:\n           ");
+    for (const auto& format : FORMATS)
+    {
+        printf(" %s", format.name);
+    }
+    printf("\n  -mipmaps  generate the mipmaps of power of two images\n");
+}
+
+int main(int argc, char** argv)
+{
+    Texture2D::PixelFormat format = Texture2D::PixelFormat::AUTO;
+    bool generateMipmaps = false;
+    const char* input = nullptr;
+    const char* output = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-format") == 0 && i + 1 < argc)
+        {
+            const char* name = argv[++i];
+            bool found = false;
+            for (const auto& f : FORMATS)
+            {
+                if (strcmp(f.name, name) == 0)
+                {
+                    format = f.format;
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                printf("unknown pixel format %s\n", name);
+                printUsage();
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-mipmaps") == 0)
+        {
+            generateMipmaps = true;
+        }
+        else if (!input)
+        {
+            input = argv[i];
+        }
+        else if (!output)
+        {
+            output = argv[i];
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (!input || !output)
+    {
+        printUsage();
+        return 1;
+    }
+
+    // the alpha is premultiplied by the converter, keep the original pixels
+    Image::setPNGPremultipliedAlphaEnabled(false);
+
+    Image* image = new (std::nothrow) Image();
+    if (!image || !image->initWithImageFile(FileUtils::getInstance()->fullPathForFilename(input)))
+    {
+        printf("can't load %s\n", input);
+        CC_SAFE_RELEASE(image);
+        return 1;
+    }
+
+    bool ret = TextureContainer::saveToFile(image, output, format, generateMipmaps);
+    if (!ret)
+    {
+        printf("can't write %s\n", output);
+    }
+
+    image->release();
+    return ret ? 0 : 1;
+}